@@ -0,0 +1,103 @@
+/**
+ * @headerfile JobSystem.h
+ * This file defines the JobSystem class which runs jobs on a fixed pool of worker threads.
+ *
+ * @author Olivier
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief JobSystem is a class that owns a fixed pool of worker threads and runs the jobs of a parallel-for
+ * on them.
+ * @note The thread calling ParallelFor also runs jobs and waits for all of them to be done, so the jobs can
+ * safely reference data of the caller.
+ */
+class JobSystem
+{
+private:
+    std::vector<std::thread> _workers;
+
+    std::mutex _mutex;
+    std::condition_variable _jobCondition;
+    std::condition_variable _doneCondition;
+
+    /**
+     * @brief Job is the function run by the current parallel-for, nullptr when there is none.
+     */
+    const std::function<void(std::size_t)>* _job = nullptr;
+    std::size_t _jobCount = 0;
+    std::atomic<std::size_t> _nextJobIdx = 0;
+
+    /**
+     * @brief BusyWorkerCount is the number of workers running jobs of the current parallel-for.
+     */
+    std::size_t _busyWorkerCount = 0;
+
+    /**
+     * @brief Generation is incremented by each parallel-for so that a worker runs each of them once.
+     */
+    std::uint64_t _generation = 0;
+    bool _isRunning = false;
+
+    /**
+     * @brief workerLoop is the method run by each worker thread until the job system is deinitialized.
+     */
+    void workerLoop() noexcept;
+
+    /**
+     * @brief runJobs is a method that runs the jobs of the current parallel-for which are not taken yet.
+     * @param job The function of the parallel-for.
+     * @param jobCount The number of jobs of the parallel-for.
+     */
+    void runJobs(const std::function<void(std::size_t)>& job, std::size_t jobCount) noexcept;
+
+public:
+    JobSystem() noexcept = default;
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+    ~JobSystem() noexcept;
+
+    /**
+     * @brief Init is a method that starts the worker threads.
+     * @param workerCount The number of worker threads, the calling thread of ParallelFor is not counted.
+     * Default value is the number of hardware threads minus one.
+     */
+    void Init(std::size_t workerCount = DefaultWorkerCount()) noexcept;
+
+    /**
+     * @brief Deinit is a method that stops and joins the worker threads.
+     */
+    void Deinit() noexcept;
+
+    /**
+     * @brief ParallelFor is a method that runs the job given in parameter once for each index in
+     * [0, jobCount) on the workers and the calling thread, and returns once all of them are done.
+     * @note The order in which the indices are run is not specified, each job must only write to its own data.
+     * @param jobCount The number of jobs to run.
+     * @param job The function to run with the index of the job.
+     */
+    void ParallelFor(std::size_t jobCount, const std::function<void(std::size_t)>& job) noexcept;
+
+    /**
+     * @brief WorkerCount is a method that gives the number of worker threads.
+     * @return The number of worker threads.
+     */
+    [[nodiscard]] std::size_t WorkerCount() const noexcept { return _workers.size(); }
+
+    /**
+     * @brief DefaultWorkerCount is a method that gives the number of hardware threads minus one
+     * (aka the calling thread).
+     * @return The default number of worker threads.
+     */
+    [[nodiscard]] static std::size_t DefaultWorkerCount() noexcept;
+};
@@ -0,0 +1,128 @@
+#include "JobSystem.h"
+
+#ifdef TRACY_ENABLE
+#include <Tracy.hpp>
+#endif // TRACY_ENABLE
+
+JobSystem::~JobSystem() noexcept
+{
+    Deinit();
+}
+
+void JobSystem::Init(const std::size_t workerCount) noexcept
+{
+    Deinit();
+
+    _isRunning = true;
+    _workers.reserve(workerCount);
+
+    for (std::size_t i = 0; i < workerCount; i++)
+    {
+        _workers.emplace_back(&JobSystem::workerLoop, this);
+    }
+}
+
+void JobSystem::Deinit() noexcept
+{
+    {
+        std::lock_guard lock(_mutex);
+        _isRunning = false;
+    }
+
+    _jobCondition.notify_all();
+
+    for (auto& worker : _workers)
+    {
+        worker.join();
+    }
+
+    _workers.clear();
+}
+
+void JobSystem::ParallelFor(const std::size_t jobCount, const std::function<void(std::size_t)>& job) noexcept
+{
+#ifdef TRACY_ENABLE
+    ZoneScoped;
+    ZoneValue(jobCount);
+#endif // TRACY_ENABLE
+
+    if (jobCount == 0) return;
+
+    // Without workers or with a single job, running the jobs here avoids waking the workers.
+    if (_workers.empty() || jobCount == 1)
+    {
+        for (std::size_t i = 0; i < jobCount; i++)
+        {
+            job(i);
+        }
+
+        return;
+    }
+
+    {
+        std::lock_guard lock(_mutex);
+        _job = &job;
+        _jobCount = jobCount;
+        _nextJobIdx = 0;
+        _generation++;
+    }
+
+    _jobCondition.notify_all();
+
+    runJobs(job, jobCount);
+
+    // The job must not be released while a worker can still take an index of it.
+    std::unique_lock lock(_mutex);
+    _doneCondition.wait(lock, [this]() { return _busyWorkerCount == 0; });
+    _job = nullptr;
+}
+
+void JobSystem::runJobs(const std::function<void(std::size_t)>& job, const std::size_t jobCount) noexcept
+{
+    for (auto jobIdx = _nextJobIdx.fetch_add(1); jobIdx < jobCount; jobIdx = _nextJobIdx.fetch_add(1))
+    {
+        job(jobIdx);
+    }
+}
+
+void JobSystem::workerLoop() noexcept
+{
+    std::uint64_t lastGeneration = 0;
+
+    while (true)
+    {
+        const std::function<void(std::size_t)>* job;
+        std::size_t jobCount;
+
+        {
+            std::unique_lock lock(_mutex);
+            _jobCondition.wait(lock, [this, lastGeneration]()
+            {
+                return !_isRunning || (_job != nullptr && _generation != lastGeneration);
+            });
+
+            if (!_isRunning) return;
+
+            lastGeneration = _generation;
+            job = _job;
+            jobCount = _jobCount;
+            _busyWorkerCount++;
+        }
+
+        runJobs(*job, jobCount);
+
+        {
+            std::lock_guard lock(_mutex);
+            _busyWorkerCount--;
+        }
+
+        _doneCondition.notify_one();
+    }
+}
+
+std::size_t JobSystem::DefaultWorkerCount() noexcept
+{
+    const auto hardwareThreadCount = std::thread::hardware_concurrency();
+
+    return hardwareThreadCount > 1 ? hardwareThreadCount - 1 : 0;
+}
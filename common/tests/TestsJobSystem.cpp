@@ -0,0 +1,49 @@
+#include "JobSystem.h"
+
+#include "gtest/gtest.h"
+
+#include <numeric>
+
+struct WorkerCountFixture : public ::testing::TestWithParam<std::size_t>{};
+
+INSTANTIATE_TEST_SUITE_P(JobSystem, WorkerCountFixture, testing::Values(
+        0, 1, 3, 8
+));
+
+TEST_P(WorkerCountFixture, Init)
+{
+    const auto workerCount = GetParam();
+
+    JobSystem jobSystem;
+    jobSystem.Init(workerCount);
+
+    EXPECT_EQ(jobSystem.WorkerCount(), workerCount);
+
+    jobSystem.Deinit();
+
+    EXPECT_EQ(jobSystem.WorkerCount(), 0);
+}
+
+TEST_P(WorkerCountFixture, ParallelFor)
+{
+    JobSystem jobSystem;
+    jobSystem.Init(GetParam());
+
+    std::vector<int> values(1000, 0);
+
+    // Several parallel-fors in a row to check that the workers run each job exactly once.
+    for (int iteration = 1; iteration <= 50; iteration++)
+    {
+        jobSystem.ParallelFor(values.size(), [&values](const std::size_t jobIdx)
+        {
+            values[jobIdx] += static_cast<int>(jobIdx);
+        });
+
+        for (std::size_t i = 0; i < values.size(); i++)
+        {
+            ASSERT_EQ(values[i], iteration * static_cast<int>(i));
+        }
+    }
+
+    jobSystem.ParallelFor(0, [](std::size_t) { FAIL(); });
+}
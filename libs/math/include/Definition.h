@@ -7,7 +7,9 @@
 #ifdef _MSC_VER
 #define NOALIAS __declspec(noalias)
 #define FORCE_INLINE __forceinline
+#define TARGET_AVX2
 #else
 #define NOALIAS __attribute__((const))
 #define FORCE_INLINE __attribute__((always_inline))
-#endif
\ No newline at end of file
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#endif
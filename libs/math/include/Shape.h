@@ -2,6 +2,9 @@
 
 #include "Vec2.h"
 
+#include <array>
+#include <cmath>
+#include <utility>
 #include <vector>
 
 namespace Math
@@ -93,6 +96,17 @@ namespace Math
             return true;
         }
 
+        /**
+         * @brief Check if the rectangle entirely contains another rectangle
+         * @param rectangle the rectangle to check
+         * @return true if the rectangle is inside the rectangle, false otherwise
+         */
+        [[nodiscard]] constexpr bool Contains(const Rectangle<T>& rectangle) const noexcept
+        {
+            return _minBound.X <= rectangle._minBound.X && _minBound.Y <= rectangle._minBound.Y &&
+                   _maxBound.X >= rectangle._maxBound.X && _maxBound.Y >= rectangle._maxBound.Y;
+        }
+
         [[nodiscard]] constexpr Vec2<T> Center() const noexcept
         {
             return (_minBound + _maxBound) / 2;
@@ -130,16 +144,98 @@ namespace Math
          * @brief Construct a new Polygon object
          * @param vertices the vertices of the polygon
          */
-        constexpr explicit Polygon(std::vector<Vec2<T>> vertices) noexcept : _vertices(vertices) {}
+        explicit Polygon(std::vector<Vec2<T>> vertices) noexcept : _vertices(std::move(vertices))
+        {
+            calculateCache();
+        }
 
     private:
         std::vector<Vec2<T>> _vertices;
 
+        /**
+         * @brief The normal of each edge, the edge i goes from the vertex i - 1 to the vertex i
+         */
+        std::vector<Vec2<T>> _edgeNormals;
+        Rectangle<T> _bounds{Vec2<T>::Zero(), Vec2<T>::Zero()};
+
+        /**
+         * @brief The radius of the bounding circle, centered on the center of the bounds
+         */
+        T _boundingRadius = 0;
+
+        /**
+         * @brief Calculate the edge normals, the bounds and the bounding radius of the vertices
+         */
+        void calculateCache() noexcept
+        {
+            _edgeNormals.clear();
+            _edgeNormals.reserve(_vertices.size());
+
+            if (_vertices.empty())
+            {
+                _bounds = Rectangle<T>(Vec2<T>::Zero(), Vec2<T>::Zero());
+                _boundingRadius = 0;
+
+                return;
+            }
+
+            Vec2<T> minBound = _vertices[0];
+            Vec2<T> maxBound = _vertices[0];
+
+            for (std::size_t i = 0, j = _vertices.size() - 1; i < _vertices.size(); j = i++)
+            {
+                const auto edge = _vertices[i] - _vertices[j];
+                _edgeNormals.push_back(Vec2<T>(-edge.Y, edge.X));
+
+                minBound.X = Math::Min(minBound.X, _vertices[i].X);
+                minBound.Y = Math::Min(minBound.Y, _vertices[i].Y);
+
+                maxBound.X = Math::Max(maxBound.X, _vertices[i].X);
+                maxBound.Y = Math::Max(maxBound.Y, _vertices[i].Y);
+            }
+
+            _bounds = Rectangle<T>(minBound, maxBound);
+
+            const auto center = _bounds.Center();
+            T maxSquareDistance = 0;
+
+            for (const auto& vertex : _vertices)
+            {
+                maxSquareDistance = Math::Max(maxSquareDistance, (vertex - center).SquareLength());
+            }
+
+            _boundingRadius = static_cast<T>(std::sqrt(maxSquareDistance));
+        }
+
     public:
-        [[nodiscard]] constexpr std::vector<Vec2<T>> Vertices() const noexcept { return _vertices; }
-        [[nodiscard]] constexpr int VerticesCount() const noexcept { return _vertices.size(); }
+        [[nodiscard]] constexpr const std::vector<Vec2<T>>& Vertices() const noexcept { return _vertices; }
+        [[nodiscard]] constexpr int VerticesCount() const noexcept { return static_cast<int>(_vertices.size()); }
+
+        void SetVertices(std::vector<Vec2<T>> vertices) noexcept
+        {
+            _vertices = std::move(vertices);
+            calculateCache();
+        }
+
+        /**
+         * @brief The normals of the edges (not normalized), in the order of the vertices
+         */
+        [[nodiscard]] constexpr const std::vector<Vec2<T>>& EdgeNormals() const noexcept { return _edgeNormals; }
+
+        /**
+         * @brief The axis-aligned bounding rectangle of the vertices
+         */
+        [[nodiscard]] constexpr Rectangle<T> Bounds() const noexcept { return _bounds; }
 
-        void SetVertices(std::vector<Vec2<T>> vertices) noexcept { _vertices = vertices; }
+        /**
+         * @brief The radius of the bounding circle of the vertices, centered on the center of the bounds
+         */
+        [[nodiscard]] constexpr T BoundingRadius() const noexcept { return _boundingRadius; }
+
+        [[nodiscard]] constexpr Circle<T> BoundingCircle() const noexcept
+        {
+            return Circle<T>(_bounds.Center(), _boundingRadius);
+        }
 
         [[nodiscard]] constexpr Vec2<T> Center() const noexcept
         {
@@ -186,6 +282,73 @@ namespace Math
     using PolygonF = Polygon<float>;
     using PolygonI = Polygon<int>;
 
+    /**
+     * @brief PolygonSpan is a non-owning view on vertices of a polygon stored elsewhere (in a Polygon or in
+     * a pool of vertices), used to test intersections without copying the vertices.
+     */
+    template <typename T>
+    class PolygonSpan
+    {
+    public:
+        /**
+         * @brief Construct a new PolygonSpan object
+         * @param vertices the first vertex of the polygon, it must outlive the span
+         * @param verticesCount the number of vertices of the polygon
+         */
+        constexpr PolygonSpan(const Vec2<T>* vertices, int verticesCount) noexcept :
+            _vertices(vertices), _verticesCount(verticesCount) {}
+
+        /**
+         * @brief Construct a new PolygonSpan object with the cached data of its polygon
+         * @param vertices the first vertex of the polygon, it must outlive the span
+         * @param verticesCount the number of vertices of the polygon
+         * @param edgeNormals the first edge normal of the polygon (see Polygon::EdgeNormals), it must outlive the span
+         * @param boundingCircle the bounding circle of the vertices
+         */
+        constexpr PolygonSpan(const Vec2<T>* vertices, int verticesCount,
+                              const Vec2<T>* edgeNormals, Circle<T> boundingCircle) noexcept :
+            _vertices(vertices), _verticesCount(verticesCount),
+            _edgeNormals(edgeNormals), _boundingCircle(boundingCircle) {}
+
+        /**
+         * @brief Construct a new PolygonSpan object on the vertices and the cached data of a polygon
+         * @param polygon the polygon, it must outlive the span
+         */
+        constexpr explicit PolygonSpan(const Polygon<T>& polygon) noexcept :
+            _vertices(polygon.Vertices().data()), _verticesCount(polygon.VerticesCount()),
+            _edgeNormals(polygon.EdgeNormals().data()), _boundingCircle(polygon.BoundingCircle()) {}
+
+    private:
+        const Vec2<T>* _vertices = nullptr;
+        int _verticesCount = 0;
+
+        /**
+         * @brief The edge normals of the polygon, nullptr if they are not cached (the bounding circle is then
+         * not valid either)
+         */
+        const Vec2<T>* _edgeNormals = nullptr;
+        Circle<T> _boundingCircle{Vec2<T>::Zero(), 0};
+
+    public:
+        [[nodiscard]] constexpr const Vec2<T>* Vertices() const noexcept { return _vertices; }
+        [[nodiscard]] constexpr int VerticesCount() const noexcept { return _verticesCount; }
+
+        [[nodiscard]] constexpr const Vec2<T>* EdgeNormals() const noexcept { return _edgeNormals; }
+        [[nodiscard]] constexpr Circle<T> BoundingCircle() const noexcept { return _boundingCircle; }
+
+        /**
+         * @brief Check if the span has the edge normals and the bounding circle of its polygon
+         */
+        [[nodiscard]] constexpr bool HasCachedData() const noexcept { return _edgeNormals != nullptr; }
+
+        [[nodiscard]] constexpr const Vec2<T>& operator[](int index) const noexcept { return _vertices[index]; }
+
+        [[nodiscard]] constexpr const Vec2<T>* begin() const noexcept { return _vertices; }
+        [[nodiscard]] constexpr const Vec2<T>* end() const noexcept { return _vertices + _verticesCount; }
+    };
+
+    using PolygonSpanF = PolygonSpan<float>;
+
     // Intersect functions
 
     template<typename T>
@@ -252,69 +415,63 @@ namespace Math
         return Intersect(rectangle, circle);
     }
 
+    /**
+     * @brief Check if one of the edges of the first polygon is a separating axis of the two polygons
+     * (separate axis theorem)
+     */
     template <typename T>
-    [[nodiscard]] constexpr bool Intersect(const Polygon<T> polygon1, const Polygon<T> polygon2) noexcept
+    [[nodiscard]] constexpr bool HasSeparatingEdge(const PolygonSpan<T> polygon1, const PolygonSpan<T> polygon2) noexcept
     {
-        // Separate axis theorem
-        // Check if any of the edges of polygon1 is a separating axis
+        const auto* edgeNormals = polygon1.EdgeNormals();
+
         for (int i = 0, j = polygon1.VerticesCount() - 1; i < polygon1.VerticesCount(); j = i++)
         {
-            const auto edge = polygon1.Vertices()[i] - polygon1.Vertices()[j];
-            const auto normal = Vec2<T>(-edge.Y, edge.X);
+            const auto edge = polygon1[i] - polygon1[j];
+            const auto normal = edgeNormals != nullptr ? edgeNormals[i] : Vec2<T>(-edge.Y, edge.X);
 
-            const auto startProjection1 = polygon1.Vertices()[0].Dot(normal);
-            const auto startProjection2 = polygon2.Vertices()[0].Dot(normal);
+            const auto startProjection1 = polygon1[0].Dot(normal);
+            const auto startProjection2 = polygon2[0].Dot(normal);
 
             Vec2<T> projection1 = Vec2<T>(startProjection1, startProjection1);
             Vec2<T> projection2 = Vec2<T>(startProjection2, startProjection2);
 
-            for (const auto& vertex : polygon1.Vertices())
+            for (const auto& vertex : polygon1)
             {
                 const auto projection = vertex.Dot(normal);
 
                 projection1 = Vec2<T>(Math::Min(projection1.X, projection), Math::Max(projection1.Y, projection));
             }
 
-            for (const auto& vertex : polygon2.Vertices())
+            for (const auto& vertex : polygon2)
             {
                 const auto projection = vertex.Dot(normal);
 
                 projection2 = Vec2<T>(Math::Min(projection2.X, projection), Math::Max(projection2.Y, projection));
             }
 
-            if (projection1.Y < projection2.X || projection2.Y < projection1.X) return false;
+            if (projection1.Y < projection2.X || projection2.Y < projection1.X) return true;
         }
 
-        // Check if any of the edges of polygon2 is a separating axis
-        for (int i = 0, j = polygon2.VerticesCount() - 1; i < polygon2.VerticesCount(); j = i++)
-        {
-            const auto edge = polygon2.Vertices()[i] - polygon2.Vertices()[j];
-            const auto normal = Vec2<T>(-edge.Y, edge.X);
-
-            const auto startProjection1 = polygon1.Vertices()[0].Dot(normal);
-            const auto startProjection2 = polygon2.Vertices()[0].Dot(normal);
-
-            Vec2<T> projection1 = Vec2<T>(startProjection1, startProjection1);
-            Vec2<T> projection2 = Vec2<T>(startProjection2, startProjection2);
-
-            for (const auto& vertex : polygon1.Vertices())
-            {
-                const auto projection = vertex.Dot(normal);
-
-                projection1 = Vec2<T>(Math::Min(projection1.X, projection), Math::Max(projection1.Y, projection));
-            }
-
-            for (const auto& vertex : polygon2.Vertices())
-            {
-                const auto projection = vertex.Dot(normal);
-
-                projection2 = Vec2<T>(Math::Min(projection2.X, projection), Math::Max(projection2.Y, projection));
-            }
+        return false;
+    }
 
-            if (projection1.Y < projection2.X || projection2.Y < projection1.X) return false;
+    template <typename T>
+    [[nodiscard]] constexpr bool Intersect(const PolygonSpan<T> polygon1, const PolygonSpan<T> polygon2) noexcept
+    {
+        if (polygon1.HasCachedData() && polygon2.HasCachedData() &&
+            !Intersect(polygon1.BoundingCircle(), polygon2.BoundingCircle()))
+        {
+            return false;
         }
 
-        return true;
+        // Separate axis theorem
+        return !HasSeparatingEdge(polygon1, polygon2) && !HasSeparatingEdge(polygon2, polygon1);
+    }
+
+    template <typename T>
+    [[nodiscard]] constexpr bool Intersect(const Polygon<T>& polygon1, const Polygon<T>& polygon2) noexcept
+    {
+        return Intersect(PolygonSpan<T>(polygon1), PolygonSpan<T>(polygon2));
     }
 
     template<typename T>
@@ -335,12 +492,14 @@ namespace Math
     }
 
     template <typename T>
-    [[nodiscard]] constexpr bool Intersect(const Polygon<T> polygon, const Circle<T> circle) noexcept
+    [[nodiscard]] constexpr bool Intersect(const PolygonSpan<T> polygon, const Circle<T> circle) noexcept
     {
+        if (polygon.HasCachedData() && !Intersect(polygon.BoundingCircle(), circle)) return false;
+
         const auto center = circle.Center();
         const auto radius = circle.Radius();
 
-        for (const auto &vertex: polygon.Vertices())
+        for (const auto &vertex: polygon)
         {
             if (circle.Contains(vertex))
             {
@@ -350,8 +509,8 @@ namespace Math
 
         for (int i = 0, j = polygon.VerticesCount() - 1; i < polygon.VerticesCount(); j = i++)
         {
-            const auto p1 = polygon.Vertices()[i];
-            const auto p2 = polygon.Vertices()[j];
+            const auto p1 = polygon[i];
+            const auto p2 = polygon[j];
 
             // Calculate the closest point on the edge to the circle's center.
             Vec2<T> closest = ClosestPointOnSegment(p1, p2, center);
@@ -367,27 +526,54 @@ namespace Math
     }
 
     template <typename T>
-    [[nodiscard]] constexpr bool Intersect(const Circle<T> circle, const Polygon<T> polygon) noexcept
+    [[nodiscard]] constexpr bool Intersect(const Circle<T> circle, const PolygonSpan<T> polygon) noexcept
     {
         return Intersect(polygon, circle);
     }
 
     template <typename T>
-    [[nodiscard]] constexpr bool Intersect(const Polygon<T> polygon, const Rectangle<T> rectangle) noexcept
+    [[nodiscard]] constexpr bool Intersect(const Polygon<T>& polygon, const Circle<T> circle) noexcept
     {
-        Polygon<T> rectToPolygon = Polygon<T>({
+        return Intersect(PolygonSpan<T>(polygon), circle);
+    }
+
+    template <typename T>
+    [[nodiscard]] constexpr bool Intersect(const Circle<T> circle, const Polygon<T>& polygon) noexcept
+    {
+        return Intersect(PolygonSpan<T>(polygon), circle);
+    }
+
+    template <typename T>
+    [[nodiscard]] constexpr bool Intersect(const PolygonSpan<T> polygon, const Rectangle<T> rectangle) noexcept
+    {
+        if (polygon.HasCachedData() && !Intersect(rectangle, polygon.BoundingCircle())) return false;
+
+        // The corners of the rectangle are kept on the stack instead of building a Polygon.
+        const std::array<Vec2<T>, 4> corners = {
             rectangle.MinBound(),
             Vec2<T>(rectangle.MinBound().X, rectangle.MaxBound().Y),
             rectangle.MaxBound(),
             Vec2<T>(rectangle.MaxBound().X, rectangle.MinBound().Y)
-        });
+        };
 
-        return Intersect(polygon, rectToPolygon);
+        return Intersect(polygon, PolygonSpan<T>(corners.data(), static_cast<int>(corners.size())));
     }
 
     template <typename T>
-    [[nodiscard]] constexpr bool Intersect(const Rectangle<T> rectangle, const Polygon<T> polygon) noexcept
+    [[nodiscard]] constexpr bool Intersect(const Rectangle<T> rectangle, const PolygonSpan<T> polygon) noexcept
     {
         return Intersect(polygon, rectangle);
     }
-}
\ No newline at end of file
+
+    template <typename T>
+    [[nodiscard]] constexpr bool Intersect(const Polygon<T>& polygon, const Rectangle<T> rectangle) noexcept
+    {
+        return Intersect(PolygonSpan<T>(polygon), rectangle);
+    }
+
+    template <typename T>
+    [[nodiscard]] constexpr bool Intersect(const Rectangle<T> rectangle, const Polygon<T>& polygon) noexcept
+    {
+        return Intersect(PolygonSpan<T>(polygon), rectangle);
+    }
+}
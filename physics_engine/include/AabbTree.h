@@ -0,0 +1,246 @@
+/**
+ * @headerfile AabbTree.h
+ * This header file defines the AabbTree class which is a dynamic bounding volume hierarchy used as broad phase:
+ * the colliders are the leaves of a binary tree whose nodes are the rectangles containing their children.
+ *
+ * @author Olivier Pachoud
+ */
+
+#pragma once
+
+#include "Allocator.h"
+#include "BroadPhase.h"
+
+namespace PhysicsEngine
+{
+    /**
+     * @brief AabbNode is a struct representing a node of the dynamic AABB tree. A leaf stores the fat rectangle
+     * of a collider and an internal node stores the rectangle containing its two children.
+     */
+    struct AabbNode
+    {
+        /**
+         * @brief Null is the index used when there is no node.
+         */
+        static constexpr int Null = -1;
+
+        Math::RectangleF Aabb{Math::Vec2F::Zero(), Math::Vec2F::Zero()};
+        ColliderRef ColRef{0, 0};
+
+        /**
+         * @brief Parent is the index of the parent node, or the index of the next free node if the node is
+         * in the free list.
+         */
+        int Parent = Null;
+        int Child1 = Null;
+        int Child2 = Null;
+
+        /**
+         * @brief Height is 0 for a leaf, the height of the highest child + 1 for an internal node and -1 for
+         * a free node.
+         */
+        int Height = -1;
+
+        [[nodiscard]] bool IsLeaf() const noexcept { return Child1 == Null; }
+    };
+
+    /**
+     * @brief AabbProxy is a struct that stores the state of a collider in the AABB tree (aka its leaf node).
+     */
+    struct AabbProxy
+    {
+        ColliderRef ColRef{0, 0};
+        int Leaf = AabbNode::Null;
+        bool Moved = false;
+        bool Updated = false;
+    };
+
+    /**
+     * @brief AabbTree is a class that represents a dynamic AABB tree used for the broad phase.
+     * @note The tree is kept between the steps: a collider is only reinserted when its simplified shape leaves
+     * its fat rectangle and only the possible pairs of the reinserted colliders are recalculated.
+     * The leaves are inserted next to the sibling that increases the least the perimeter of the tree and
+     * the tree is balanced with rotations. The nodes are stored in a pool with a free list.
+     */
+    class AabbTree final : public BroadPhase
+    {
+    private:
+        HeapAllocator _heapAllocator;
+
+        AllocVector<AabbNode> _nodes{ StandardAllocator<AabbNode> {_heapAllocator} };
+        AllocVector<AabbProxy> _proxies{ StandardAllocator<AabbProxy> {_heapAllocator} };
+        AllocVector<std::size_t> _movedProxies{ StandardAllocator<std::size_t> {_heapAllocator} };
+        AllocVector<ColliderPair> _possiblePairs{ StandardAllocator<ColliderPair> {_heapAllocator} };
+
+        /**
+         * @brief QueryStack is the stack of nodes to visit when the tree is queried, kept to avoid allocating
+         * memory each query.
+         */
+        AllocVector<int> _queryStack{ StandardAllocator<int> {_heapAllocator} };
+
+        int _root = AabbNode::Null;
+        int _freeList = AabbNode::Null;
+
+        /**
+         * @brief FatMargin is the margin added on each side of the simplified shape of a collider to get
+         * its fat rectangle.
+         */
+        float _fatMargin = 0.1f;
+
+        /**
+         * @brief HasRemovedProxies is true when a proxy has been removed since the last update of the pairs.
+         */
+        bool _hasRemovedProxies = false;
+
+        /**
+         * @brief PreallocatedNodeCount is the number of nodes allocated in the pool by Init.
+         */
+        static constexpr int _preallocatedNodeCount = 256;
+
+        /**
+         * @brief allocateNode is a method that takes a node from the free list, growing the pool if it is empty.
+         * @return The index of the node.
+         */
+        [[nodiscard]] int allocateNode() noexcept;
+
+        /**
+         * @brief freeNode is a method that gives back the node at the index given in parameter to the free list.
+         * @param nodeIndex The index of the node.
+         */
+        void freeNode(int nodeIndex) noexcept;
+
+        /**
+         * @brief insertLeaf is a method that inserts the leaf given in parameter in the tree next to the node
+         * whose rectangle increases the least the perimeter of the tree.
+         * @param leaf The index of the leaf.
+         */
+        void insertLeaf(int leaf) noexcept;
+
+        /**
+         * @brief removeLeaf is a method that removes the leaf given in parameter from the tree without freeing it.
+         * @param leaf The index of the leaf.
+         */
+        void removeLeaf(int leaf) noexcept;
+
+        /**
+         * @brief fixUpwards is a method that balances and refits the rectangles of the nodes from the node given
+         * in parameter to the root.
+         * @param nodeIndex The index of the first node to fix.
+         */
+        void fixUpwards(int nodeIndex) noexcept;
+
+        /**
+         * @brief balance is a method that rotates the node given in parameter with one of its children if its
+         * children heights differ by more than one.
+         * @param nodeIndex The index of the node to balance.
+         * @return The index of the node which is at the place of the given node after the rotation.
+         */
+        [[nodiscard]] int balance(int nodeIndex) noexcept;
+
+        /**
+         * @brief updateProxy is a method that creates or updates the proxy of a collider. The collider is only
+         * reinserted in the tree if its simplified shape left its fat rectangle.
+         * @param simplCol The simplified collider.
+         */
+        void updateProxy(const SimplifiedCollider& simplCol) noexcept;
+
+        /**
+         * @brief removeProxy is a method that removes the leaf of the proxy given in parameter from the tree.
+         * @param proxy The proxy to remove.
+         */
+        void removeProxy(AabbProxy& proxy) noexcept;
+
+        /**
+         * @brief markMoved is a method that marks the proxy at the index given in parameter as moved so that
+         * its pairs are recalculated.
+         * @param proxyIndex The index of the proxy (aka the index of its collider in the world).
+         */
+        void markMoved(std::size_t proxyIndex) noexcept;
+
+        /**
+         * @brief isProxyStale is a method that checks if the pairs of the collider given in parameter must be
+         * recalculated (aka if its proxy has moved, has been removed or belongs to another collider).
+         * @param colliderRef The collider reference in the world.
+         * @return True if the pairs of the collider must be recalculated.
+         */
+        [[nodiscard]] bool isProxyStale(ColliderRef colliderRef) const noexcept;
+
+        /**
+         * @brief queryPossiblePairs is a method that adds the possible pairs between the moved proxy given in
+         * parameter and the leaves of the tree.
+         * @param proxy The moved proxy.
+         */
+        void queryPossiblePairs(const AabbProxy& proxy) noexcept;
+
+    public:
+        AabbTree() noexcept = default;
+
+        /**
+         * @brief Init is a method that pre-allocates the pool of nodes.
+         */
+        void Init() noexcept override;
+
+        /**
+         * @brief Update is a method that updates the leaves of the colliders given in parameter, removes the
+         * leaves of the colliders that are not given anymore and recalculates the possible pairs of the moved
+         * colliders.
+         * @note The possible pairs are calculated with the fat rectangles, so they can contain pairs whose
+         * simplified shapes don't touch each other.
+         * @param colliders The simplified enabled colliders of the world.
+         */
+        void Update(const AllocVector<SimplifiedCollider>& colliders) noexcept override;
+
+        /**
+         * @brief PossiblePairs is a method that gives the possible pairs of collider whose fat rectangles
+         * touch each other.
+         * @return The possible pairs of collider whose fat rectangles touch each other.
+         */
+        [[nodiscard]] const AllocVector<ColliderPair>& PossiblePairs() const noexcept override
+        {
+            return _possiblePairs;
+        }
+
+        /**
+         * @brief Clear is a method that removes all nodes, proxies and possible pairs.
+         */
+        void Clear() noexcept override;
+
+        /**
+         * @brief Deinit is a method that deinitialize the tree by removing all data from it.
+         */
+        void Deinit() noexcept override;
+
+        /**
+         * @brief Root is a method that gives the index of the root node of the tree.
+         * @return The index of the root node, or AabbNode::Null if the tree is empty.
+         */
+        [[nodiscard]] int Root() const noexcept { return _root; }
+
+        /**
+         * @brief Nodes is a method that gives the pool of nodes of the tree.
+         * @return The pool of nodes of the tree.
+         */
+        [[nodiscard]] const AllocVector<AabbNode>& Nodes() const noexcept { return _nodes; }
+
+        /**
+         * @brief Height is a method that gives the height of the tree.
+         * @return The height of the tree, or 0 if the tree is empty.
+         */
+        [[nodiscard]] int Height() const noexcept { return _root == AabbNode::Null ? 0 : _nodes[_root].Height; }
+
+        /**
+         * @brief FatMargin is a method that gives the margin added on each side of the simplified shape
+         * of a collider to get its fat rectangle.
+         * @return The margin of the fat rectangles.
+         */
+        [[nodiscard]] float FatMargin() const noexcept { return _fatMargin; }
+
+        /**
+         * @brief SetFatMargin is a method that replaces the margin of the fat rectangles with the one given
+         * in parameter.
+         * @note The new margin is only applied to the colliders reinserted after the call.
+         * @param fatMargin The new margin of the fat rectangles.
+         */
+        void SetFatMargin(const float fatMargin) noexcept { _fatMargin = fatMargin; }
+    };
+}
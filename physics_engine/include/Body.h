@@ -38,6 +38,31 @@ namespace PhysicsEngine
         float _inverseMass = -1.f;
         BodyType _bodyType = BodyType::Dynamic;
 
+        /**
+         * @brief SleepTime is the time during which the body has been moving slower than the sleep velocity of
+         * the world.
+         */
+        float _sleepTime = 0.f;
+        bool _isAwake = true;
+
+        /**
+         * @brief IsContinuous is true if the moves of the body are swept against the static colliders so that
+         * it doesn't go through them when it is fast (aka a bullet).
+         */
+        bool _isContinuous = false;
+
+        /**
+         * @brief WakeUp is a method that wakes the body up if it is sleeping, so that any change of the body
+         * given by the user is simulated.
+         */
+        constexpr void wakeUp() noexcept
+        {
+            if (_isAwake) return;
+
+            _isAwake = true;
+            _sleepTime = 0.f;
+        }
+
     public:
         constexpr Body() noexcept = default;
         constexpr Body(Math::Vec2F pos, Math::Vec2F vel, float mass) noexcept
@@ -59,7 +84,11 @@ namespace PhysicsEngine
          * given in parameter.
          * @param newPosition The new position for the body.
          */
-        void constexpr SetPosition(const Math::Vec2F newPosition) noexcept { _position = newPosition; }
+        void constexpr SetPosition(const Math::Vec2F newPosition) noexcept
+        {
+            _position = newPosition;
+            wakeUp();
+        }
 
         /**
          * @brief Velocity is a method that gives the velocity of the body.
@@ -72,7 +101,11 @@ namespace PhysicsEngine
          * given in parameter.
          * @param newVelocity The new velocity for the body.
          */
-        void constexpr SetVelocity(const Math::Vec2F newVelocity) noexcept { _velocity = newVelocity; }
+        void constexpr SetVelocity(const Math::Vec2F newVelocity) noexcept
+        {
+            _velocity = newVelocity;
+            wakeUp();
+        }
 
         /**
          * @brief Mass is a method that gives the mass of the body.
@@ -89,6 +122,7 @@ namespace PhysicsEngine
         { 
             _mass = newMass; 
             _inverseMass = 1.f / _mass;
+            wakeUp();
         }
 
         /**
@@ -101,7 +135,11 @@ namespace PhysicsEngine
          * @brief ApplyForce is a method that applies a force to the body and adds it to the sum of the body's forces
          * @param force The force to be applied to the body.
          */
-        constexpr void ApplyForce(const Math::Vec2F force) noexcept { _forces += force; };
+        constexpr void ApplyForce(const Math::Vec2F force) noexcept
+        {
+            _forces += force;
+            wakeUp();
+        }
 
         /**
          * @brief Forces is a method that gives the sum of the body's forces.
@@ -139,6 +177,63 @@ namespace PhysicsEngine
             {
                 _inverseMass = 0.f;
             }
+
+            wakeUp();
+        }
+
+        /**
+         * @brief IsAwake is a method that checks if the body is simulated. A sleeping body is not integrated nor
+         * tested against the other sleeping bodies until it is woken up.
+         * @return True if the body is awake.
+         */
+        [[nodiscard]] constexpr bool IsAwake() const noexcept { return _isAwake; }
+
+        /**
+         * @brief SetAwake is a method that wakes the body up or puts it to sleep, in which case its velocity
+         * and its forces are set to zero.
+         * @note Setting the position, the velocity, the mass, the body-type or applying a force also wakes the
+         * body up.
+         * @param isAwake True to wake the body up, false to put it to sleep.
+         */
+        constexpr void SetAwake(const bool isAwake) noexcept
+        {
+            if (isAwake)
+            {
+                wakeUp();
+                return;
+            }
+
+            _isAwake = false;
+            _velocity = Math::Vec2F::Zero();
+            _forces = Math::Vec2F::Zero();
         }
+
+        /**
+         * @brief SleepTime is a method that gives the time during which the body has been moving slower than the
+         * sleep velocity of the world.
+         * @return The sleep time of the body.
+         */
+        [[nodiscard]] constexpr float SleepTime() const noexcept { return _sleepTime; }
+
+        /**
+         * @brief SetSleepTime is a method that replaces the sleep time of the body, it is updated by the world
+         * each step.
+         * @param sleepTime The new sleep time of the body.
+         */
+        constexpr void SetSleepTime(const float sleepTime) noexcept { _sleepTime = sleepTime; }
+
+        /**
+         * @brief IsContinuous is a method that checks if the moves of the body are swept against the static
+         * colliders (aka continuous collision detection).
+         * @return True if the body is continuous.
+         */
+        [[nodiscard]] constexpr bool IsContinuous() const noexcept { return _isContinuous; }
+
+        /**
+         * @brief SetContinuous is a method that enables or disables the continuous collision detection of the
+         * body, which should only be enabled for the small and fast bodies because of its cost.
+         * @param isContinuous True to sweep the moves of the body against the static colliders.
+         */
+        constexpr void SetContinuous(const bool isContinuous) noexcept { _isContinuous = isContinuous; }
     };
 }
\ No newline at end of file
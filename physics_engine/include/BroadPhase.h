@@ -0,0 +1,76 @@
+/**
+ * @headerfile BroadPhase.h
+ * This header file defines the BroadPhase class which is an interface for the algorithms that reduce the
+ * number of collider pairs to test in the narrow phase.
+ *
+ * @author Olivier Pachoud
+ */
+
+#pragma once
+
+#include "Allocator.h"
+#include "Collider.h"
+
+namespace PhysicsEngine
+{
+    /**
+     * @brief SimplifiedCollider is a struct that stores the data of a collider in a simplified way (aka it stores
+     * its collider reference in the world and its shape in a rectangle form).
+     */
+    struct SimplifiedCollider
+    {
+        ColliderRef ColRef{0, 0};
+        Math::RectangleF Rectangle{Math::Vec2F::Zero(), Math::Vec2F::Zero()};
+    };
+
+    /**
+     * @brief BroadPhaseType is an enumeration that represents the algorithms that can be used by the world
+     * for its broad phase.
+     */
+    enum class BroadPhaseType
+    {
+        QuadTree,
+        AabbTree,
+        SweepAndPrune,
+        SpatialHash,
+        LinearQuadTree
+    };
+
+    /**
+     * @brief BroadPhase is an abstract base class for the algorithms that find the possible pairs of colliders
+     * (aka the pairs whose simplified shapes touch each other).
+     */
+    class BroadPhase
+    {
+    public:
+        virtual ~BroadPhase() noexcept = default;
+
+        /**
+         * @brief Init is an abstract method that allocates the memory needed by the broad phase.
+         */
+        virtual void Init() noexcept = 0;
+
+        /**
+         * @brief Update is an abstract method that calculates the possible pairs of colliders of this step.
+         * @param colliders The simplified enabled colliders of the world.
+         */
+        virtual void Update(const AllocVector<SimplifiedCollider>& colliders) noexcept = 0;
+
+        /**
+         * @brief PossiblePairs is an abstract method that gives the possible pairs of colliders calculated
+         * by the last update.
+         * @return The possible pairs of colliders.
+         */
+        [[nodiscard]] virtual const AllocVector<ColliderPair>& PossiblePairs() const noexcept = 0;
+
+        /**
+         * @brief Clear is an abstract method that removes all colliders and possible pairs from the broad phase.
+         */
+        virtual void Clear() noexcept = 0;
+
+        /**
+         * @brief Deinit is an abstract method that deinitialize the broad phase by removing all data from it.
+         */
+        virtual void Deinit() noexcept = 0;
+    };
+}
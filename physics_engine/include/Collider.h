@@ -10,25 +10,32 @@
 #include "WorldRefTypes.h"
 #include "Shape.h"
 
+#include <cstdint>
 #include <variant>
 #include <utility>
 
 namespace PhysicsEngine
 {
+    /**
+     * @brief ColliderShape is the type of the mathematical shape of a collider, the index of its alternatives
+     * matches Math::ShapeType.
+     */
+    using ColliderShape = std::variant<Math::CircleF, Math::RectangleF, Math::PolygonF>;
+
     /**
      * @brief Collider is a class that represents a generic collider.
      */
     class Collider
     {
     private:
-        std::variant<Math::CircleF, Math::RectangleF, Math::PolygonF> _shape{
-                     Math::CircleF(Math::Vec2F::Zero(), 0.f)};
+        ColliderShape _shape{Math::CircleF(Math::Vec2F::Zero(), 0.f)};
         BodyRef _bodyRef{};
 
         float _restitution{-1.f};
         float _friction{-1.f};
         bool _isTrigger{false};
         bool _enabled{false};
+        bool _isShapeChanged{false};
 
     public:
         constexpr Collider() noexcept = default;
@@ -41,31 +48,45 @@ namespace PhysicsEngine
 
         /**
          * @brief Shape is a method that gives the mathematical shape of the collider.
+         * @note The shape is given by reference so that the vertices of a polygon are not copied.
          * @return The mathematical shape of the collider.
          */
-        [[nodiscard]] std::variant<Math::CircleF, Math::RectangleF, Math::PolygonF> Shape()
-        const noexcept { return _shape; }
+        [[nodiscard]] const ColliderShape& Shape() const noexcept { return _shape; }
 
         /**
          * @brief SetShape is a method that replaces the current mathematical shape of the collider
          * with a circle shape given in parameter.
          * @param circle The new circle shape for the collider.
          */
-        void SetShape(Math::CircleF circle) noexcept { _shape = circle; }
+        void SetShape(Math::CircleF circle) noexcept { _shape = circle; _isShapeChanged = true; }
 
         /**
          * @brief SetShape is a method that replaces the current mathematical shape of the collider
          * with rectangle shape given in parameter.
          * @param rectangle The new rectangle shape for the collider.
          */
-        void SetShape(Math::RectangleF rectangle) noexcept { _shape = rectangle; }
+        void SetShape(Math::RectangleF rectangle) noexcept { _shape = rectangle; _isShapeChanged = true; }
 
         /**
          * @brief SetShape is a method that replaces the current mathematical shape of the collider
          * with a polygon shape given in parameter.
          * @param polygon The new polygon shape for the collider.
          */
-        void SetShape(Math::PolygonF polygon) noexcept { _shape = polygon; }
+        void SetShape(Math::PolygonF polygon) noexcept { _shape = std::move(polygon); _isShapeChanged = true; }
+
+        /**
+         * @brief IsShapeChanged is a method that checks if the shape of the collider has been replaced since the
+         * world last woke up its body.
+         * @return True if the shape has been replaced.
+         */
+        [[nodiscard]] constexpr bool IsShapeChanged() const noexcept { return _isShapeChanged; }
+
+        /**
+        * @brief SetShapeChanged is a method that replaces the current shape changed state of the collider
+        * with the state given in parameter.
+        * @param isShapeChanged Whether the shape has been replaced or not.
+        */
+        constexpr void SetShapeChanged(const bool isShapeChanged) noexcept { _isShapeChanged = isShapeChanged; }
 
         /**
          * @brief GetBodyRef is a method that gives the body reference of the collider in the world.
@@ -152,6 +173,19 @@ namespace PhysicsEngine
         {
             return ColliderA < other.ColliderA || (ColliderA == other.ColliderA && ColliderB < other.ColliderB);
         }
+
+        /**
+         * @brief Key is a method that gives a key identifying the pair whatever the order of its colliders
+         * (aka the lowest collider index in the 32 high bits and the highest one in the 32 low bits).
+         * @return The key of the pair.
+         */
+        [[nodiscard]] constexpr std::uint64_t Key() const noexcept
+        {
+            const auto indexA = static_cast<std::uint64_t>(ColliderA.Index);
+            const auto indexB = static_cast<std::uint64_t>(ColliderB.Index);
+
+            return indexA < indexB ? indexA << 32 | indexB : indexB << 32 | indexA;
+        }
     };
 
     /**
@@ -167,14 +201,8 @@ namespace PhysicsEngine
          */
         std::size_t operator()(const ColliderPair& pair) const noexcept
         {
-            // Calculate the hash for the ColliderA's index.
-            const std::size_t hash1 = std::hash<int>{}(static_cast<int>(pair.ColliderA.Index));
-
-            // Calculate the hash for the ColliderB's index.
-            const std::size_t hash2 = std::hash<int>{}(static_cast<int>(pair.ColliderB.Index));
-
-            // Combine the two hash values to create a unique hash value for the ColliderPair.
-            return hash1 + hash2;
+            // The key of the pair is a single integer which doesn't depend on the order of the colliders.
+            return std::hash<std::uint64_t>{}(pair.Key());
         }
     };
 }
\ No newline at end of file
@@ -0,0 +1,460 @@
+/**
+ * @headerfile ContactConstraintSolver.h
+ * This file defines the ContactConstraintSolver class which solves all the contacts of a step together with
+ * sequential impulses, warm-started by the impulses of the previous step.
+ *
+ * @author Olivier Pachoud
+ */
+
+#pragma once
+
+#include "Allocator.h"
+#include "Body.h"
+#include "Collider.h"
+#include "IslandGraph.h"
+#include "JobSystem.h"
+#include "ShapePairDispatch.h"
+#include "SimdLevel.h"
+
+#include <array>
+#include <cstdint>
+
+namespace PhysicsEngine
+{
+    /**
+     * @brief ContactConstraintPoint is a struct that stores a point of a contact constraint and the normal
+     * impulse accumulated on it during the step.
+     */
+    struct ContactConstraintPoint
+    {
+        Math::Vec2F Point = Math::Vec2F::Zero();
+        float NormalImpulse = 0.f;
+    };
+
+    /**
+     * @brief ContactConstraint is a struct that stores the manifold of a pair of colliders in contact and the
+     * data of its bodies used by the solver.
+     */
+    struct ContactConstraint
+    {
+        ColliderPair Pair{};
+        std::size_t BodyIndexA = 0;
+        std::size_t BodyIndexB = 0;
+
+        /**
+         * @brief Normal is the normal of the contact, from the body B to the body A.
+         */
+        Math::Vec2F Normal = Math::Vec2F::Zero();
+        std::array<ContactConstraintPoint, MaxManifoldPointCount> Points{};
+        int PointCount = 0;
+        float Penetration = 0.f;
+        float Restitution = 0.f;
+
+        /**
+         * @brief InverseMassA and InverseMassB are the inverse masses of the bodies, zero for the bodies that
+         * are not dynamic so that they are never moved by the contact.
+         */
+        float InverseMassA = 0.f;
+        float InverseMassB = 0.f;
+
+        /**
+         * @brief NormalMass is the inverse of the sum of the inverse masses of the bodies.
+         */
+        float NormalMass = 0.f;
+
+        /**
+         * @brief VelocityBias is the separating velocity targeted by the solver (aka the bounce of the contact).
+         */
+        float VelocityBias = 0.f;
+
+        Math::Vec2F StartPositionA = Math::Vec2F::Zero();
+        Math::Vec2F StartPositionB = Math::Vec2F::Zero();
+    };
+
+    /**
+     * @brief ContactSolverMode is an enumeration that represents how the contacts of an island are ordered:
+     * Sequential (one after the other in key order) or GraphColored (the large islands are split in colors of
+     * contacts that don't share any dynamic body, and the contacts of a color are solved in parallel).
+     */
+    enum class ContactSolverMode
+    {
+        Sequential,
+        GraphColored
+    };
+
+    /**
+     * @brief SolverIsland is a struct that gives the range of the constraints of an island in the solve order
+     * of the solver.
+     */
+    struct SolverIsland
+    {
+        std::size_t ConstraintBegin = 0;
+        std::size_t ConstraintCount = 0;
+    };
+
+    /**
+     * @brief SolverTask is a struct that gives the range of the solver islands solved by one job.
+     */
+    struct SolverTask
+    {
+        std::size_t IslandBegin = 0;
+        std::size_t IslandCount = 0;
+    };
+
+    /**
+     * @brief SolverColor is a struct that gives the range of the constraints of a color in the solve order of
+     * the solver.
+     */
+    struct SolverColor
+    {
+        std::size_t ConstraintBegin = 0;
+        std::size_t ConstraintCount = 0;
+
+        /**
+         * @brief IsShared is true for the constraints that didn't get a color, they can share dynamic bodies so
+         * they are solved one after the other.
+         */
+        bool IsShared = false;
+    };
+
+    /**
+     * @brief ContactConstraintSoA is a struct that stores the data of the velocity iterations of the constraints
+     * of a colored island in separate contiguous arrays, in the solve order of the island.
+     */
+    struct ContactConstraintSoA
+    {
+        static_assert(MaxManifoldPointCount == 2, "The contact constraint SoA stores two impulses per constraint.");
+
+        AllocVector<float> NormalsX;
+        AllocVector<float> NormalsY;
+        AllocVector<float> InverseMassesA;
+        AllocVector<float> InverseMassesB;
+        AllocVector<float> NormalMasses;
+        AllocVector<float> VelocityBiases;
+        AllocVector<float> FirstNormalImpulses;
+        AllocVector<float> SecondNormalImpulses;
+
+        /**
+         * @brief PointCounts are stored as floats so that they are compared in the SIMD lanes.
+         */
+        AllocVector<float> PointCounts;
+        AllocVector<std::size_t> BodyIndicesA;
+        AllocVector<std::size_t> BodyIndicesB;
+
+        explicit ContactConstraintSoA(Allocator& allocator) noexcept;
+
+        void Resize(std::size_t count) noexcept;
+        void Clear() noexcept;
+    };
+
+    /**
+     * @brief ContactConstraintSolver is a class that solves the contacts of a step with sequential impulses.
+     * The contact constraints are kept from one step to the next one by collider pair, so that the impulses
+     * accumulated in the previous step are applied first (aka warm start) and the contacts that last converge
+     * over several steps.
+     */
+    class ContactConstraintSolver
+    {
+    private:
+        /**
+         * @brief Constraints are the contact constraints of the current step, sorted by key of their pair
+         * (see ColliderPair::Key).
+         */
+        AllocVector<ContactConstraint> _constraints;
+
+        /**
+         * @brief PreviousConstraints are the contact constraints of the previous step, sorted by key of their pair.
+         */
+        AllocVector<ContactConstraint> _previousConstraints;
+
+        /**
+         * @brief VelocityChanges are the changes of velocity given by the solver to the bodies of the step, indexed
+         * by body index.
+         */
+        AllocVector<Math::Vec2F> _velocityChanges;
+
+        /**
+         * @brief SolveOrder are the indices of the constraints grouped by island, in key order in each island.
+         */
+        AllocVector<std::size_t> _solveOrder;
+
+        /**
+         * @brief SolverIslands are the islands that have constraints, the largest first.
+         */
+        AllocVector<SolverIsland> _solverIslands;
+
+        /**
+         * @brief SolverTasks are the jobs of the solve, a large island alone or a batch of small islands.
+         */
+        AllocVector<SolverTask> _solverTasks;
+
+        /**
+         * @brief ColoredIslandCount is the number of islands at the start of the solver islands that are solved
+         * color by color, the other ones are solved by the solver tasks.
+         */
+        std::size_t _coloredIslandCount = 0;
+
+        /**
+         * @brief BodyColorMasks are the colors used by the constraints of each dynamic body, one bit per color,
+         * indexed by body index.
+         */
+        AllocVector<std::uint64_t> _bodyColorMasks;
+
+        /**
+         * @brief ConstraintColors are the colors of the constraints of the island being colored, in its solve order.
+         */
+        AllocVector<std::size_t> _constraintColors;
+        AllocVector<std::size_t> _colorOrder;
+
+        /**
+         * @brief SolverColors are the colors of the last colored island, the shared constraints last.
+         */
+        AllocVector<SolverColor> _solverColors;
+
+        ContactConstraintSoA _constraintSoA;
+
+        ContactSolverMode _mode = ContactSolverMode::Sequential;
+        std::size_t _graphColoringConstraintCount = DefaultGraphColoringConstraintCount;
+
+        int _velocityIterationCount = DefaultVelocityIterationCount;
+        int _positionIterationCount = DefaultPositionIterationCount;
+
+        /**
+         * @brief PrepareConstraints is a method that calculates the masses, the bounce and the start positions of
+         * the constraints in [begin, end) of the solve order and applies their warm-start impulses.
+         */
+        void prepareConstraints(AllocVector<Body>& bodies, std::size_t begin, std::size_t end) noexcept;
+
+        /**
+         * @brief SolveVelocities is a method that applies the impulses that stop the bodies in contact from
+         * moving towards each other, one iteration over the constraints in [begin, end) of the solve order.
+         */
+        void solveVelocities(AllocVector<Body>& bodies, std::size_t begin, std::size_t end) noexcept;
+
+        /**
+         * @brief SolvePositions is a method that moves the bodies in contact apart by a part of their remaining
+         * penetration, one iteration over the constraints in [begin, end) of the solve order.
+         */
+        void solvePositions(AllocVector<Body>& bodies, std::size_t begin, std::size_t end) const noexcept;
+
+        /**
+         * @brief ApplyImpulse is a method that applies the impulse given in parameter to the body A of the constraint
+         * and its opposite to the body B.
+         */
+        void applyImpulse(AllocVector<Body>& bodies, const ContactConstraint& constraint, Math::Vec2F impulse) noexcept;
+
+        /**
+         * @brief CorrectIntegratedPositions is a method that moves the bodies of the step by their change of
+         * velocity multiplied by the delta time, as if they had been integrated with their solved velocity.
+         */
+        void correctIntegratedPositions(AllocVector<Body>& bodies, std::size_t begin, std::size_t end,
+                                        float deltaTime) noexcept;
+
+        /**
+         * @brief SolveIsland is a method that solves the constraints of an island from start to end. The islands
+         * don't share any dynamic body, so they give the same results whatever order and thread they are solved in.
+         */
+        void solveIsland(AllocVector<Body>& bodies, const SolverIsland& island, float deltaTime) noexcept;
+
+        /**
+         * @brief GroupByIsland is a method that fills the solve order, the islands and the tasks of the solve
+         * from the islands of the bodies of the constraints.
+         */
+        void groupByIsland(const IslandGraph& islandGraph) noexcept;
+
+        /**
+         * @brief ColorConstraints is a method that sorts the constraints in [begin, end) of the solve order by
+         * color with a greedy coloring, so that the constraints of a color don't share any dynamic body.
+         */
+        void colorConstraints(std::size_t begin, std::size_t end) noexcept;
+
+        /**
+         * @brief SolveColoredIsland is a method that solves the constraints of an island color by color, the
+         * constraints of a color being split in chunks solved in parallel on the job system.
+         */
+        void solveColoredIsland(AllocVector<Body>& bodies, const SolverIsland& island, float deltaTime,
+                                JobSystem* jobSystem, SimdLevel kernel) noexcept;
+
+        /**
+         * @brief SolveVelocitiesSoA is a method that runs one velocity iteration over the constraints in
+         * [begin, end) of the constraint SoA, 4 by 4 with the SIMD kernels.
+         */
+        void solveVelocitiesSoA(AllocVector<Body>& bodies, std::size_t begin, std::size_t end,
+                                SimdLevel kernel) noexcept;
+
+    public:
+        static constexpr int DefaultVelocityIterationCount = 8;
+        static constexpr int DefaultPositionIterationCount = 3;
+
+        /**
+         * @brief PositionCorrectionFactor is the part of the remaining penetration removed by each position
+         * iteration.
+         */
+        static constexpr float PositionCorrectionFactor = 0.2f;
+
+        /**
+         * @brief LinearSlop is the penetration that is allowed so that the contacts are kept from one step to the
+         * next one instead of jittering.
+         */
+        static constexpr float LinearSlop = 0.005f;
+
+        /**
+         * @brief RestitutionVelocityThreshold is the approach velocity under which the contacts don't bounce,
+         * so that the bodies at rest stay at rest.
+         */
+        static constexpr float RestitutionVelocityThreshold = 1.f;
+
+        /**
+         * @brief WarmStartNormalTolerance is the minimum cosine between the normals of a contact in two steps for
+         * the impulses of the previous step to be kept.
+         */
+        static constexpr float WarmStartNormalTolerance = 0.95f;
+
+        /**
+         * @brief IslandBatchConstraintCount is the number of constraints under which the islands are solved together
+         * in one job, so that the cost of a job is not higher than the solve of its islands.
+         */
+        static constexpr std::size_t IslandBatchConstraintCount = 64;
+
+        /**
+         * @brief DefaultGraphColoringConstraintCount is the number of constraints from which the islands are
+         * solved color by color in the GraphColored mode.
+         */
+        static constexpr std::size_t DefaultGraphColoringConstraintCount = 256;
+
+        /**
+         * @brief MaxColorCount is the number of colors of the coloring, the constraints that don't fit in any are
+         * shared.
+         */
+        static constexpr std::size_t MaxColorCount = 64;
+
+        /**
+         * @brief ColorChunkConstraintCount is the number of constraints of a color solved by one job.
+         */
+        static constexpr std::size_t ColorChunkConstraintCount = 64;
+
+        explicit ContactConstraintSolver(Allocator& allocator) noexcept;
+
+        /**
+         * @brief BeginStep is a method that keeps the constraints of the last step to warm-start the new ones
+         * and removes them from the current step.
+         * @param contactCount The number of contacts to pre-allocate for the new step.
+         */
+        void BeginStep(std::size_t contactCount) noexcept;
+
+        /**
+         * @brief AddContact is a method that adds the contact of a pair of colliders to the step, with the
+         * impulses of the same pair in the previous step.
+         * @note The contacts must be added in the key order of their pairs.
+         * @param pair The pair of colliders in contact.
+         * @param bodyIndexA The index of the body of the collider A.
+         * @param bodyIndexB The index of the body of the collider B.
+         * @param restitution The restitution of the contact (see CombinedRestitution).
+         * @param manifold The contact manifold of the pair, the normal going from the collider B to the A.
+         */
+        void AddContact(const ColliderPair& pair, std::size_t bodyIndexA, std::size_t bodyIndexB, float restitution,
+                        const ContactManifold& manifold) noexcept;
+
+        /**
+         * @brief Solve is a method that solves all the contacts of the step, changing the velocities and the
+         * positions of the dynamic bodies in contact.
+         * @note The bodies are expected to be already integrated for the step, so the change of velocity is also
+         * applied to their position.
+         * @param bodies The bodies of the world, indexed by the body indices of the contacts.
+         * @param deltaTime The delta time with which the bodies have been integrated.
+         */
+        void Solve(AllocVector<Body>& bodies, float deltaTime) noexcept;
+
+        /**
+         * @brief Solve is a method that solves the contacts of the step island by island, the largest islands
+         * first, on the job system given in parameter if any. The results are the same as the ones of a solve
+         * of all the contacts together on one thread.
+         * @note The island graph must be built from the pairs of the contacts of the step.
+         * @param bodies The bodies of the world, indexed by the body indices of the contacts.
+         * @param deltaTime The delta time with which the bodies have been integrated.
+         * @param islandGraph The islands of the bodies of the contacts.
+         * @param jobSystem The job system on which the islands are solved, nullptr to solve them on this thread.
+         * @param kernel The instruction set used by the velocity iterations of the colored islands
+         * (see SimdLevel), the Avx2 kernel solves them 4 by 4 as the Sse one.
+         */
+        void Solve(AllocVector<Body>& bodies, float deltaTime, const IslandGraph& islandGraph,
+                   JobSystem* jobSystem, SimdLevel kernel = SimdLevel::Scalar) noexcept;
+
+        /**
+         * @brief SolverIslands is a method that gives the islands of the last solve, the largest first.
+         */
+        [[nodiscard]] const AllocVector<SolverIsland>& SolverIslands() const noexcept { return _solverIslands; }
+
+        /**
+         * @brief SolverTasks is a method that gives the jobs of the last solve.
+         */
+        [[nodiscard]] const AllocVector<SolverTask>& SolverTasks() const noexcept { return _solverTasks; }
+
+        /**
+         * @brief ColoredIslandCount is a method that gives the number of islands of the last solve that have been
+         * solved color by color, they are the first solver islands.
+         */
+        [[nodiscard]] std::size_t ColoredIslandCount() const noexcept { return _coloredIslandCount; }
+
+        /**
+         * @brief SolverColors is a method that gives the colors of the last colored island.
+         */
+        [[nodiscard]] const AllocVector<SolverColor>& SolverColors() const noexcept { return _solverColors; }
+
+        /**
+         * @brief SolveOrder is a method that gives the indices of the constraints in the order of the last solve.
+         */
+        [[nodiscard]] const AllocVector<std::size_t>& SolveOrder() const noexcept { return _solveOrder; }
+
+        [[nodiscard]] ContactSolverMode Mode() const noexcept { return _mode; }
+        void SetMode(const ContactSolverMode mode) noexcept { _mode = mode; }
+
+        [[nodiscard]] std::size_t GraphColoringConstraintCount() const noexcept
+        {
+            return _graphColoringConstraintCount;
+        }
+
+        /**
+         * @brief SetGraphColoringConstraintCount is a method that sets the number of constraints from which the
+         * islands are solved color by color in the GraphColored mode.
+         */
+        void SetGraphColoringConstraintCount(const std::size_t count) noexcept
+        {
+            _graphColoringConstraintCount = count;
+        }
+
+        /**
+         * @brief Clear is a method that removes the constraints of the current and of the previous step.
+         */
+        void Clear() noexcept;
+
+        /**
+         * @brief CombinedRestitution is a function that gives the restitution of a contact between two bodies,
+         * the restitutions of their colliders weighted by their masses.
+         */
+        [[nodiscard]] static float CombinedRestitution(const Body& bodyA, const Body& bodyB,
+                                                       const Collider& colliderA, const Collider& colliderB) noexcept;
+
+        /**
+         * @brief Constraints is a method that gives the contact constraints of the current step.
+         * @return The contact constraints sorted by key of their pair.
+         */
+        [[nodiscard]] const AllocVector<ContactConstraint>& Constraints() const noexcept { return _constraints; }
+
+        [[nodiscard]] int VelocityIterationCount() const noexcept { return _velocityIterationCount; }
+
+        /**
+         * @brief SetVelocityIterationCount is a method that sets the number of times all the contacts are solved
+         * for the velocities each step, more iterations make the stacks more stable.
+         */
+        void SetVelocityIterationCount(const int count) noexcept { _velocityIterationCount = count; }
+
+        [[nodiscard]] int PositionIterationCount() const noexcept { return _positionIterationCount; }
+
+        /**
+         * @brief SetPositionIterationCount is a method that sets the number of times all the contacts are solved
+         * for the penetrations each step.
+         */
+        void SetPositionIterationCount(const int count) noexcept { _positionIterationCount = count; }
+    };
+}
@@ -12,6 +12,7 @@
 #include "WorldRefTypes.h"
 #include "Body.h"
 #include "Collider.h"
+#include "ShapePairDispatch.h"
 
 namespace PhysicsEngine
 {
@@ -27,7 +28,7 @@ namespace PhysicsEngine
 		Collider* ColliderB = nullptr;
 		Math::Vec2F Normal;
 		Math::Vec2F Point;
-		float Penetration;
+		float Penetration = 0.f;
 
 		/**
 		* @brief InitContactActors is a method that initialize the two actors of the contact.
@@ -41,7 +42,9 @@ namespace PhysicsEngine
 
 		/**
 		* @brief CalculateContactProperties is a method that calculates the normal, the point and the 
-		* penetration of the contact.
+		* penetration of the contact with the manifold kernel of the shapes of the two colliders.
+		* @note As in the previous solver, the actors are swapped if the shape type of the collider A comes after
+		* the one of the collider B, the normal then goes from the rectangle to the circle.
 		*/ 
 		void CalculateContactProperties() noexcept;
 
@@ -0,0 +1,429 @@
+/**
+ * @headerfile Gjk.h
+ * This header file defines the GJK overlap test and the EPA penetration solver, which work on the support
+ * functions of convex shapes.
+ *
+ * @author Olivier Pachoud
+ */
+
+#pragma once
+
+#include "Shape.h"
+#include "Vec2.h"
+
+#include <array>
+#include <limits>
+
+namespace PhysicsEngine
+{
+    /**
+     * @brief TranslatedPolygon is a struct that gives the world-space vertices of a polygon as a span on its
+     * vertices and an offset added to each of them, so that local vertices are never copied.
+     */
+    struct TranslatedPolygon
+    {
+        Math::PolygonSpanF Vertices{nullptr, 0};
+        Math::Vec2F Offset = Math::Vec2F::Zero();
+    };
+
+    /**
+     * @brief SimplexCache is a struct that stores the search directions of the last simplex found by GJK for
+     * a pair of shapes, so that the next test of the pair starts from it (aka warm start).
+     */
+    struct SimplexCache
+    {
+        std::array<Math::Vec2F, 3> Directions{};
+        int Count = 0;
+    };
+
+    /**
+     * @brief Simplex is a struct that stores the points of the Minkowski difference found by GJK, the newest
+     * point being the last one, and the directions used to find them.
+     */
+    struct Simplex
+    {
+        std::array<Math::Vec2F, 3> Points{};
+        std::array<Math::Vec2F, 3> Directions{};
+        int Count = 0;
+
+        void Push(const Math::Vec2F point, const Math::Vec2F direction) noexcept
+        {
+            Points[Count] = point;
+            Directions[Count] = direction;
+            Count++;
+        }
+    };
+
+    /**
+     * @brief Support gives the point of the shape that is the furthest in the direction given in parameter.
+     */
+    [[nodiscard]] inline Math::Vec2F Support(const Math::CircleF& circle, const Math::Vec2F direction) noexcept
+    {
+        const auto length = direction.Length();
+
+        if (length <= Math::Epsilon) return circle.Center();
+
+        return circle.Center() + direction * (circle.Radius() / length);
+    }
+
+    [[nodiscard]] inline Math::Vec2F Support(const Math::RectangleF& rectangle, const Math::Vec2F direction) noexcept
+    {
+        return Math::Vec2F(direction.X >= 0.f ? rectangle.MaxBound().X : rectangle.MinBound().X,
+                           direction.Y >= 0.f ? rectangle.MaxBound().Y : rectangle.MinBound().Y);
+    }
+
+    [[nodiscard]] inline Math::Vec2F Support(const TranslatedPolygon& polygon, const Math::Vec2F direction) noexcept
+    {
+        const auto& vertices = polygon.Vertices;
+
+        int bestIdx = 0;
+        float bestProjection = std::numeric_limits<float>::lowest();
+
+        for (int i = 0; i < vertices.VerticesCount(); i++)
+        {
+            const auto projection = vertices[i].Dot(direction);
+
+            if (projection > bestProjection)
+            {
+                bestProjection = projection;
+                bestIdx = i;
+            }
+        }
+
+        return vertices[bestIdx] + polygon.Offset;
+    }
+
+    /**
+     * @brief BoundingCircle gives a circle that contains the shape, used to reject the pairs early.
+     */
+    [[nodiscard]] inline Math::CircleF BoundingCircle(const Math::CircleF& circle) noexcept { return circle; }
+
+    [[nodiscard]] inline Math::CircleF BoundingCircle(const Math::RectangleF& rectangle) noexcept
+    {
+        return Math::CircleF(rectangle.Center(), rectangle.HalfSize().Length());
+    }
+
+    [[nodiscard]] inline Math::CircleF BoundingCircle(const TranslatedPolygon& polygon) noexcept
+    {
+        if (!polygon.Vertices.HasCachedData())
+        {
+            return Math::CircleF(polygon.Offset, std::numeric_limits<float>::infinity());
+        }
+
+        return polygon.Vertices.BoundingCircle() + polygon.Offset;
+    }
+
+    /**
+     * @brief Center gives a point inside the shape, used as the first search direction of GJK.
+     */
+    [[nodiscard]] inline Math::Vec2F Center(const Math::CircleF& circle) noexcept { return circle.Center(); }
+
+    [[nodiscard]] inline Math::Vec2F Center(const Math::RectangleF& rectangle) noexcept { return rectangle.Center(); }
+
+    [[nodiscard]] inline Math::Vec2F Center(const TranslatedPolygon& polygon) noexcept
+    {
+        return BoundingCircle(polygon).Center();
+    }
+
+    /**
+     * @brief UpdateSimplex is a function that reduces the simplex to the feature closest to the origin and
+     * gives the next search direction.
+     * @param simplex The simplex, its newest point being the last one.
+     * @param direction The next search direction.
+     * @return True if the simplex contains the origin.
+     */
+    [[nodiscard]] bool UpdateSimplex(Simplex& simplex, Math::Vec2F& direction) noexcept;
+
+    /**
+     * @brief MaxGjkIterationCount is the number of points GJK adds to the simplex before giving up.
+     */
+    static constexpr int MaxGjkIterationCount = 32;
+
+    /**
+     * @brief MinkowskiSupport gives the support point of the Minkowski difference A - B.
+     */
+    template<typename ShapeA, typename ShapeB>
+    [[nodiscard]] Math::Vec2F MinkowskiSupport(const ShapeA& shapeA, const ShapeB& shapeB,
+                                               const Math::Vec2F direction) noexcept
+    {
+        return Support(shapeA, direction) - Support(shapeB, -direction);
+    }
+
+    /**
+     * @brief GjkOverlap is a function that checks if two convex shapes overlap with the GJK algorithm.
+     * @param shapeA The shape A.
+     * @param shapeB The shape B.
+     * @param simplex The last simplex found, it contains the origin if the shapes overlap.
+     * @param cache The simplex of the previous test of the pair to start from, updated with the new simplex.
+     * Can be nullptr.
+     * @return True if the two shapes overlap (touching shapes overlap).
+     */
+    template<typename ShapeA, typename ShapeB>
+    [[nodiscard]] bool GjkOverlap(const ShapeA& shapeA, const ShapeB& shapeB, Simplex& simplex,
+                                  SimplexCache* cache = nullptr) noexcept
+    {
+        simplex.Count = 0;
+
+        Math::Vec2F direction;
+        bool containsOrigin = false;
+
+        if (cache != nullptr && cache->Count > 0)
+        {
+            // Warm start: the support points of the previous directions are recalculated at the new positions.
+            for (int i = 0; i < cache->Count; i++)
+            {
+                simplex.Push(MinkowskiSupport(shapeA, shapeB, cache->Directions[i]), cache->Directions[i]);
+            }
+
+            containsOrigin = UpdateSimplex(simplex, direction);
+        }
+        else
+        {
+            direction = Center(shapeA) - Center(shapeB);
+
+            if (direction.SquareLength() <= Math::Epsilon) direction = Math::Vec2F(1.f, 0.f);
+
+            simplex.Push(MinkowskiSupport(shapeA, shapeB, direction), direction);
+            direction = -simplex.Points[0];
+        }
+
+        for (int i = 0; i < MaxGjkIterationCount && !containsOrigin; i++)
+        {
+            // The origin is on the simplex.
+            if (direction.SquareLength() <= 0.f)
+            {
+                containsOrigin = true;
+                break;
+            }
+
+            const auto point = MinkowskiSupport(shapeA, shapeB, direction);
+
+            // The furthest point does not pass the origin, so the origin is outside the Minkowski difference.
+            if (point.Dot(direction) < 0.f) break;
+
+            simplex.Push(point, direction);
+            containsOrigin = UpdateSimplex(simplex, direction);
+        }
+
+        if (cache != nullptr)
+        {
+            cache->Count = simplex.Count;
+
+            for (int i = 0; i < simplex.Count; i++)
+            {
+                cache->Directions[i] = simplex.Directions[i];
+            }
+        }
+
+        return containsOrigin;
+    }
+
+    /**
+     * @brief Penetration is a struct that stores the normal of the boundary of the Minkowski difference closest
+     * to the origin (aka from A to B) and the distance between them.
+     */
+    struct Penetration
+    {
+        Math::Vec2F Normal = Math::Vec2F::Zero();
+        float Depth = 0.f;
+    };
+
+    /**
+     * @brief MaxEpaIterationCount is the number of points EPA adds to the polytope before giving up.
+     */
+    static constexpr int MaxEpaIterationCount = 32;
+
+    /**
+     * @brief EpaTolerance is the distance under which the polytope is considered to have reached the boundary
+     * of the Minkowski difference.
+     */
+    static constexpr float EpaTolerance = 0.0001f;
+
+    /**
+     * @brief Epa is a function that calculates the penetration of two overlapping convex shapes with the EPA
+     * algorithm, starting from the simplex found by GJK.
+     * @param shapeA The shape A.
+     * @param shapeB The shape B.
+     * @param simplex The simplex found by GJK, which contains the origin.
+     * @return The penetration of the two shapes.
+     */
+    template<typename ShapeA, typename ShapeB>
+    [[nodiscard]] Penetration Epa(const ShapeA& shapeA, const ShapeB& shapeB, const Simplex& simplex) noexcept
+    {
+        // The polytope can't have more points than the simplex and one per iteration.
+        std::array<Math::Vec2F, 3 + MaxEpaIterationCount> polytope{};
+        int count = simplex.Count;
+
+        for (int i = 0; i < count; i++)
+        {
+            polytope[i] = simplex.Points[i];
+        }
+
+        // A degenerate simplex (the origin on a point or an edge) is completed to a triangle.
+        if (count == 1)
+        {
+            polytope[count++] = MinkowskiSupport(shapeA, shapeB, Math::Vec2F(1.f, 0.f));
+
+            if (polytope[1] == polytope[0]) polytope[1] = MinkowskiSupport(shapeA, shapeB, Math::Vec2F(-1.f, 0.f));
+        }
+
+        if (count == 2)
+        {
+            const auto edge = polytope[1] - polytope[0];
+            auto normal = Math::Vec2F(-edge.Y, edge.X);
+
+            if (normal.SquareLength() <= 0.f) normal = Math::Vec2F(0.f, 1.f);
+
+            const auto point = MinkowskiSupport(shapeA, shapeB, normal);
+            polytope[count++] = !(point == polytope[0]) && !(point == polytope[1]) ?
+                                point : MinkowskiSupport(shapeA, shapeB, -normal);
+        }
+
+        // The edges are kept counter-clockwise so that their outward normal is on their right.
+        const auto area = (polytope[1] - polytope[0]).X * (polytope[2] - polytope[0]).Y -
+                          (polytope[1] - polytope[0]).Y * (polytope[2] - polytope[0]).X;
+
+        if (area < 0.f) std::swap(polytope[1], polytope[2]);
+
+        Penetration penetration;
+
+        for (int iteration = 0; iteration <= MaxEpaIterationCount; iteration++)
+        {
+            int closestIdx = 0;
+            float closestDistance = std::numeric_limits<float>::max();
+            Math::Vec2F closestNormal = Math::Vec2F::Zero();
+
+            for (int i = 0; i < count; i++)
+            {
+                const auto& pointA = polytope[i];
+                const auto& pointB = polytope[(i + 1) % count];
+                const auto edge = pointB - pointA;
+                const auto length = edge.Length();
+
+                if (length <= Math::Epsilon) continue;
+
+                const auto normal = Math::Vec2F(edge.Y, -edge.X) / length;
+                const auto distance = normal.Dot(pointA);
+
+                if (distance < closestDistance)
+                {
+                    closestDistance = distance;
+                    closestNormal = normal;
+                    closestIdx = i;
+                }
+            }
+
+            penetration.Normal = closestNormal;
+            penetration.Depth = closestDistance;
+
+            if (iteration == MaxEpaIterationCount) break;
+
+            const auto point = MinkowskiSupport(shapeA, shapeB, closestNormal);
+
+            // The edge is on the boundary of the Minkowski difference.
+            if (point.Dot(closestNormal) - closestDistance < EpaTolerance) break;
+
+            for (int i = count; i > closestIdx + 1; i--)
+            {
+                polytope[i] = polytope[i - 1];
+            }
+
+            polytope[closestIdx + 1] = point;
+            count++;
+        }
+
+        return penetration;
+    }
+
+    /**
+     * @brief ShapeCastHit is a struct that stores the first contact of a shape moving towards another one: the
+     * fraction of the translation at which they touch and the normal of the contact (from the shape B to the
+     * shape A).
+     */
+    struct ShapeCastHit
+    {
+        bool Hit = false;
+        float Time = 1.f;
+        Math::Vec2F Normal = Math::Vec2F::Zero();
+    };
+
+    /**
+     * @brief ShapeCastTolerance is the distance under which a moving shape is considered touching the other one.
+     */
+    static constexpr float ShapeCastTolerance = 0.0001f;
+
+    /**
+     * @brief ClosestPointOnRay is a function that gives the point of the convex hull of the points x - p, with
+     * p the Minkowski points given in parameter, closest to the origin, and reduces the Minkowski points to the
+     * ones of the closest feature.
+     * @param points The points of the Minkowski difference, reduced to the points of the closest feature.
+     * @param count The number of points, reduced with them.
+     * @param rayPoint The current point of the ray (aka x).
+     * @return The closest point to the origin, zero if the ray point is inside the hull of the points.
+     */
+    [[nodiscard]] Math::Vec2F ClosestPointOnRay(std::array<Math::Vec2F, 3>& points, int& count,
+                                                Math::Vec2F rayPoint) noexcept;
+
+    /**
+     * @brief ShapeCast is a function that calculates when a convex shape translated from its position touches
+     * another convex shape that doesn't move, by casting a ray against their Minkowski difference with GJK
+     * (aka conservative advancement). The time found is never after the real time of impact.
+     * @param shapeA The shape A at the start of the translation.
+     * @param shapeB The shape B.
+     * @param translation The translation of the shape A.
+     * @return The first contact, the time being a fraction of the translation, or no hit if the shapes don't
+     * touch during the translation. The time is zero if they already touch.
+     */
+    template<typename ShapeA, typename ShapeB>
+    [[nodiscard]] ShapeCastHit ShapeCast(const ShapeA& shapeA, const ShapeB& shapeB,
+                                         const Math::Vec2F translation) noexcept
+    {
+        // The shape A at the time t touches B when the ray point x = -t * translation is in A - B.
+        const auto ray = -translation;
+
+        ShapeCastHit hit;
+        float time = 0.f;
+        Math::Vec2F rayPoint = Math::Vec2F::Zero();
+        Math::Vec2F normal = Math::Vec2F::Zero();
+
+        std::array<Math::Vec2F, 3> points{};
+        int count = 0;
+
+        auto closest = rayPoint - (Center(shapeA) - Center(shapeB));
+
+        for (int i = 0; i < MaxGjkIterationCount && closest.SquareLength() > ShapeCastTolerance * ShapeCastTolerance;
+             i++)
+        {
+            // The direction is given normalized since the support of a circle ignores the too short directions.
+            const auto point = MinkowskiSupport(shapeA, shapeB, closest / closest.Length());
+            const auto toRayPoint = rayPoint - point;
+
+            // The plane of the support point separates the ray point from A - B, so the ray advances to it.
+            if (closest.Dot(toRayPoint) > 0.f)
+            {
+                if (closest.Dot(ray) >= 0.f) return hit;
+
+                time -= closest.Dot(toRayPoint) / closest.Dot(ray);
+
+                if (time > 1.f) return hit;
+
+                rayPoint = ray * time;
+                normal = closest;
+            }
+
+            if (count < 3) points[count++] = point;
+
+            closest = ClosestPointOnRay(points, count, rayPoint);
+        }
+
+        hit.Hit = true;
+        hit.Time = time;
+
+        // The closest point goes from A - B to the ray point, so its opposite goes from B to A. It is divided
+        // by its length instead of normalized because it can be shorter than the epsilon of Normalize.
+        const auto normalLength = normal.Length();
+        hit.Normal = normalLength > 0.f ? -normal / normalLength : Math::Vec2F::Zero();
+
+        return hit;
+    }
+}
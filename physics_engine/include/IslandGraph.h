@@ -0,0 +1,113 @@
+/**
+ * @headerfile IslandGraph.h
+ * This header file defines the IslandGraph class which groups the dynamic bodies that touch each other, directly
+ * or through other dynamic bodies, in simulation islands.
+ *
+ * @author Olivier Pachoud
+ */
+
+#pragma once
+
+#include "Allocator.h"
+#include "Body.h"
+
+#include <limits>
+
+namespace PhysicsEngine
+{
+    /**
+     * @brief Island is a struct that gives the range of the bodies of an island in the island bodies of the graph.
+     */
+    struct Island
+    {
+        std::size_t BodyBegin = 0;
+        std::size_t BodyCount = 0;
+    };
+
+    /**
+     * @brief IslandGraph is a class that builds the islands of the contact graph with a union-find on the body
+     * indices. The static and kinematic bodies are not part of any island, so that the bodies that only touch
+     * through them are in separate islands.
+     */
+    class IslandGraph
+    {
+    private:
+        /**
+         * @brief Parents are the parent body of each body in the union-find, a body being the root of its set
+         * when it is its own parent.
+         */
+        AllocVector<std::size_t> _parents;
+
+        /**
+         * @brief BodyIslands are the index of the island of each body, NoIsland for the bodies in none.
+         */
+        AllocVector<std::size_t> _bodyIslands;
+
+        /**
+         * @brief IslandBodies are the indices of the bodies grouped by island.
+         */
+        AllocVector<std::size_t> _islandBodies;
+
+        AllocVector<Island> _islands;
+
+        /**
+         * @brief Find is a method that gives the root of the set of the body given in parameter, halving the
+         * path to it on the way.
+         */
+        [[nodiscard]] std::size_t find(std::size_t bodyIdx) noexcept;
+
+    public:
+        static constexpr std::size_t NoIsland = std::numeric_limits<std::size_t>::max();
+
+        explicit IslandGraph(Allocator& allocator) noexcept;
+
+        /**
+         * @brief Reset is a method that puts each body in its own set, before the contacts are linked.
+         * @param bodyCount The number of bodies of the world.
+         */
+        void Reset(std::size_t bodyCount) noexcept;
+
+        /**
+         * @brief Link is a method that merges the sets of two bodies in contact.
+         * @note The pairs with a body that is not dynamic must not be linked.
+         * @param bodyIdxA The index of the body A.
+         * @param bodyIdxB The index of the body B.
+         */
+        void Link(std::size_t bodyIdxA, std::size_t bodyIdxB) noexcept;
+
+        /**
+         * @brief Build is a method that creates one island per set of valid dynamic bodies, the bodies of an
+         * island being in increasing index order.
+         * @param bodies The bodies of the world.
+         */
+        void Build(const AllocVector<Body>& bodies) noexcept;
+
+        /**
+         * @brief Clear is a method that removes all the islands and the sets.
+         */
+        void Clear() noexcept;
+
+        [[nodiscard]] const AllocVector<Island>& Islands() const noexcept { return _islands; }
+
+        /**
+         * @brief IslandBody is a method that gives the index of a body of an island.
+         * @param island The island.
+         * @param i The index of the body in the island.
+         * @return The index of the body in the world.
+         */
+        [[nodiscard]] std::size_t IslandBody(const Island& island, const std::size_t i) const noexcept
+        {
+            return _islandBodies[island.BodyBegin + i];
+        }
+
+        /**
+         * @brief IslandOf is a method that gives the island of the body given in parameter.
+         * @param bodyIdx The index of the body.
+         * @return The index of the island of the body, NoIsland if it is not dynamic.
+         */
+        [[nodiscard]] std::size_t IslandOf(const std::size_t bodyIdx) const noexcept
+        {
+            return bodyIdx < _bodyIslands.size() ? _bodyIslands[bodyIdx] : NoIsland;
+        }
+    };
+}
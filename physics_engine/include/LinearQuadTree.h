@@ -0,0 +1,223 @@
+/**
+ * @headerfile LinearQuadTree.h
+ * This header file defines the LinearQuadTree class which is a quad-tree broad phase stored as an array of
+ * colliders sorted in the Morton order of their nodes instead of a tree of nodes linked by pointers.
+ *
+ * @author Olivier Pachoud
+ */
+
+#pragma once
+
+#include "Allocator.h"
+#include "BroadPhase.h"
+#include "JobSystem.h"
+
+#include <cstdint>
+
+namespace PhysicsEngine
+{
+    /**
+     * @brief MortonCode is a function that interleaves the bits of the two coordinates given in parameter
+     * (aka the bit i of x goes to the bit 2i and the bit i of y to the bit 2i + 1), so that the cells of
+     * a quad-tree node have consecutive codes.
+     * @param x The x coordinate, only its 16 low bits are used.
+     * @param y The y coordinate, only its 16 low bits are used.
+     * @return The Morton code of the coordinates.
+     */
+    [[nodiscard]] constexpr std::uint32_t MortonCode(const std::uint32_t x, const std::uint32_t y) noexcept
+    {
+        const auto spread = [](std::uint32_t value)
+        {
+            value &= 0x0000ffffu;
+            value = (value | (value << 8)) & 0x00ff00ffu;
+            value = (value | (value << 4)) & 0x0f0f0f0fu;
+            value = (value | (value << 2)) & 0x33333333u;
+            value = (value | (value << 1)) & 0x55555555u;
+
+            return value;
+        };
+
+        return spread(x) | spread(y) << 1;
+    }
+
+    /**
+     * @brief MortonEntry is a struct that stores the key of the node of a collider (aka the Morton code of the
+     * node followed by its depth) with the index of the collider in the colliders given to the update.
+     */
+    struct MortonEntry
+    {
+        std::uint32_t Key = 0;
+        std::uint32_t ColliderIdx = 0;
+    };
+
+    /**
+     * @brief LinearNode is a struct that gives the range of the entries of a node of the linear quad-tree.
+     */
+    struct LinearNode
+    {
+        std::uint32_t Key = 0;
+        std::size_t EntryBegin = 0;
+        std::size_t EntryEnd = 0;
+    };
+
+    /**
+     * @brief LinearQuadTree is a class that represents a quad-tree rebuilt each step without any node allocation.
+     * @note Each collider goes in the deepest node that contains its simplified shape, found from the cells of
+     * its corners in the grid of the deepest level. The colliders are radix sorted by the key of their node, which
+     * gives the nodes in depth-first order with the colliders of a node next to each other. The possible pairs
+     * are found by a single sweep over the nodes that keeps the stack of the ancestors of the current node.
+     */
+    class LinearQuadTree final : public BroadPhase
+    {
+    private:
+        HeapAllocator _heapAllocator;
+
+        AllocVector<MortonEntry> _entries{ StandardAllocator<MortonEntry> {_heapAllocator} };
+
+        /**
+         * @brief SortedEntries is the buffer in which each pass of the radix sort writes the entries, swapped
+         * with the entries after the pass.
+         */
+        AllocVector<MortonEntry> _sortedEntries{ StandardAllocator<MortonEntry> {_heapAllocator} };
+
+        /**
+         * @brief DigitCounts are the number of entries of each chunk for each digit value of the current pass
+         * of the radix sort, then the offset of the first entry of the chunk for each digit value.
+         */
+        AllocVector<std::size_t> _digitCounts{ StandardAllocator<std::size_t> {_heapAllocator} };
+
+        AllocVector<LinearNode> _nodes{ StandardAllocator<LinearNode> {_heapAllocator} };
+
+        /**
+         * @brief AncestorNodes is the stack of the indices of the ancestors of the current node of the sweep.
+         */
+        AllocVector<std::size_t> _ancestorNodes{ StandardAllocator<std::size_t> {_heapAllocator} };
+
+        AllocVector<ColliderPair> _possiblePairs{ StandardAllocator<ColliderPair> {_heapAllocator} };
+
+        /**
+         * @brief JobSystem is the job system used to calculate the keys and to radix sort them in parallel, they
+         * are calculated on the calling thread if it is nullptr.
+         */
+        JobSystem* _jobSystem = nullptr;
+
+        /**
+         * @brief MaxDepth is the depth of the deepest nodes, whose grid has 2^MaxDepth cells on each axis.
+         */
+        static constexpr int _maxDepth = 9;
+
+        /**
+         * @brief DepthBitCount is the number of low bits of a key used by the depth of its node.
+         */
+        static constexpr int _depthBitCount = 4;
+
+        /**
+         * @brief RadixBitCount is the number of bits of a key sorted by each pass of the radix sort.
+         */
+        static constexpr int _radixBitCount = 8;
+        static constexpr std::size_t _radixDigitCount = std::size_t{1} << _radixBitCount;
+
+        /**
+         * @brief RadixPassCount is the number of passes of the radix sort needed to sort all the bits of a key.
+         */
+        static constexpr int _radixPassCount = (2 * _maxDepth + _depthBitCount + _radixBitCount - 1) / _radixBitCount;
+
+        /**
+         * @brief ParallelSortMinColliderCount is the number of colliders under which the keys are calculated and
+         * sorted on the calling thread even if there is a job system, because waking the workers would cost more.
+         */
+        static constexpr std::size_t _parallelSortMinColliderCount = 2048;
+
+        /**
+         * @brief SortChunkSize is the number of entries of each job of a parallel sort.
+         */
+        static constexpr std::size_t _sortChunkSize = 1024;
+
+        /**
+         * @brief calculateKeys is a method that calculates the key of the node of the colliders in the range
+         * given in parameter.
+         * @param colliders The simplified colliders.
+         * @param begin The index of the first collider.
+         * @param end The index after the last collider.
+         * @param rootMin The minimum bound of the root node.
+         * @param cellsPerMeter The number of cells of the deepest level per meter on each axis.
+         */
+        void calculateKeys(const AllocVector<SimplifiedCollider>& colliders, std::size_t begin, std::size_t end,
+                           Math::Vec2F rootMin, Math::Vec2F cellsPerMeter) noexcept;
+
+        /**
+         * @brief sortEntries is a method that sorts the entries by key with a least significant digit radix sort,
+         * which keeps the entries with the same key in the order of the colliders.
+         * @param chunkCount The number of chunks of the entries sorted at the same time, 1 to sort them on the
+         * calling thread.
+         */
+        void sortEntries(std::size_t chunkCount) noexcept;
+
+        /**
+         * @brief calculatePossiblePairs is a method that groups the sorted entries in nodes and compares the
+         * colliders of each node with the ones of the same node and of its ancestors.
+         * @param colliders The simplified colliders.
+         */
+        void calculatePossiblePairs(const AllocVector<SimplifiedCollider>& colliders) noexcept;
+
+    public:
+        LinearQuadTree() noexcept = default;
+
+        /**
+         * @brief Init is a method that pre-allocates the digit counts of the radix sort.
+         */
+        void Init() noexcept override;
+
+        /**
+         * @brief Update is a method that sorts the colliders given in parameter by node, with a root node fitted
+         * to their simplified shapes, and calculates their possible pairs.
+         * @param colliders The simplified enabled colliders of the world.
+         */
+        void Update(const AllocVector<SimplifiedCollider>& colliders) noexcept override;
+
+        /**
+         * @brief PossiblePairs is a method that gives the possible pairs of collider whose simplified shapes
+         * touch each other.
+         * @return The possible pairs of collider whose simplified shapes touch each other.
+         */
+        [[nodiscard]] const AllocVector<ColliderPair>& PossiblePairs() const noexcept override
+        {
+            return _possiblePairs;
+        }
+
+        /**
+         * @brief Clear is a method that removes all the entries, nodes and possible pairs.
+         */
+        void Clear() noexcept override;
+
+        /**
+         * @brief Deinit is a method that deinitialize the linear quad-tree by removing all data from it.
+         */
+        void Deinit() noexcept override;
+
+        /**
+         * @brief SetJobSystem is a method that sets the job system used to calculate and sort the keys of the
+         * colliders in parallel.
+         * @param jobSystem The job system, nullptr to sort the keys on the calling thread.
+         */
+        void SetJobSystem(JobSystem* jobSystem) noexcept { _jobSystem = jobSystem; }
+
+        /**
+         * @brief MaxDepth is a method that gives the depth of the deepest nodes of the linear quad-tree.
+         * @return The maximum depth of the linear quad-tree.
+         */
+        [[nodiscard]] static constexpr int MaxDepth() noexcept { return _maxDepth; }
+
+        /**
+         * @brief Entries is a method that gives the entries of the colliders of the last update, sorted by key.
+         * @return The sorted entries.
+         */
+        [[nodiscard]] const AllocVector<MortonEntry>& Entries() const noexcept { return _entries; }
+
+        /**
+         * @brief NodeCount is a method that gives the number of nodes containing colliders of the last update.
+         * @return The number of non-empty nodes.
+         */
+        [[nodiscard]] std::size_t NodeCount() const noexcept { return _nodes.size(); }
+    };
+}
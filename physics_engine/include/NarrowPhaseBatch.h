@@ -0,0 +1,142 @@
+/**
+ * @headerfile NarrowPhaseBatch.h
+ * This file defines the NarrowPhaseBatch class which groups the possible pairs of the narrow phase by shape
+ * types to test them with batched kernels.
+ *
+ * @author Olivier Pachoud
+ */
+
+#pragma once
+
+#include "Allocator.h"
+#include "Collider.h"
+#include "ShapePairDispatch.h"
+#include "SimdLevel.h"
+
+#include <cstdint>
+
+namespace PhysicsEngine
+{
+    /**
+     * @brief NarrowPhaseMode is an enumeration that represents how the narrow phase tests the possible pairs:
+     * PerPair (each pair is dispatched to the kernel of its shape types) or Batched (the pairs are grouped by
+     * shape types and the circle-circle and rectangle-rectangle pairs are tested 4 or 8 at a time).
+     */
+    enum class NarrowPhaseMode
+    {
+        PerPair,
+        Batched
+    };
+
+    /**
+     * @brief NarrowPhaseBatch is a class that groups the possible pairs of colliders by shape types.
+     * The world-space circles and rectangles of the circle-circle and rectangle-rectangle pairs are stored
+     * in separate contiguous arrays so that they are tested with SIMD kernels, the other pairs are stored
+     * in one bucket per pair of shape types.
+     */
+    class NarrowPhaseBatch
+    {
+    private:
+        AllocVector<float> _circleCentersAX;
+        AllocVector<float> _circleCentersAY;
+        AllocVector<float> _circleCentersBX;
+        AllocVector<float> _circleCentersBY;
+        AllocVector<float> _radiusSums;
+        AllocVector<ColliderPair> _circlePairs;
+
+        AllocVector<float> _rectMinBoundsAX;
+        AllocVector<float> _rectMinBoundsAY;
+        AllocVector<float> _rectMaxBoundsAX;
+        AllocVector<float> _rectMaxBoundsAY;
+        AllocVector<float> _rectMinBoundsBX;
+        AllocVector<float> _rectMinBoundsBY;
+        AllocVector<float> _rectMaxBoundsBX;
+        AllocVector<float> _rectMaxBoundsBY;
+        AllocVector<ColliderPair> _rectanglePairs;
+
+        /**
+         * @brief Overlaps is the result of the last kernel, 1 for each pair that overlaps and 0 otherwise.
+         */
+        AllocVector<std::uint8_t> _overlaps;
+
+        /**
+         * @brief PairBuckets are the pairs that are not tested by a SIMD kernel, indexed by
+         * shape type A * WorldShapeTypeCount + shape type B.
+         */
+        AllocVector<AllocVector<ColliderPair>> _pairBuckets;
+
+    public:
+        explicit NarrowPhaseBatch(Allocator& allocator) noexcept;
+
+        /**
+         * @brief Reserve is a method that pre-allocates the arrays and the buckets for the given number of pairs,
+         * so that no allocation is done while adding them.
+         * @param pairCount The number of pairs to pre-allocate.
+         */
+        void Reserve(std::size_t pairCount) noexcept;
+
+        /**
+         * @brief AddCircles is a method that adds a circle-circle pair to the batch.
+         * @param pair The pair of colliders.
+         * @param circleA The world-space circle of the collider A.
+         * @param circleB The world-space circle of the collider B.
+         */
+        void AddCircles(const ColliderPair& pair, Math::CircleF circleA, Math::CircleF circleB) noexcept;
+
+        /**
+         * @brief AddRectangles is a method that adds a rectangle-rectangle pair to the batch.
+         * @param pair The pair of colliders.
+         * @param rectA The world-space rectangle of the collider A.
+         * @param rectB The world-space rectangle of the collider B.
+         */
+        void AddRectangles(const ColliderPair& pair, Math::RectangleF rectA, Math::RectangleF rectB) noexcept;
+
+        /**
+         * @brief AddPair is a method that adds a pair of other shape types to the bucket of its shape types.
+         * @param typeA The shape type of the collider A.
+         * @param typeB The shape type of the collider B.
+         * @param pair The pair of colliders.
+         */
+        void AddPair(Math::ShapeType typeA, Math::ShapeType typeB, const ColliderPair& pair) noexcept
+        {
+            _pairBuckets[static_cast<std::size_t>(typeA) * WorldShapeTypeCount + static_cast<std::size_t>(typeB)]
+                .push_back(pair);
+        }
+
+        /**
+         * @brief Run is a method that tests the circle-circle and the rectangle-rectangle pairs of the batch and
+         * adds the ones that overlap to the output pairs.
+         * @note The SIMD kernels test 4 or 8 pairs per step and the remaining pairs with the scalar kernel.
+         * @param kernel The instruction set to use (see SimdLevel).
+         * @param overlappingPairs The output pairs.
+         */
+        void Run(SimdLevel kernel, AllocVector<ColliderPair>& overlappingPairs) noexcept;
+
+        /**
+         * @brief PairBucket is a method that gives the pairs of the bucket at the index given in parameter.
+         * @param bucketIdx The index of the bucket (aka shape type A * WorldShapeTypeCount + shape type B).
+         * @return The pairs of the bucket.
+         */
+        [[nodiscard]] const AllocVector<ColliderPair>& PairBucket(const std::size_t bucketIdx) const noexcept
+        {
+            return _pairBuckets[bucketIdx];
+        }
+
+        /**
+         * @brief Clear is a method that removes all the pairs of the batch.
+         */
+        void Clear() noexcept;
+
+        /**
+         * @brief CircleCount is a method that gives the number of circle-circle pairs of the batch.
+         * @return The number of circle-circle pairs.
+         */
+        [[nodiscard]] std::size_t CircleCount() const noexcept { return _circlePairs.size(); }
+
+        /**
+         * @brief RectangleCount is a method that gives the number of rectangle-rectangle pairs of the batch.
+         * @return The number of rectangle-rectangle pairs.
+         */
+        [[nodiscard]] std::size_t RectangleCount() const noexcept { return _rectanglePairs.size(); }
+    };
+}
@@ -9,21 +9,13 @@
 #pragma once
 
 #include "Allocator.h"
+#include "BroadPhase.h"
 #include "Collider.h"
+#include "JobSystem.h"
 #include "UniquePtr.h"
 
 namespace PhysicsEngine
 {
-    /**
-     * @brief SimplifiedCollider is a struct that stores the data of a collider in a simplified way (aka it stores
-     * its collider reference in the world and its shape in a rectangle form).
-     */
-    struct SimplifiedCollider
-    {
-        ColliderRef ColRef{0, 0};
-        Math::RectangleF Rectangle{Math::Vec2F::Zero(), Math::Vec2F::Zero()};
-    };
-
     /**
      * @brief QuadNode is a struct representing a node in a quad-tree data structure used for spatial 
      partitioning in a 2D space.
@@ -42,6 +34,13 @@ namespace PhysicsEngine
         static constexpr int BoundaryDivisionCount = 4;
 
         Math::RectangleF Boundary{Math::Vec2F::Zero(), Math::Vec2F::Zero()};
+
+        /**
+         * @brief LooseBoundary is the boundary of the node enlarged by the looseness of the quad-tree around its
+         * center, which contains all the colliders of the node and of its children. It is the same as the
+         * boundary when the quad-tree is not loose and it is not used for the root node.
+         */
+        Math::RectangleF LooseBoundary{Math::Vec2F::Zero(), Math::Vec2F::Zero()};
         std::array<QuadNode*, BoundaryDivisionCount> Children{ nullptr, nullptr, nullptr, nullptr };
         AllocVector<SimplifiedCollider> Colliders{};
 
@@ -49,10 +48,32 @@ namespace PhysicsEngine
             Colliders{ StandardAllocator<SimplifiedCollider> {allocator} } {}
     };
 
+    /**
+     * @brief QuadProxy is a struct that stores the state of a collider in the persistent mode of the quad-tree:
+     * its fat rectangle (aka its simplified shape enlarged by a margin) and the node in which it is stored.
+     */
+    struct QuadProxy
+    {
+        ColliderRef ColRef{0, 0};
+        Math::RectangleF FatRectangle{Math::Vec2F::Zero(), Math::Vec2F::Zero()};
+        QuadNode* Node = nullptr;
+        bool Enabled = false;
+        bool Moved = false;
+        bool Updated = false;
+    };
+
     /**
      * @brief QuadTree is a class that represents a quad-tree used for spatial partitioning of the world space.
+     * @note The quad-tree can be used in two ways: it is either cleared and rebuilt each step with Insert and
+     * CalculatePossiblePairs, or it is kept between the steps with UpdateProxy, RemoveProxy and
+     * UpdatePossiblePairs (aka the persistent mode), in which case a collider is only reinserted when its
+     * simplified shape leaves its fat rectangle. Update uses one or the other according to IsPersistent.
+     * @note When the looseness is greater than 1 (aka the loose mode), a collider goes in the child that contains
+     * its center as long as the loose boundary of this child contains it, so the colliders that straddle the
+     * boundaries of the children sink in the tree instead of staying in the parent node. The loose boundaries
+     * of siblings overlap, so the possible pairs of each collider are then found by querying the tree.
      */
-    class QuadTree
+    class QuadTree final : public BroadPhase
     {
     private:
         HeapAllocator _heapAllocator;
@@ -60,8 +81,70 @@ namespace PhysicsEngine
         AllocVector<QuadNode> _nodes{ StandardAllocator<QuadNode> {_heapAllocator} };
         AllocVector<ColliderPair> _possiblePairs{ StandardAllocator<ColliderPair> {_heapAllocator} };
 
+        AllocVector<QuadProxy> _proxies{ StandardAllocator<QuadProxy> {_heapAllocator} };
+        AllocVector<std::size_t> _movedProxies{ StandardAllocator<std::size_t> {_heapAllocator} };
+
         int _nodeIndex = 1;
 
+        /**
+         * @brief JobSystem is the job system used to build the four subtrees of the root node in parallel when
+         * the quad-tree is rebuilt each step, the quad-tree is built on the calling thread if it is nullptr.
+         */
+        JobSystem* _jobSystem = nullptr;
+
+        /**
+         * @brief QuadrantColliders are the colliders binned in each child of the root node by a parallel build.
+         */
+        AllocVector<AllocVector<SimplifiedCollider>> _quadrantColliders{
+            StandardAllocator<AllocVector<SimplifiedCollider>> {_heapAllocator} };
+
+        /**
+         * @brief SubtreePairs are the possible pairs found in each subtree of the root node by a parallel build
+         * (the last one is for the pairs of the colliders of the root node), merged in this order.
+         */
+        AllocVector<AllocVector<ColliderPair>> _subtreePairs{
+            StandardAllocator<AllocVector<ColliderPair>> {_heapAllocator} };
+
+        /**
+         * @brief FatMargin is the margin added on each side of the simplified shape of a collider to get
+         * its fat rectangle in the persistent mode.
+         */
+        float _fatMargin = 0.1f;
+
+        /**
+         * @brief NeedsRebuild is true when the persistent quad-tree must be rebuilt from scratch, either because
+         * it has never been built or because a fat rectangle left the root node boundary.
+         */
+        bool _needsRebuild = true;
+
+        /**
+         * @brief HasRemovedProxies is true when a proxy has been removed since the last update of the pairs.
+         */
+        bool _hasRemovedProxies = false;
+
+        /**
+         * @brief IsPersistent is true when Update keeps the quad-tree between the steps instead of rebuilding it.
+         */
+        bool _isPersistent = false;
+
+        /**
+         * @brief Looseness is the factor by which the boundaries of the children are enlarged around their center
+         * to get their loose boundaries, 1 to use the boundaries themselves (aka a tight quad-tree).
+         */
+        float _looseness = 1.f;
+
+        /**
+         * @brief PairTestCount is the number of tests between two simplified shapes done by the last calculation
+         * of the possible pairs.
+         */
+        std::size_t _pairTestCount = 0;
+
+        /**
+         * @brief SubtreePairTestCounts are the number of tests between two simplified shapes done for each output
+         * of the subtree pairs by a parallel build.
+         */
+        std::array<std::size_t, QuadNode::BoundaryDivisionCount + 1> _subtreePairTestCounts{};
+
         /**
          * @brief MaxDepth is the maximum depth of the quad-tree recursive space subdivision.
          */
@@ -74,6 +157,19 @@ namespace PhysicsEngine
          */
         static constexpr float _possiblePairReserveFactor = 3.f;
 
+        /**
+         * @brief RootMarginFactor is the factor of the size of the colliders' bounds added on each side of the
+         * root node boundary when the persistent quad-tree is rebuilt, so that it is not rebuilt each time
+         * a collider moves a bit outside of the current bounds.
+         */
+        static constexpr float _rootMarginFactor = 0.25f;
+
+        /**
+         * @brief ParallelBuildMinColliderCount is the number of colliders under which the quad-tree is built
+         * on the calling thread even if there is a job system, because waking the workers would cost more.
+         */
+        static constexpr std::size_t _parallelBuildMinColliderCount = 256;
+
         /**
          * @brief insertInNode is a method that insert a collider in the node given in parameter
          * (in its simplified shape) in the given node in parameter.
@@ -81,25 +177,135 @@ namespace PhysicsEngine
          * @param simplifiedShape The simplified shape of the collider (aka its shape in rectangle).
          * @param colliderRef The collider reference in the world.
          * @param depth The depth in which the node is.
+         * @param nodeIndex The index of the next free node, incremented when the node is subdivided.
          */
         void insertInNode(QuadNode& node,
                           Math::RectangleF simplifiedShape,
                           ColliderRef colliderRef,
-                          int depth) noexcept;
+                          int depth,
+                          int& nodeIndex) noexcept;
 
         /**
-         * @brief calculateNodePossiblePairs is a method that calculates the possible pair of collider
-         * in the node given in parameter.
-         * @param node
+         * @brief subdivide is a method that gives four children to the node given in parameter.
+         * @param node The node to subdivide.
+         * @param nodeIndex The index of the first free node, incremented by the number of children.
+         */
+        void subdivide(QuadNode& node, int& nodeIndex) noexcept;
+
+        /**
+         * @brief childToInsertIn is a method that gives the child of the node given in parameter in which
+         * a collider must go down.
+         * @note A tight quad-tree gives the only child touched by the simplified shape, a loose one the child
+         * that contains its center if the loose boundary of this child contains it.
+         * @param node The node, which must have children.
+         * @param simplifiedShape The simplified shape of the collider (aka its shape in rectangle).
+         * @return The child in which the collider must go down, nullptr if it must stay in the node.
          */
-        void calculateNodePossiblePairs(const QuadNode& node) noexcept;
+        [[nodiscard]] QuadNode* childToInsertIn(const QuadNode& node, Math::RectangleF simplifiedShape) const noexcept;
 
         /**
          * @brief calculateNodePossiblePairs is a method that calculates the possible pair of collider
-         * in the node given in parameter.
-         * @param node
+         * in the node given in parameter and its children.
+         * @param node The node.
+         * @param possiblePairs The possible pairs in which the pairs are added.
+         * @param pairTestCount The number of tests between two simplified shapes, incremented by each test.
+         */
+        void calculateNodePossiblePairs(const QuadNode& node,
+                                        AllocVector<ColliderPair>& possiblePairs,
+                                        std::size_t& pairTestCount) noexcept;
+
+        /**
+         * @brief calculateChildrenNodePossiblePairs is a method that calculates the possible pairs between
+         * the simplified collider of a parent node and the colliders of the node given in parameter and
+         * its children.
+         * @param node The node.
+         * @param simplCol The simplified collider of the parent node.
+         * @param possiblePairs The possible pairs in which the pairs are added.
+         * @param pairTestCount The number of tests between two simplified shapes, incremented by each test.
+         */
+        void calculateChildrenNodePossiblePairs(const QuadNode& node,
+                                                SimplifiedCollider simplCol,
+                                                AllocVector<ColliderPair>& possiblePairs,
+                                                std::size_t& pairTestCount) noexcept;
+
+        /**
+         * @brief calculateLooseNodePossiblePairs is a method that calculates the possible pairs of the colliders
+         * of the node given in parameter and its children in the loose mode, by querying the whole quad-tree
+         * with each of them.
+         * @param node The node.
+         * @param possiblePairs The possible pairs in which the pairs are added.
+         * @param pairTestCount The number of tests between two simplified shapes, incremented by each test.
+         */
+        void calculateLooseNodePossiblePairs(const QuadNode& node,
+                                             AllocVector<ColliderPair>& possiblePairs,
+                                             std::size_t& pairTestCount) const noexcept;
+
+        /**
+         * @brief queryLooseNodePossiblePairs is a method that adds the possible pairs between the simplified
+         * collider given in parameter and the colliders of the node and of its children whose loose boundary
+         * touches it.
+         * @note A pair is only added by the collider with the lowest reference, so that it is added once.
+         * @param node The node to query.
+         * @param simplCol The simplified collider.
+         * @param possiblePairs The possible pairs in which the pairs are added.
+         * @param pairTestCount The number of tests between two simplified shapes, incremented by each test.
          */
-        void calculateChildrenNodePossiblePairs(const QuadNode& node, SimplifiedCollider simplCol) noexcept;
+        void queryLooseNodePossiblePairs(const QuadNode& node,
+                                         SimplifiedCollider simplCol,
+                                         AllocVector<ColliderPair>& possiblePairs,
+                                         std::size_t& pairTestCount) const noexcept;
+
+        /**
+         * @brief buildInParallel is a method that subdivides the root node, bins the colliders given in parameter
+         * in its children and builds the four subtrees and their possible pairs on the job system.
+         * @note Each subtree takes its nodes in its own range of nodes, so the subtrees never share a node.
+         * @param colliders The simplified colliders to insert.
+         */
+        void buildInParallel(const AllocVector<SimplifiedCollider>& colliders) noexcept;
+
+        /**
+         * @brief addToNode is a method that adds the simplified collider given in parameter in the colliders of
+         * the node and keeps track of this node if the collider has a proxy.
+         * @param node The node in which the collider must be added.
+         * @param simplifiedCollider The simplified collider to add.
+         */
+        void addToNode(QuadNode& node, SimplifiedCollider simplifiedCollider) noexcept;
+
+        /**
+         * @brief removeFromNode is a method that removes the collider of the proxy given in parameter
+         * from the node in which it is stored.
+         * @param proxy The proxy of the collider to remove.
+         */
+        void removeFromNode(QuadProxy& proxy) noexcept;
+
+        /**
+         * @brief markMoved is a method that marks the proxy at the index given in parameter as moved so that
+         * its pairs are recalculated at the next UpdatePossiblePairs.
+         * @param proxyIndex The index of the proxy (aka the index of its collider in the world).
+         */
+        void markMoved(std::size_t proxyIndex) noexcept;
+
+        /**
+         * @brief isProxyStale is a method that checks if the pairs of the collider given in parameter must be
+         * recalculated (aka if its proxy has moved, has been removed or belongs to another collider).
+         * @param colliderRef The collider reference in the world.
+         * @return True if the pairs of the collider must be recalculated.
+         */
+        [[nodiscard]] bool isProxyStale(ColliderRef colliderRef) const noexcept;
+
+        /**
+         * @brief rebuild is a method that clears the nodes, fits the root node boundary to the fat rectangles
+         * of the enabled proxies, reinserts them and recalculates all the possible pairs.
+         */
+        void rebuild() noexcept;
+
+        /**
+         * @brief queryNodePossiblePairs is a method that adds the possible pairs between the moved proxy given
+         * in parameter and the colliders of the node and its children.
+         * @param node The node to query.
+         * @param proxy The moved proxy.
+         */
+        void queryNodePossiblePairs(const QuadNode& node, const QuadProxy& proxy) noexcept;
 
     public:
         QuadTree() noexcept = default;
@@ -108,7 +314,7 @@ namespace PhysicsEngine
          * @brief Init is a method that initialize the quad-tree by allocating the needed amount of memory to
          * store the quad-nodes.
          */
-        void Init() noexcept;
+        void Init() noexcept override;
 
         /**
          * @brief Insert is a method that insert a collider (in its simplified shape) in the quad-tree from its
@@ -124,15 +330,49 @@ namespace PhysicsEngine
          */
         void CalculatePossiblePairs() noexcept;
 
+        /**
+         * @brief Update is a method that calculates the possible pairs of the colliders given in parameter.
+         * In the persistent mode the proxies of the colliders are updated and the proxies of the colliders that
+         * are not given anymore are removed, otherwise the quad-tree is rebuilt from scratch with a root node
+         * fitted to the centers of the colliders.
+         * @param colliders The simplified enabled colliders of the world.
+         */
+        void Update(const AllocVector<SimplifiedCollider>& colliders) noexcept override;
+
+        /**
+         * @brief UpdateProxy is a method that creates or updates the proxy of a collider in the persistent mode.
+         * The collider is only reinserted in the quad-tree if its simplified shape left its fat rectangle.
+         * @param simplifiedShape The simplified shape of the collider (aka its shape in rectangle).
+         * @param colliderRef The collider reference in the world.
+         */
+        void UpdateProxy(Math::RectangleF simplifiedShape, ColliderRef colliderRef) noexcept;
+
+        /**
+         * @brief RemoveProxy is a method that removes the proxy of a collider in the persistent mode.
+         * @note Nothing happens if the collider has no proxy.
+         * @param colliderRef The collider reference in the world.
+         */
+        void RemoveProxy(ColliderRef colliderRef) noexcept;
+
+        /**
+         * @brief UpdatePossiblePairs is a method that updates the possible pairs in the persistent mode:
+         * the pairs of the moved and removed proxies are removed and the moved proxies are compared with the
+         * colliders of the quad-tree to find their new pairs.
+         * @note The possible pairs are calculated with the fat rectangles, so they can contain pairs whose
+         * simplified shapes don't touch each other.
+         */
+        void UpdatePossiblePairs() noexcept;
+
         /**
          * @brief Clear is a method that removes all colliders from each node and removes possible pairs.
+         * @note The proxies of the persistent mode are removed too.
          */
-        void Clear() noexcept;
+        void Clear() noexcept override;
 
         /**
          * @brief Deinit is a method that deinitialize the quad-tree by removing all data from it.
          */
-        void Deinit() noexcept;
+        void Deinit() noexcept override;
 
         /**
          * @brief RootNode is a method that gives the root node of the quad-tree (aka its first node).
@@ -155,12 +395,78 @@ namespace PhysicsEngine
          * touch each other.
          * @return The possible pairs of collider whose simplified shapes touch each other.
          */
-        [[nodiscard]] const AllocVector<ColliderPair>& PossiblePairs() const noexcept { return _possiblePairs; }
+        [[nodiscard]] const AllocVector<ColliderPair>& PossiblePairs() const noexcept override
+        {
+            return _possiblePairs;
+        }
 
         /**
          * @brief MaxDepth is a method that gives the maximum depth of the quad-tree recursive space subdivision.
          * @return The maximum depth of the quad-tree recursive space subdivision.
          */
         [[nodiscard]] static constexpr int MaxDepth() noexcept { return _maxDepth; }
+
+        /**
+         * @brief IsPersistent is a method that checks if the quad-tree is kept between the steps by Update.
+         * @return True if the quad-tree is persistent.
+         */
+        [[nodiscard]] bool IsPersistent() const noexcept { return _isPersistent; }
+
+        /**
+         * @brief SetPersistent is a method that sets if the quad-tree is kept between the steps by Update.
+         * @note The quad-tree is cleared if the mode changes.
+         * @param isPersistent Whether the quad-tree is persistent or not.
+         */
+        void SetPersistent(bool isPersistent) noexcept;
+
+        /**
+         * @brief SetJobSystem is a method that sets the job system used to build the quad-tree in parallel
+         * when it is rebuilt each step (aka when it is not persistent).
+         * @param jobSystem The job system, nullptr to build the quad-tree on the calling thread.
+         */
+        void SetJobSystem(JobSystem* jobSystem) noexcept { _jobSystem = jobSystem; }
+
+        /**
+         * @brief FatMargin is a method that gives the margin added on each side of the simplified shape
+         * of a collider to get its fat rectangle in the persistent mode.
+         * @return The margin of the fat rectangles.
+         */
+        [[nodiscard]] float FatMargin() const noexcept { return _fatMargin; }
+
+        /**
+         * @brief SetFatMargin is a method that replaces the margin of the fat rectangles with the one given
+         * in parameter.
+         * @note The new margin is only applied to the colliders reinserted after the call.
+         * @param fatMargin The new margin of the fat rectangles.
+         */
+        void SetFatMargin(const float fatMargin) noexcept { _fatMargin = fatMargin; }
+
+        /**
+         * @brief Looseness is a method that gives the factor by which the boundaries of the children are
+         * enlarged to get their loose boundaries.
+         * @return The looseness of the quad-tree, 1 if it is tight.
+         */
+        [[nodiscard]] float Looseness() const noexcept { return _looseness; }
+
+        /**
+         * @brief IsLoose is a method that checks if the colliders go down in the loose boundaries of the children.
+         * @return True if the looseness is greater than 1.
+         */
+        [[nodiscard]] bool IsLoose() const noexcept { return _looseness > 1.f; }
+
+        /**
+         * @brief SetLooseness is a method that replaces the looseness of the quad-tree with the one given
+         * in parameter.
+         * @note The looseness is clamped to 1 (aka a tight quad-tree) and the quad-tree is cleared if it changes.
+         * @param looseness The new looseness, 2 lets each child hold colliders as large as itself.
+         */
+        void SetLooseness(float looseness) noexcept;
+
+        /**
+         * @brief PairTestCount is a method that gives the number of tests between two simplified shapes done by
+         * the last calculation of the possible pairs.
+         * @return The number of tests between two simplified shapes.
+         */
+        [[nodiscard]] std::size_t PairTestCount() const noexcept { return _pairTestCount; }
     };
 }
\ No newline at end of file
@@ -0,0 +1,431 @@
+/**
+ * @headerfile ShapePairDispatch.h
+ * This header file defines the kernels that test the overlap and calculate the contact manifold of each pair
+ * of shape types, and the tables used to dispatch a pair of colliders to its kernels.
+ *
+ * @author Olivier Pachoud
+ */
+
+#pragma once
+
+#include "Collider.h"
+#include "Gjk.h"
+#include "Shape.h"
+#include "Vec2.h"
+
+#include <algorithm>
+#include <array>
+#include <tuple>
+#include <utility>
+
+namespace PhysicsEngine
+{
+    /**
+     * @brief ShapeInstance is a struct that gives the shape of a collider and where it is in the world.
+     * @note The circles and rectangles are translated by the position when they are read. The vertices of
+     * a polygon are translated by the vertices offset instead, which is zero when they are already given
+     * in world space.
+     */
+    struct ShapeInstance
+    {
+        const ColliderShape* Shape = nullptr;
+        Math::Vec2F Position = Math::Vec2F::Zero();
+        Math::PolygonSpanF Vertices{nullptr, 0};
+        Math::Vec2F VerticesOffset = Math::Vec2F::Zero();
+    };
+
+    /**
+     * @brief MaxManifoldPointCount is the maximum number of points of a contact manifold, two for the contact
+     * between two sides of rectangles.
+     */
+    static constexpr int MaxManifoldPointCount = 2;
+
+    /**
+     * @brief ContactManifold is a struct that stores the normal (from the shape B to the shape A), the points and
+     * the penetration of a contact between two shapes. There are no points if the shapes are not in contact.
+     */
+    struct ContactManifold
+    {
+        Math::Vec2F Normal = Math::Vec2F::Zero();
+        std::array<Math::Vec2F, MaxManifoldPointCount> Points{};
+        int PointCount = 0;
+        float Penetration = 0.f;
+    };
+
+    /**
+     * @brief WorldShapeTypes are the world-space shape types given to the kernels, in the order of
+     * Math::ShapeType.
+     */
+    using WorldShapeTypes = std::tuple<Math::CircleF, Math::RectangleF, TranslatedPolygon>;
+
+    static constexpr std::size_t WorldShapeTypeCount = std::tuple_size_v<WorldShapeTypes>;
+
+    /**
+     * @brief ToWorldShape gives the shape of the shape instance in world space.
+     */
+    template<typename WorldShape>
+    [[nodiscard]] WorldShape ToWorldShape(const ShapeInstance& shapeInstance) noexcept;
+
+    template<>
+    [[nodiscard]] inline Math::CircleF ToWorldShape<Math::CircleF>(const ShapeInstance& shapeInstance) noexcept
+    {
+        return *std::get_if<Math::CircleF>(shapeInstance.Shape) + shapeInstance.Position;
+    }
+
+    template<>
+    [[nodiscard]] inline Math::RectangleF ToWorldShape<Math::RectangleF>(const ShapeInstance& shapeInstance) noexcept
+    {
+        return *std::get_if<Math::RectangleF>(shapeInstance.Shape) + shapeInstance.Position;
+    }
+
+    template<>
+    [[nodiscard]] inline TranslatedPolygon ToWorldShape<TranslatedPolygon>(const ShapeInstance& shapeInstance) noexcept
+    {
+        return TranslatedPolygon{shapeInstance.Vertices, shapeInstance.VerticesOffset};
+    }
+
+    /**
+     * @brief Overlap is the kernel that tests if two world-space shapes overlap. By default it uses GJK on the
+     * support functions of the two shapes (see Gjk.h), warm-started by the simplex cache of the pair if
+     * there is one. A specialization is only needed for a faster test.
+     * @note Only the pairs whose first shape type is lower or equal to the second one are used, the other
+     * pairs are given swapped.
+     */
+    template<typename ShapeA, typename ShapeB>
+    struct Overlap
+    {
+        [[nodiscard]] static bool Test(const ShapeA& shapeA, const ShapeB& shapeB, SimplexCache* cache) noexcept
+        {
+            if (!Math::Intersect(BoundingCircle(shapeA), BoundingCircle(shapeB))) return false;
+
+            Simplex simplex;
+
+            return GjkOverlap(shapeA, shapeB, simplex, cache);
+        }
+    };
+
+    /**
+     * @brief AnalyticOverlap is the overlap kernel of the pairs of shapes that have a Math::Intersect function.
+     */
+    template<typename ShapeA, typename ShapeB>
+    struct AnalyticOverlap
+    {
+        [[nodiscard]] static bool Test(const ShapeA& shapeA, const ShapeB& shapeB, SimplexCache*) noexcept
+        {
+            return Math::Intersect(shapeA, shapeB);
+        }
+    };
+
+    template<>
+    struct Overlap<Math::CircleF, Math::CircleF> : AnalyticOverlap<Math::CircleF, Math::CircleF> {};
+
+    template<>
+    struct Overlap<Math::CircleF, Math::RectangleF> : AnalyticOverlap<Math::CircleF, Math::RectangleF> {};
+
+    template<>
+    struct Overlap<Math::RectangleF, Math::RectangleF> : AnalyticOverlap<Math::RectangleF, Math::RectangleF> {};
+
+    /**
+     * @brief Manifold is the kernel that calculates the contact manifold of two overlapping world-space
+     * shapes. By default it uses GJK and EPA on the support functions of the two shapes (see Gjk.h), there is
+     * no contact (aka a null normal and penetration) if they don't overlap.
+     * @note Only the pairs whose first shape type is lower or equal to the second one are used, the other
+     * pairs are given swapped and their normal is inverted.
+     */
+    template<typename ShapeA, typename ShapeB>
+    struct Manifold
+    {
+        [[nodiscard]] static ContactManifold Calculate(const ShapeA& shapeA, const ShapeB& shapeB) noexcept
+        {
+            Simplex simplex;
+
+            if (!GjkOverlap(shapeA, shapeB, simplex)) return ContactManifold{};
+
+            const auto penetration = Epa(shapeA, shapeB, simplex);
+
+            // The penetration normal goes from A to B, the point is between the deepest points of both shapes.
+            const auto pointA = Support(shapeA, penetration.Normal);
+            const auto pointB = Support(shapeB, -penetration.Normal);
+
+            return ContactManifold{ -penetration.Normal, {(pointA + pointB) * 0.5f}, 1, penetration.Depth };
+        }
+    };
+
+    template<>
+    struct Manifold<Math::CircleF, Math::CircleF>
+    {
+        [[nodiscard]] static ContactManifold Calculate(const Math::CircleF& circleA,
+                                                       const Math::CircleF& circleB) noexcept
+        {
+            const auto cA = circleA.Center(), cB = circleB.Center();
+            const auto rA = circleA.Radius(), rB = circleB.Radius();
+
+            const auto delta = cA - cB;
+            const auto distance = delta.Length();
+
+            // Two circles with the same center are pushed apart along the y axis.
+            auto direction = delta;
+
+            if (distance <= Math::Epsilon)
+            {
+                direction = Math::Vec2F(0.f, 1.f);
+            }
+
+            const auto normal = direction.Normalized();
+
+            // The point is between the deepest points of both circles, so it doesn't depend on their order.
+            const auto point = ((cA - normal * rA) + (cB + normal * rB)) * 0.5f;
+
+            return ContactManifold{ normal, {point}, 1, rA + rB - distance };
+        }
+    };
+
+    template<>
+    struct Manifold<Math::CircleF, Math::RectangleF>
+    {
+        [[nodiscard]] static ContactManifold Calculate(const Math::CircleF& circleA,
+                                                       const Math::RectangleF& rectB) noexcept
+        {
+            const auto circleCenter = circleA.Center(), rectCenter = rectB.Center();
+            const auto rectHalfSize = rectB.HalfSize();
+
+            const auto delta = circleCenter - rectCenter;
+
+            Math::Vec2F closestPoint;
+
+            closestPoint.X = Math::Clamp(delta.X, -rectHalfSize.X, rectHalfSize.X);
+            closestPoint.Y = Math::Clamp(delta.Y, -rectHalfSize.Y, rectHalfSize.Y);
+
+            const auto distance = (closestPoint - delta).Length();
+            const auto closestPoinOnRect = rectCenter + closestPoint;
+
+            auto circleToRect = (circleCenter - closestPoinOnRect);
+
+            if (circleToRect.Length() <= Math::Epsilon)
+            {
+                circleToRect = Math::Vec2F(0.f, 1.f);
+            }
+
+            return ContactManifold{ circleToRect.Normalized(), {closestPoinOnRect}, 1,
+                                    circleA.Radius() - distance };
+        }
+    };
+
+    template<>
+    struct Manifold<Math::RectangleF, Math::RectangleF>
+    {
+        [[nodiscard]] static ContactManifold Calculate(const Math::RectangleF& rectA,
+                                                       const Math::RectangleF& rectB) noexcept
+        {
+            const auto cA = rectA.Center(), cB = rectB.Center();
+            const auto halfSizeA = rectA.HalfSize(), halfSizeB = rectB.HalfSize();
+
+            const auto delta = cA - cB;
+
+            ContactManifold manifold;
+
+            // Calculate the penetration in x-axis
+            const auto penetrationX = halfSizeA.X + halfSizeB.X - Math::Abs(delta.X);
+            // Calculate the penetration in y-axis
+            const auto penetrationY = halfSizeA.Y + halfSizeB.Y - Math::Abs(delta.Y);
+
+            // The points are the ends of the overlap of the two sides in contact, at the middle of the penetration.
+            const auto overlapMin = Math::Vec2F(std::max(rectA.MinBound().X, rectB.MinBound().X),
+                                                std::max(rectA.MinBound().Y, rectB.MinBound().Y));
+            const auto overlapMax = Math::Vec2F(std::min(rectA.MaxBound().X, rectB.MaxBound().X),
+                                                std::min(rectA.MaxBound().Y, rectB.MaxBound().Y));
+            const auto overlapCenter = (overlapMin + overlapMax) * 0.5f;
+
+            if (penetrationX < penetrationY)
+            {
+                manifold.Normal = delta.X > 0 ? Math::Vec2F::Right() : Math::Vec2F::Left();
+                manifold.Penetration = penetrationX;
+                manifold.Points[0] = Math::Vec2F(overlapCenter.X, overlapMin.Y);
+                manifold.Points[1] = Math::Vec2F(overlapCenter.X, overlapMax.Y);
+            }
+            else
+            {
+                manifold.Normal = delta.Y > 0 ? Math::Vec2F::Up() : Math::Vec2F::Down();
+                manifold.Penetration = penetrationY;
+                manifold.Points[0] = Math::Vec2F(overlapMin.X, overlapCenter.Y);
+                manifold.Points[1] = Math::Vec2F(overlapMax.X, overlapCenter.Y);
+            }
+
+            manifold.PointCount = manifold.Points[0] == manifold.Points[1] ? 1 : 2;
+
+            return manifold;
+        }
+    };
+
+    using OverlapFunction = bool (*)(const ShapeInstance&, const ShapeInstance&, SimplexCache*) noexcept;
+    using ManifoldFunction = ContactManifold (*)(const ShapeInstance&, const ShapeInstance&) noexcept;
+    using ShapeCastFunction = ShapeCastHit (*)(const ShapeInstance&, const ShapeInstance&, Math::Vec2F) noexcept;
+
+    /**
+     * @brief OverlapEntry is the entry of the overlap table for the shape types at the indices given
+     * in template parameter.
+     */
+    template<std::size_t IndexA, std::size_t IndexB>
+    [[nodiscard]] bool OverlapEntry(const ShapeInstance& shapeA, const ShapeInstance& shapeB,
+                                    SimplexCache* cache) noexcept
+    {
+        using ShapeA = std::tuple_element_t<IndexA, WorldShapeTypes>;
+        using ShapeB = std::tuple_element_t<IndexB, WorldShapeTypes>;
+
+        if constexpr (IndexA <= IndexB)
+        {
+            return Overlap<ShapeA, ShapeB>::Test(ToWorldShape<ShapeA>(shapeA), ToWorldShape<ShapeB>(shapeB),
+                                                 cache);
+        }
+        else
+        {
+            return Overlap<ShapeB, ShapeA>::Test(ToWorldShape<ShapeB>(shapeB), ToWorldShape<ShapeA>(shapeA),
+                                                 cache);
+        }
+    }
+
+    /**
+     * @brief ManifoldEntry is the entry of the manifold table for the shape types at the indices given
+     * in template parameter.
+     */
+    template<std::size_t IndexA, std::size_t IndexB>
+    [[nodiscard]] ContactManifold ManifoldEntry(const ShapeInstance& shapeA, const ShapeInstance& shapeB) noexcept
+    {
+        using ShapeA = std::tuple_element_t<IndexA, WorldShapeTypes>;
+        using ShapeB = std::tuple_element_t<IndexB, WorldShapeTypes>;
+
+        if constexpr (IndexA <= IndexB)
+        {
+            return Manifold<ShapeA, ShapeB>::Calculate(ToWorldShape<ShapeA>(shapeA), ToWorldShape<ShapeB>(shapeB));
+        }
+        else
+        {
+            // The normal of the swapped pair goes from A to B.
+            auto manifold = Manifold<ShapeB, ShapeA>::Calculate(ToWorldShape<ShapeB>(shapeB),
+                                                                ToWorldShape<ShapeA>(shapeA));
+            manifold.Normal = -manifold.Normal;
+
+            return manifold;
+        }
+    }
+
+    /**
+     * @brief ShapeCastEntry is the entry of the shape cast table for the shape types at the indices given
+     * in template parameter. The shape cast works on the support functions, so it doesn't need the pairs to
+     * be ordered.
+     */
+    template<std::size_t IndexA, std::size_t IndexB>
+    [[nodiscard]] ShapeCastHit ShapeCastEntry(const ShapeInstance& shapeA, const ShapeInstance& shapeB,
+                                              const Math::Vec2F translation) noexcept
+    {
+        using ShapeA = std::tuple_element_t<IndexA, WorldShapeTypes>;
+        using ShapeB = std::tuple_element_t<IndexB, WorldShapeTypes>;
+
+        return ShapeCast(ToWorldShape<ShapeA>(shapeA), ToWorldShape<ShapeB>(shapeB), translation);
+    }
+
+    template<std::size_t... Indices>
+    [[nodiscard]] constexpr std::array<OverlapFunction, sizeof...(Indices)> MakeOverlapTable(
+        std::index_sequence<Indices...>) noexcept
+    {
+        return { &OverlapEntry<Indices / WorldShapeTypeCount, Indices % WorldShapeTypeCount>... };
+    }
+
+    template<std::size_t... Indices>
+    [[nodiscard]] constexpr std::array<ManifoldFunction, sizeof...(Indices)> MakeManifoldTable(
+        std::index_sequence<Indices...>) noexcept
+    {
+        return { &ManifoldEntry<Indices / WorldShapeTypeCount, Indices % WorldShapeTypeCount>... };
+    }
+
+    template<std::size_t... Indices>
+    [[nodiscard]] constexpr std::array<ShapeCastFunction, sizeof...(Indices)> MakeShapeCastTable(
+        std::index_sequence<Indices...>) noexcept
+    {
+        return { &ShapeCastEntry<Indices / WorldShapeTypeCount, Indices % WorldShapeTypeCount>... };
+    }
+
+    /**
+     * @brief OverlapTable is the table of the overlap kernels, indexed by
+     * shape type A * WorldShapeTypeCount + shape type B.
+     */
+    inline constexpr auto OverlapTable =
+        MakeOverlapTable(std::make_index_sequence<WorldShapeTypeCount * WorldShapeTypeCount>{});
+
+    /**
+     * @brief ManifoldTable is the table of the manifold kernels, indexed by
+     * shape type A * WorldShapeTypeCount + shape type B.
+     */
+    inline constexpr auto ManifoldTable =
+        MakeManifoldTable(std::make_index_sequence<WorldShapeTypeCount * WorldShapeTypeCount>{});
+
+    /**
+     * @brief ShapeCastTable is the table of the shape cast kernels, indexed by
+     * shape type A * WorldShapeTypeCount + shape type B.
+     */
+    inline constexpr auto ShapeCastTable =
+        MakeShapeCastTable(std::make_index_sequence<WorldShapeTypeCount * WorldShapeTypeCount>{});
+
+    /**
+     * @brief DetectOverlap is a function that checks if two shapes overlap with the kernel of their types.
+     * @param typeA The type of the shape A.
+     * @param shapeA The shape A.
+     * @param typeB The type of the shape B.
+     * @param shapeB The shape B.
+     * @param cache The simplex cache of the pair used by the GJK kernels, nullptr to start from scratch.
+     * @return True if the two shapes overlap, false if they don't or if a type is None.
+     */
+    [[nodiscard]] inline bool DetectOverlap(const Math::ShapeType typeA, const ShapeInstance& shapeA,
+                                            const Math::ShapeType typeB, const ShapeInstance& shapeB,
+                                            SimplexCache* cache = nullptr) noexcept
+    {
+        const auto indexA = static_cast<std::size_t>(typeA);
+        const auto indexB = static_cast<std::size_t>(typeB);
+
+        if (indexA >= WorldShapeTypeCount || indexB >= WorldShapeTypeCount) return false;
+
+        return OverlapTable[indexA * WorldShapeTypeCount + indexB](shapeA, shapeB, cache);
+    }
+
+    /**
+     * @brief CalculateManifold is a function that calculates the contact manifold of two shapes with the kernel
+     * of their types.
+     * @param typeA The type of the shape A.
+     * @param shapeA The shape A.
+     * @param typeB The type of the shape B.
+     * @param shapeB The shape B.
+     * @return The contact manifold, without contact if a type is None.
+     */
+    [[nodiscard]] inline ContactManifold CalculateManifold(const Math::ShapeType typeA, const ShapeInstance& shapeA,
+                                                           const Math::ShapeType typeB, const ShapeInstance& shapeB) noexcept
+    {
+        const auto indexA = static_cast<std::size_t>(typeA);
+        const auto indexB = static_cast<std::size_t>(typeB);
+
+        if (indexA >= WorldShapeTypeCount || indexB >= WorldShapeTypeCount) return ContactManifold{};
+
+        return ManifoldTable[indexA * WorldShapeTypeCount + indexB](shapeA, shapeB);
+    }
+
+    /**
+     * @brief CalculateTimeOfImpact is a function that calculates when a shape translated from its position first
+     * touches another shape that doesn't move, with the kernel of their types.
+     * @param typeA The type of the moving shape A.
+     * @param shapeA The shape A at the start of the translation.
+     * @param translation The translation of the shape A.
+     * @param typeB The type of the shape B.
+     * @param shapeB The shape B.
+     * @return The first contact during the translation, no hit if a type is None (see ShapeCast).
+     */
+    [[nodiscard]] inline ShapeCastHit CalculateTimeOfImpact(const Math::ShapeType typeA, const ShapeInstance& shapeA,
+                                                            const Math::Vec2F translation,
+                                                            const Math::ShapeType typeB, const ShapeInstance& shapeB) noexcept
+    {
+        const auto indexA = static_cast<std::size_t>(typeA);
+        const auto indexB = static_cast<std::size_t>(typeB);
+
+        if (indexA >= WorldShapeTypeCount || indexB >= WorldShapeTypeCount) return ShapeCastHit{};
+
+        return ShapeCastTable[indexA * WorldShapeTypeCount + indexB](shapeA, shapeB, translation);
+    }
+}
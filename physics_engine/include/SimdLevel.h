@@ -0,0 +1,28 @@
+/**
+ * @headerfile SimdLevel.h
+ * This header file defines the SIMD levels used by the batched narrow phase and the contact constraint solver.
+ *
+ * @author Olivier Pachoud
+ */
+
+#pragma once
+
+namespace PhysicsEngine
+{
+    /**
+     * @brief SimdLevel is an enumeration that represents the instruction set used by the batched narrow phase and
+     * the contact constraint solver: Scalar (1 lane), Sse (4 lanes) or Avx2 (8 lanes).
+     */
+    enum class SimdLevel
+    {
+        Scalar,
+        Sse,
+        Avx2
+    };
+
+    /**
+     * @brief BestSimdLevel is a function that gives the widest SIMD level supported by the CPU running the program.
+     * @return The widest SIMD level supported by the CPU.
+     */
+    [[nodiscard]] SimdLevel BestSimdLevel() noexcept;
+}
@@ -0,0 +1,158 @@
+/**
+ * @headerfile SpatialHash.h
+ * This header file defines the SpatialHash class which is a broad phase that divides the world in a uniform grid
+ * of cells stored in a hash table.
+ *
+ * @author Olivier Pachoud
+ */
+
+#pragma once
+
+#include "Allocator.h"
+#include "BroadPhase.h"
+
+#include <cmath>
+#include <cstdint>
+
+namespace PhysicsEngine
+{
+    /**
+     * @brief SpatialHashCell is a struct that represents a slot of the hash table of the spatial hash.
+     * @note A slot is only used by the current step if its stamp is the stamp of the step, so the table never
+     * needs to be cleared.
+     */
+    struct SpatialHashCell
+    {
+        int X = 0;
+        int Y = 0;
+        std::uint32_t Stamp = 0;
+
+        /**
+         * @brief Count is the number of colliders in the cell.
+         */
+        std::size_t Count = 0;
+
+        /**
+         * @brief Offset is the index of the first collider of the cell in the entries of the spatial hash.
+         */
+        std::size_t Offset = 0;
+    };
+
+    /**
+     * @brief SpatialHash is a class that represents a uniform grid broad phase whose cells are stored in an
+     * open-addressing hash table.
+     * @note The colliders are added in all the cells they touch and the colliders of each cell are compared.
+     * A pair is only added by the cell which contains the minimum corner of the intersection of the two
+     * colliders, so each pair is added once. The memory is kept between the steps, so no memory is allocated
+     * once the hash table and the entries are big enough.
+     */
+    class SpatialHash final : public BroadPhase
+    {
+    private:
+        HeapAllocator _heapAllocator;
+
+        AllocVector<SpatialHashCell> _cells{ StandardAllocator<SpatialHashCell> {_heapAllocator} };
+
+        /**
+         * @brief UsedCells are the indices of the slots used by the current step.
+         */
+        AllocVector<std::size_t> _usedCells{ StandardAllocator<std::size_t> {_heapAllocator} };
+
+        /**
+         * @brief Entries are the indices of the colliders of each cell, stored cell after cell.
+         */
+        AllocVector<std::size_t> _entries{ StandardAllocator<std::size_t> {_heapAllocator} };
+
+        AllocVector<ColliderPair> _possiblePairs{ StandardAllocator<ColliderPair> {_heapAllocator} };
+
+        float _cellSize = 1.f;
+        std::uint32_t _stamp = 0;
+
+        /**
+         * @brief PreallocatedCellCount is the number of slots allocated by Init, it must be a power of two.
+         */
+        static constexpr std::size_t _preallocatedCellCount = 1024;
+
+        /**
+         * @brief cellCoordinate is a method that gives the coordinate of the cell containing the value given
+         * in parameter on an axis.
+         * @param value The value on the axis.
+         * @return The coordinate of the cell.
+         */
+        [[nodiscard]] int cellCoordinate(float value) const noexcept;
+
+        /**
+         * @brief findCell is a method that gives the slot of the cell at the coordinates given in parameter,
+         * using a new slot if the cell is not used by the current step yet.
+         * @param x The x coordinate of the cell.
+         * @param y The y coordinate of the cell.
+         * @return The index of the slot of the cell.
+         */
+        [[nodiscard]] std::size_t findCell(int x, int y) noexcept;
+
+        /**
+         * @brief grow is a method that doubles the size of the hash table and reinserts the used cells.
+         */
+        void grow() noexcept;
+
+    public:
+        SpatialHash() noexcept = default;
+
+        /**
+         * @brief Init is a method that pre-allocates the hash table.
+         */
+        void Init() noexcept override;
+
+        /**
+         * @brief Update is a method that adds the colliders given in parameter in the cells they touch and
+         * calculates the possible pairs of each cell.
+         * @param colliders The simplified enabled colliders of the world.
+         */
+        void Update(const AllocVector<SimplifiedCollider>& colliders) noexcept override;
+
+        /**
+         * @brief PossiblePairs is a method that gives the possible pairs of collider whose simplified shapes
+         * touch each other.
+         * @return The possible pairs of collider whose simplified shapes touch each other.
+         */
+        [[nodiscard]] const AllocVector<ColliderPair>& PossiblePairs() const noexcept override
+        {
+            return _possiblePairs;
+        }
+
+        /**
+         * @brief Clear is a method that removes all the cells and possible pairs.
+         */
+        void Clear() noexcept override;
+
+        /**
+         * @brief Deinit is a method that deinitialize the spatial hash by removing all data from it.
+         */
+        void Deinit() noexcept override;
+
+        /**
+         * @brief CellSize is a method that gives the size of the cells of the grid.
+         * @return The size of the cells of the grid.
+         */
+        [[nodiscard]] float CellSize() const noexcept { return _cellSize; }
+
+        /**
+         * @brief SetCellSize is a method that replaces the size of the cells of the grid with the one given in
+         * parameter, the values that are not positive and finite are ignored. The best size is about the size of
+         * the biggest colliders.
+         * @param cellSize The new size of the cells of the grid.
+         */
+        void SetCellSize(const float cellSize) noexcept
+        {
+            if (!(cellSize > 0.f) || !std::isfinite(cellSize)) return;
+
+            _cellSize = cellSize;
+        }
+
+        /**
+         * @brief UsedCellCount is a method that gives the number of cells used by the last update.
+         * @return The number of cells used by the last update.
+         */
+        [[nodiscard]] std::size_t UsedCellCount() const noexcept { return _usedCells.size(); }
+    };
+}
@@ -0,0 +1,140 @@
+/**
+ * @headerfile SweepAndPrune.h
+ * This header file defines the SweepAndPrune class which is a broad phase that sorts the bounds of the colliders
+ * along the axes and sweeps them to find the colliders that overlap.
+ *
+ * @author Olivier Pachoud
+ */
+
+#pragma once
+
+#include "Allocator.h"
+#include "BroadPhase.h"
+
+namespace PhysicsEngine
+{
+    /**
+     * @brief SapEndpoint is a struct that represents the minimum or the maximum bound of a collider on an axis.
+     */
+    struct SapEndpoint
+    {
+        float Value = 0.f;
+        std::size_t ProxyIndex = 0;
+        bool IsMin = true;
+    };
+
+    /**
+     * @brief SapProxy is a struct that stores the state of a collider in the sweep-and-prune.
+     */
+    struct SapProxy
+    {
+        ColliderRef ColRef{0, 0};
+        Math::RectangleF Rectangle{Math::Vec2F::Zero(), Math::Vec2F::Zero()};
+
+        /**
+         * @brief ActiveIndex is the index of the proxy in the active list during the sweep.
+         */
+        std::size_t ActiveIndex = 0;
+
+        bool Enabled = false;
+        bool Updated = false;
+    };
+
+    /**
+     * @brief SweepAndPrune is a class that represents a sweep-and-prune broad phase.
+     * @note The possible pairs are found by sweeping the endpoints of the axis on which the colliders are the most
+     * spread. Only the endpoints of this axis are sorted, with an insertion sort of their order of the last step,
+     * so the cost of the sort is proportional to the motion of the colliders.
+     */
+    class SweepAndPrune final : public BroadPhase
+    {
+    private:
+        HeapAllocator _heapAllocator;
+
+        AllocVector<SapProxy> _proxies{ StandardAllocator<SapProxy> {_heapAllocator} };
+        AllocVector<SapEndpoint> _endpointsX{ StandardAllocator<SapEndpoint> {_heapAllocator} };
+        AllocVector<SapEndpoint> _endpointsY{ StandardAllocator<SapEndpoint> {_heapAllocator} };
+        AllocVector<std::size_t> _activeProxies{ StandardAllocator<std::size_t> {_heapAllocator} };
+        AllocVector<ColliderPair> _possiblePairs{ StandardAllocator<ColliderPair> {_heapAllocator} };
+
+        /**
+         * @brief PreallocatedProxyCount is the number of proxies allocated by Init.
+         */
+        static constexpr std::size_t _preallocatedProxyCount = 256;
+
+        /**
+         * @brief SweepAxis is the axis swept by the last update, 0 for the x-axis and 1 for the y-axis.
+         */
+        int _sweepAxis = 0;
+
+        /**
+         * @brief updateEndpoints is a method that copies the bounds of the proxies in the endpoints of an axis
+         * and sorts them with an insertion sort.
+         * @param endpoints The endpoints of the axis.
+         * @param axis 0 for the x-axis and 1 for the y-axis.
+         */
+        void updateEndpoints(AllocVector<SapEndpoint>& endpoints, int axis) noexcept;
+
+        /**
+         * @brief sweep is a method that calculates the possible pairs by sweeping the sorted endpoints
+         * of an axis.
+         * @param endpoints The sorted endpoints of the axis.
+         */
+        void sweep(const AllocVector<SapEndpoint>& endpoints) noexcept;
+
+    public:
+        SweepAndPrune() noexcept = default;
+
+        /**
+         * @brief Init is a method that pre-allocates the proxies and the endpoints.
+         */
+        void Init() noexcept override;
+
+        /**
+         * @brief Update is a method that updates the proxies and endpoints of the colliders given in parameter,
+         * removes the ones of the colliders that are not given anymore and calculates the possible pairs.
+         * @param colliders The simplified enabled colliders of the world.
+         */
+        void Update(const AllocVector<SimplifiedCollider>& colliders) noexcept override;
+
+        /**
+         * @brief PossiblePairs is a method that gives the possible pairs of collider whose simplified shapes
+         * touch each other.
+         * @return The possible pairs of collider whose simplified shapes touch each other.
+         */
+        [[nodiscard]] const AllocVector<ColliderPair>& PossiblePairs() const noexcept override
+        {
+            return _possiblePairs;
+        }
+
+        /**
+         * @brief Clear is a method that removes all proxies, endpoints and possible pairs.
+         */
+        void Clear() noexcept override;
+
+        /**
+         * @brief Deinit is a method that deinitialize the sweep-and-prune by removing all data from it.
+         */
+        void Deinit() noexcept override;
+
+        /**
+         * @brief SweepAxis is a method that gives the axis swept by the last update.
+         * @return 0 for the x-axis and 1 for the y-axis.
+         */
+        [[nodiscard]] int SweepAxis() const noexcept { return _sweepAxis; }
+
+        /**
+         * @brief EndpointsX is a method that gives the endpoints on the x-axis, they are only sorted when it is
+         * the sweep axis.
+         * @return The endpoints on the x-axis.
+         */
+        [[nodiscard]] const AllocVector<SapEndpoint>& EndpointsX() const noexcept { return _endpointsX; }
+
+        /**
+         * @brief EndpointsY is a method that gives the endpoints on the y-axis, they are only sorted when it is
+         * the sweep axis.
+         * @return The endpoints on the y-axis.
+         */
+        [[nodiscard]] const AllocVector<SapEndpoint>& EndpointsY() const noexcept { return _endpointsY; }
+    };
+}
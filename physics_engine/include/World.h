@@ -6,18 +6,107 @@
 
 #pragma once
 
+#include "AabbTree.h"
 #include "Body.h"
 #include "Collider.h"
-#include "ContactSolver.h"
+#include "ContactConstraintSolver.h"
 #include "ContactListener.h"
+#include "BroadPhase.h"
+#include "IslandGraph.h"
+#include "JobSystem.h"
+#include "LinearQuadTree.h"
+#include "NarrowPhaseBatch.h"
 #include "QuadTree.h"
+#include "SimdLevel.h"
+#include "SpatialHash.h"
+#include "SweepAndPrune.h"
 #include "WorldRefTypes.h"
 
+#include <algorithm>
 #include <vector>
 #include <unordered_set>
 
 namespace PhysicsEngine
 {
+    /**
+     * @brief VertexSpan is a struct that gives the range of the vertices of a polygon collider in the vertex pool
+     * of the world.
+     */
+    struct VertexSpan
+    {
+        std::size_t Offset = 0;
+        int Count = 0;
+    };
+
+    /**
+     * @brief ColliderProxy is a struct that stores the data of a collider calculated once each step
+     * (its body, its world-space simplified shape and its shape type) so that the broad phase, the narrow phase
+     * and the render don't need to get the body and calculate the bounds again.
+     */
+    struct ColliderProxy
+    {
+        ColliderRef ColRef{0, 0};
+        std::size_t BodyIndex = 0;
+        Math::Vec2F BodyPosition = Math::Vec2F::Zero();
+        Math::RectangleF Aabb{Math::Vec2F::Zero(), Math::Vec2F::Zero()};
+        Math::ShapeType Type = Math::ShapeType::None;
+
+        /**
+         * @brief Vertices is the range of the world-space vertices of a polygon collider in the vertex pool.
+         */
+        VertexSpan Vertices{};
+        bool Enabled = false;
+
+        /**
+         * @brief IsOutOfBroadPhase is true when the collider of a sleeping body is not given to a broad phase
+         * rebuilt each step because no moving collider can touch it, its pairs being kept from the previous step.
+         */
+        bool IsOutOfBroadPhase = false;
+    };
+
+    /**
+     * @brief PairSimplexCache is a struct that stores the simplex cache of a pair of colliders tested with GJK,
+     * identified by the key of the pair (see ColliderPair::Key).
+     */
+    struct PairSimplexCache
+    {
+        std::uint64_t Key = 0;
+        SimplexCache Cache{};
+    };
+
+    /**
+     * @brief ContinuousMotion is a struct that stores the move of a continuous body during a step, so that the body
+     * can be moved back to its first time of impact with a static collider.
+     */
+    struct ContinuousMotion
+    {
+        std::size_t BodyIndex = 0;
+        Math::Vec2F StartPosition = Math::Vec2F::Zero();
+        Math::Vec2F Translation = Math::Vec2F::Zero();
+
+        /**
+         * @brief Time is the fraction of the translation done by the body, lower than 1 if it hit a static
+         * collider during the step.
+         */
+        float Time = 1.f;
+
+        /**
+         * @brief VelocityBeforeSolve is the velocity of the body before the contacts are solved, to remove the
+         * position correction of the solver from the remaining move.
+         */
+        Math::Vec2F VelocityBeforeSolve = Math::Vec2F::Zero();
+    };
+
+    /**
+     * @brief PreviousPosition is a struct that stores the position of a body before the last fixed step, with the
+     * generation index of the body so that a new body at the same index is not interpolated from it.
+     */
+    struct PreviousPosition
+    {
+        Math::Vec2F Position = Math::Vec2F::Zero();
+        std::uint32_t GenerationIdx = 0;
+    };
+
     /**
      * @brief World is a class that contains all the physical bodies in the program and calculates
      * their movements and changes in physical state.
@@ -30,42 +119,380 @@ namespace PhysicsEngine
         HeapAllocator _heapAllocator{};
 
         AllocVector<Body> _bodies{ StandardAllocator<Body>{_heapAllocator} };
-        AllocVector<std::size_t> _bodiesGenIndices{ StandardAllocator<std::size_t>{_heapAllocator} };
+        AllocVector<std::uint32_t> _bodiesGenIndices{ StandardAllocator<std::uint32_t>{_heapAllocator} };
+
+        /**
+         * @brief FreeBodyIndices is the stack of the indices of the invalid bodies, the last one is given by the
+         * next CreateBody.
+         */
+        AllocVector<std::size_t> _freeBodyIndices{ StandardAllocator<std::size_t>{_heapAllocator} };
+
+        /**
+         * @brief SimdLevel is the instruction set used by the batched narrow phase and the contact
+         * constraint solver, selected at initialization according to the CPU running the program.
+         */
+        SimdLevel _simdLevel = SimdLevel::Scalar;
 
         AllocVector<Collider> _colliders{ StandardAllocator<Collider>{_heapAllocator} };
-        AllocVector<std::size_t> _collidersGenIndices{ StandardAllocator<std::size_t>{_heapAllocator} };
+        AllocVector<std::uint32_t> _collidersGenIndices{ StandardAllocator<std::uint32_t>{_heapAllocator} };
+
+        /**
+         * @brief FreeColliderIndices is the stack of the indices of the destroyed colliders, the last one is
+         * given by the next CreateCollider.
+         */
+        AllocVector<std::size_t> _freeColliderIndices{ StandardAllocator<std::size_t>{_heapAllocator} };
 
+        /**
+         * @brief ColliderPairs are the pairs of colliders that overlapped in the previous step, sorted by key
+         * (see ColliderPair::Key).
+         */
         AllocVector<ColliderPair> _colliderPairs{ StandardAllocator<ColliderPair>{_heapAllocator} };
 
+        /**
+         * @brief NewColliderPairs are the pairs of colliders that overlap in the current step, kept as a member
+         * to reuse its memory each step.
+         */
+        AllocVector<ColliderPair> _newColliderPairs{ StandardAllocator<ColliderPair>{_heapAllocator} };
+
         ContactListener* _contactListener = nullptr;
 
+        /**
+         * @brief ContactConstraintSolver is the solver of the contacts between the colliders that are not triggers,
+         * it keeps the contacts from one step to the next one to warm-start them.
+         */
+        ContactConstraintSolver _contactConstraintSolver{ _heapAllocator };
+
+        /**
+         * @brief IslandGraph is the graph of the islands of the bodies in contact, built after the narrow phase.
+         */
+        IslandGraph _islandGraph{ _heapAllocator };
+
+        bool _isSleepingEnabled = false;
+
+        /**
+         * @brief JobSystem is the job system used to run the overlap tests of the narrow phase and the solve of
+         * the islands in parallel, they run on the calling thread if it is nullptr.
+         */
+        JobSystem* _jobSystem = nullptr;
+
+        /**
+         * @brief ChunkPairs are the overlapping pairs found by each chunk of possible pairs when the narrow phase
+         * runs in parallel, merged in the chunk order so that the result does not depend on the threads.
+         */
+        AllocVector<AllocVector<ColliderPair>> _chunkPairs{
+            StandardAllocator<AllocVector<ColliderPair>>{_heapAllocator} };
+
+        /**
+         * @brief NarrowPhaseChunkSize is the number of possible pairs tested by each job of the narrow phase.
+         */
+        static constexpr std::size_t _narrowPhaseChunkSize = 256;
+
+        NarrowPhaseMode _narrowPhaseMode = NarrowPhaseMode::PerPair;
+
+        /**
+         * @brief NarrowPhaseBatches are the batches of the batched narrow phase, one for each chunk of possible
+         * pairs when the narrow phase runs in parallel.
+         */
+        AllocVector<NarrowPhaseBatch> _narrowPhaseBatches{ StandardAllocator<NarrowPhaseBatch>{_heapAllocator} };
+
+        /**
+         * @brief SimplexCaches are the simplex caches of the pairs tested with GJK in the previous step, sorted by
+         * key, used to warm-start GJK in the current step.
+         */
+        AllocVector<PairSimplexCache> _simplexCaches{ StandardAllocator<PairSimplexCache>{_heapAllocator} };
+
+        /**
+         * @brief NewSimplexCaches are the simplex caches of the pairs tested with GJK in the current step, kept as
+         * a member to reuse its memory each step.
+         */
+        AllocVector<PairSimplexCache> _newSimplexCaches{ StandardAllocator<PairSimplexCache>{_heapAllocator} };
+
+        /**
+         * @brief ChunkSimplexCaches are the simplex caches found by each chunk of possible pairs when the narrow
+         * phase runs in parallel.
+         */
+        AllocVector<AllocVector<PairSimplexCache>> _chunkSimplexCaches{
+            StandardAllocator<AllocVector<PairSimplexCache>>{_heapAllocator} };
+
         QuadTree _quadTree{};
+        AabbTree _aabbTree{};
+        SweepAndPrune _sweepAndPrune{};
+        SpatialHash _spatialHash{};
+        LinearQuadTree _linearQuadTree{};
+
+        /**
+         * @brief BroadPhase is the broad phase used by the world, it points to one of the broad phases above
+         * according to the broad phase type.
+         */
+        BroadPhase* _broadPhase = &_quadTree;
+        BroadPhaseType _broadPhaseType = BroadPhaseType::QuadTree;
+
+        /**
+         * @brief SimplifiedColliders are the enabled colliders of the world given to the broad phase each step.
+         */
+        AllocVector<SimplifiedCollider> _simplifiedColliders{ StandardAllocator<SimplifiedCollider>{_heapAllocator} };
+
+        /**
+         * @brief MovingAabbs are the bounds given to the broad phase of the colliders of the bodies that are not
+         * static nor sleeping, sorted by min x to find the sleeping colliders they can touch.
+         */
+        AllocVector<Math::RectangleF> _movingAabbs{ StandardAllocator<Math::RectangleF>{_heapAllocator} };
+
+        /**
+         * @brief SleepingColliders are the indices of the colliders of the sleeping bodies, only given to a
+         * broad phase rebuilt each step when a moving collider can touch them.
+         */
+        AllocVector<std::size_t> _sleepingColliders{ StandardAllocator<std::size_t>{_heapAllocator} };
+
+        /**
+         * @brief RestingPairs are the collider pairs of the previous step kept without being tested because one
+         * of their colliders is out of the broad phase (see ColliderProxy::IsOutOfBroadPhase).
+         */
+        AllocVector<ColliderPair> _restingPairs{ StandardAllocator<ColliderPair>{_heapAllocator} };
+
+        /**
+         * @brief PolygonVertices is the pool of the world-space vertices of the enabled polygon colliders, filled
+         * once each step by the broad phase so that the narrow phase never copies nor translates a polygon.
+         */
+        AllocVector<Math::Vec2F> _polygonVertices{ StandardAllocator<Math::Vec2F>{_heapAllocator} };
+
+        /**
+         * @brief ColliderProxies are the proxies of the colliders, indexed by collider index and updated once each
+         * step after the integration.
+         */
+        AllocVector<ColliderProxy> _colliderProxies{ StandardAllocator<ColliderProxy>{_heapAllocator} };
+
+        /**
+         * @brief FixedDeltaTime is the time simulated by each step of Step, whatever the frame time is.
+         */
+        float _fixedDeltaTime = DefaultFixedDeltaTime;
+
+        /**
+         * @brief MaxSubStepCount is the maximum number of fixed steps done by Step, the frame time that is
+         * left is dropped so that a slow frame doesn't make the next ones slower (aka spiral of death).
+         */
+        int _maxSubStepCount = DefaultMaxSubStepCount;
+
+        /**
+         * @brief Accumulator is the frame time given to Step that is not simulated yet, always lower than the
+         * fixed delta time after a Step.
+         */
+        float _accumulator = 0.f;
+
+        /**
+         * @brief PreviousPositions are the positions of the bodies before the last fixed step, indexed by body
+         * index, from which the render positions are interpolated.
+         */
+        AllocVector<PreviousPosition> _previousPositions{ StandardAllocator<PreviousPosition>{_heapAllocator} };
+
+        /**
+         * @brief FrameForces are the forces applied to the bodies before a Step, indexed by body index, applied
+         * again before each of its fixed steps since the integration resets them.
+         */
+        AllocVector<Math::Vec2F> _frameForces{ StandardAllocator<Math::Vec2F>{_heapAllocator} };
+
+        /**
+         * @brief ContinuousMotions are the moves of the awake continuous bodies of the step, sorted by body index.
+         */
+        AllocVector<ContinuousMotion> _continuousMotions{ StandardAllocator<ContinuousMotion>{_heapAllocator} };
 
         /*
         * @brief BodyAllocResizeFactor is the factor to mulitply with 
         * the current size of a vector to allocate it a larger size.
         */
         static constexpr float _bodyAllocResizeFactor = 2.f;
+
+        /*
+        * @brief ReserveFreeBodies is a method that grows the bodies once so that at least the number of free
+        * bodies given in parameter are available.
+        * @param count The number of free bodies needed.
+        */
+        void reserveFreeBodies(std::size_t count) noexcept;
+
+        /*
+        * @brief ReserveFreeColliders is a method that grows the colliders once so that at least the number of
+        * free colliders given in parameter are available.
+        * @param count The number of free colliders needed.
+        */
+        void reserveFreeColliders(std::size_t count) noexcept;
       
         /*
         * @brief ResolveBroadPhase is a method that reduces the number of potential collision pairs 
-        * to a manageable subset using a quad-tree.
+        * to a manageable subset using the broad phase of the world (see BroadPhaseType).
+        * @note The colliders of the continuous bodies are given with the bounds of their whole move of the step.
         */
         void resolveBroadPhase() noexcept;
 
+        /*
+        * @brief IsBroadPhaseRebuilt is a method that checks if the broad phase of the world inserts all the
+        * colliders it is given again each step instead of keeping them between the steps.
+        * @return True if the broad phase is rebuilt each step.
+        */
+        [[nodiscard]] bool isBroadPhaseRebuilt() const noexcept;
+
+        /*
+        * @brief AddTouchedSleepingColliders is a method that gives to the broad phase the sleeping colliders that
+        * a moving collider can touch, the others being left out of it with their pairs kept as resting pairs.
+        */
+        void addTouchedSleepingColliders() noexcept;
+
+        /*
+        * @brief UpdateColliderProxies is a method that updates the proxies of all the colliders in a single
+        * pass over the colliders.
+        */
+        void updateColliderProxies() noexcept;
+
+        /*
+        * @brief CalculateSimplifiedShape is a method that calculates the simplified shape of the collider
+        * given in parameter (aka its axis-aligned bounding rectangle in world space).
+        * @note The world-space vertices of a polygon collider are added to the vertex pool.
+        * @param collider The collider.
+        * @param position The position of the body of the collider.
+        * @param vertices The range of the vertices of the collider in the vertex pool, set for a polygon.
+        * @return The simplified shape of the collider.
+        */
+        [[nodiscard]] Math::RectangleF calculateSimplifiedShape(const Collider& collider,
+                                                                Math::Vec2F position,
+                                                                VertexSpan& vertices) noexcept;
+
+        /*
+        * @brief PolygonSpan is a method that gives the world-space vertices of the polygon collider at the
+        * index given in parameter, as calculated by the last broad phase.
+        * @param colliderIdx The index of the collider in the world.
+        * @return The world-space vertices of the polygon.
+        */
+        [[nodiscard]] Math::PolygonSpanF polygonSpan(const std::size_t colliderIdx) const noexcept
+        {
+            const auto& proxy = _colliderProxies[colliderIdx];
+            const auto* polygon = std::get_if<Math::PolygonF>(&_colliders[colliderIdx].Shape());
+
+            if (polygon == nullptr) return Math::PolygonSpanF(nullptr, 0);
+
+            // The bodies don't rotate, so the local edge normals are also the world ones.
+            return Math::PolygonSpanF(_polygonVertices.data() + proxy.Vertices.Offset, proxy.Vertices.Count,
+                                      polygon->EdgeNormals().data(), polygon->BoundingCircle() + proxy.BodyPosition);
+        }
+
+        /*
+        * @brief BeginContinuousMotions is a method that stores the start positions of the awake continuous
+        * bodies, before they are integrated.
+        */
+        void beginContinuousMotions() noexcept;
+
+        /*
+        * @brief FindContinuousMotion is a method that gives the move of the body given in parameter if it is
+        * continuous.
+        * @param bodyIdx The index of the body.
+        * @return The move of the body, nullptr if the body is not continuous or is sleeping.
+        */
+        [[nodiscard]] ContinuousMotion* findContinuousMotion(std::size_t bodyIdx) noexcept;
+
+        /*
+        * @brief ResolveContinuousCollisions is a method that sweeps the continuous bodies against the static
+        * colliders found by the broad phase, and moves each of them back to its first time of impact so that the
+        * narrow phase finds the contact instead of missing it.
+        */
+        void resolveContinuousCollisions() noexcept;
+
+        /*
+        * @brief FinishContinuousMotions is a method that moves the continuous bodies that hit a static collider
+        * for the rest of the step with their velocity solved by the contacts.
+        * @param deltaTime The time elapsed since the last step.
+        */
+        void finishContinuousMotions(float deltaTime) noexcept;
+
         /*
         * @brief ResolveNarrowPhase is a method that determines the precise details 
         * of the collisions between pairs of objects identified in the broad phase.
         */
         void resolveNarrowPhase() noexcept;
 
+        /*
+        * @brief BuildIslands is a method that builds the islands of the dynamic bodies linked by the contacts of
+        * the step.
+        */
+        void buildIslands() noexcept;
+
+        /*
+        * @brief UpdateSleep is a method that puts to sleep the islands whose bodies have all been slow for long
+        * enough. The islands with an awake body and a sleeping body are woken up.
+        * @param deltaTime The time elapsed since the last step.
+        */
+        void updateSleep(float deltaTime) noexcept;
+
+        /*
+        * @brief IsPairAsleep is a method that checks if a pair of colliders doesn't need to be tested because it
+        * can't have moved (aka a sleeping body with another sleeping body or a static body).
+        * @param pair The pair of colliders.
+        * @return True if the pair is asleep.
+        */
+        [[nodiscard]] bool isPairAsleep(const ColliderPair& pair) const noexcept;
+
+        /*
+        * @brief WasColliding is a method that checks if a pair of colliders overlapped in the previous step.
+        * @param pair The pair of colliders.
+        * @return True if the pair is in the collider pairs of the previous step.
+        */
+        [[nodiscard]] bool wasColliding(const ColliderPair& pair) const noexcept;
+
+        /*
+        * @brief AddContact is a method that calculates the contact manifold of the pair of colliders given in
+        * parameter and adds it to the contact solver.
+        * @param pair The pair of colliders in contact, which are not triggers.
+        */
+        void addContact(const ColliderPair& pair) noexcept;
+
+        /*
+        * @brief DetectOverlaps is a method that adds the possible pairs given in parameter whose colliders
+        * overlap to the output pairs.
+        * @note It only reads the world, so it can be called on several threads at the same time.
+        * @param possiblePairs The possible pairs to test.
+        * @param begin The index of the first possible pair to test.
+        * @param end The index after the last possible pair to test.
+        * @param overlappingPairs The output pairs.
+        * @param simplexCaches The output simplex caches of the pairs tested with GJK.
+        */
+        void detectOverlaps(const AllocVector<ColliderPair>& possiblePairs, std::size_t begin, std::size_t end,
+                            AllocVector<ColliderPair>& overlappingPairs,
+                            AllocVector<PairSimplexCache>& simplexCaches) noexcept;
+
+        /*
+        * @brief DetectOverlapsBatched is a method that adds the possible pairs given in parameter whose colliders
+        * overlap to the output pairs, after grouping them by shape types in the batch given in parameter.
+        * @note The batch must be reserved for the number of pairs to test. The output pairs are grouped by
+        * shape types instead of being in the order of the possible pairs.
+        * @param possiblePairs The possible pairs to test.
+        * @param begin The index of the first possible pair to test.
+        * @param end The index after the last possible pair to test.
+        * @param batch The batch in which the pairs are grouped.
+        * @param overlappingPairs The output pairs.
+        * @param simplexCaches The output simplex caches of the pairs tested with GJK.
+        */
+        void detectOverlapsBatched(const AllocVector<ColliderPair>& possiblePairs, std::size_t begin,
+                                   std::size_t end, NarrowPhaseBatch& batch,
+                                   AllocVector<ColliderPair>& overlappingPairs,
+                                   AllocVector<PairSimplexCache>& simplexCaches) noexcept;
+
+        /*
+        * @brief ShapeInstanceOf is a method that gives the world-space shape of the collider at the index given
+        * in parameter, as calculated by its proxy.
+        * @param colliderIdx The index of the collider in the world.
+        * @return The shape instance of the collider.
+        */
+        [[nodiscard]] ShapeInstance shapeInstanceOf(std::size_t colliderIdx) const noexcept
+        {
+            return ShapeInstance{&_colliders[colliderIdx].Shape(), _colliderProxies[colliderIdx].BodyPosition,
+                                 polygonSpan(colliderIdx)};
+        }
+
         /*
         * @brief DetectOverlap is a function that check if the two colliders given in parameter overlap.
-        * @param colA The collider A.
-        * @param colB The collider B.
+        * @note A pair with a polygon is tested with GJK, warm-started by its simplex cache of the previous step.
+        * @param pair The pair of colliders.
+        * @param simplexCaches The output simplex caches, the new simplex cache of the pair is added to it.
         * @return True if the two colliders overlap.
         */
-        bool detectOverlap(const Collider& colA, const Collider& colB) noexcept;
+        bool detectOverlap(const ColliderPair& pair, AllocVector<PairSimplexCache>& simplexCaches) const noexcept;
 
     public:
         World() noexcept = default;
@@ -85,6 +512,74 @@ namespace PhysicsEngine
          */
         void Update(float deltaTime) noexcept;
 
+        /**
+         * @brief DefaultFixedDeltaTime is the time simulated by each fixed step of Step by default.
+         */
+        static constexpr float DefaultFixedDeltaTime = 1.f / 60.f;
+
+        /**
+         * @brief DefaultMaxSubStepCount is the maximum number of fixed steps done by a Step by default.
+         */
+        static constexpr int DefaultMaxSubStepCount = 8;
+
+        /**
+         * @brief Step is a method that simulates the frame time given in parameter with as many fixed steps as
+         * it contains, the time that is left being simulated by the next Steps. The forces applied to the bodies
+         * before the Step are applied during all of its fixed steps.
+         * @note If more than the maximum number of fixed steps are needed, the frame time that is left is
+         * dropped and the simulation runs slower than the real time.
+         * @param frameTime The time elapsed since the last frame.
+         * @return The number of fixed steps done.
+         */
+        int Step(float frameTime) noexcept;
+
+        /**
+         * @brief FixedDeltaTime is a method that gives the time simulated by each fixed step of Step.
+         * @return The fixed delta time of the world.
+         */
+        [[nodiscard]] float FixedDeltaTime() const noexcept { return _fixedDeltaTime; }
+
+        /**
+         * @brief SetFixedDeltaTime is a method that sets the time simulated by each fixed step of Step, the
+         * values that are not positive are ignored.
+         * @param fixedDeltaTime The new fixed delta time of the world.
+         */
+        void SetFixedDeltaTime(const float fixedDeltaTime) noexcept
+        {
+            if (fixedDeltaTime <= 0.f) return;
+
+            _fixedDeltaTime = fixedDeltaTime;
+        }
+
+        /**
+         * @brief MaxSubStepCount is a method that gives the maximum number of fixed steps done by a Step.
+         * @return The maximum number of fixed steps of a Step.
+         */
+        [[nodiscard]] int MaxSubStepCount() const noexcept { return _maxSubStepCount; }
+
+        /**
+         * @brief SetMaxSubStepCount is a method that sets the maximum number of fixed steps done by a Step, it
+         * is at least one.
+         * @param maxSubStepCount The new maximum number of fixed steps of a Step.
+         */
+        void SetMaxSubStepCount(const int maxSubStepCount) noexcept { _maxSubStepCount = std::max(1, maxSubStepCount); }
+
+        /**
+         * @brief InterpolationFactor is a method that gives how far the time not simulated yet by Step is in the
+         * next fixed step, used to interpolate the positions of the bodies for the render.
+         * @return The interpolation factor, between 0 and 1.
+         */
+        [[nodiscard]] float InterpolationFactor() const noexcept { return _accumulator / _fixedDeltaTime; }
+
+        /**
+         * @brief InterpolatedPosition is a method that gives the position of the body for the render, between its
+         * positions before and after the last fixed step according to the interpolation factor. It only reads
+         * the world, the body keeps its simulated position.
+         * @param bodyRef The body reference of the body.
+         * @return The interpolated position of the body, its position if it has not been stepped yet.
+         */
+        [[nodiscard]] Math::Vec2F InterpolatedPosition(BodyRef bodyRef) const;
+
         /**
          * @brief Deinit is a method that clears all bodies and colliders.
          */
@@ -110,6 +605,135 @@ namespace PhysicsEngine
          */
         void SetContactListener(ContactListener* contactListener) noexcept { _contactListener = contactListener; }
 
+        /**
+         * @brief SetJobSystem is a method that sets the job system used to run the overlap tests of the narrow
+         * phase, the build of the quad-trees and the solve of the islands of contacts in parallel. The contact
+         * listener is still called on the thread calling Update.
+         * @param jobSystem The job system of the world, nullptr to run everything on the calling thread.
+         */
+        void SetJobSystem(JobSystem* jobSystem) noexcept
+        {
+            _jobSystem = jobSystem;
+            _quadTree.SetJobSystem(jobSystem);
+            _linearQuadTree.SetJobSystem(jobSystem);
+        }
+
+        /**
+         * @brief GetJobSystem is a method that gives the job system used by the narrow phase.
+         * @return The job system used by the narrow phase, nullptr if there is none.
+         */
+        [[nodiscard]] JobSystem* GetJobSystem() const noexcept { return _jobSystem; }
+
+        /**
+         * @brief GetNarrowPhaseMode is a method that gives how the narrow phase tests the possible pairs.
+         * @return The mode of the narrow phase (see NarrowPhaseMode).
+         */
+        [[nodiscard]] NarrowPhaseMode GetNarrowPhaseMode() const noexcept { return _narrowPhaseMode; }
+
+        /**
+         * @brief SetNarrowPhaseMode is a method that sets how the narrow phase tests the possible pairs.
+         * @param narrowPhaseMode The mode of the narrow phase (see NarrowPhaseMode).
+         */
+        void SetNarrowPhaseMode(NarrowPhaseMode narrowPhaseMode) noexcept { _narrowPhaseMode = narrowPhaseMode; }
+
+        /**
+         * @brief SleepVelocity is the speed under which a body starts to fall asleep.
+         */
+        static constexpr float SleepVelocity = 0.05f;
+
+        /**
+         * @brief TimeToSleep is the time during which all the bodies of an island must be slower than the sleep
+         * velocity for the island to fall asleep.
+         */
+        static constexpr float TimeToSleep = 0.5f;
+
+        /**
+         * @brief IsSleepingEnabled is a method that checks if the islands of bodies at rest are put to sleep.
+         * @return True if the sleeping is enabled.
+         */
+        [[nodiscard]] bool IsSleepingEnabled() const noexcept { return _isSleepingEnabled; }
+
+        /**
+         * @brief SetSleepingEnabled is a method that enables or disables the sleeping of the islands of bodies at
+         * rest, all the bodies are woken up when it is disabled.
+         * @note The sleeping is disabled by default and the bodies only fall asleep in the steps where the contacts
+         * are solved (aka when a contact listener is set).
+         * @param isSleepingEnabled True to enable the sleeping.
+         */
+        void SetSleepingEnabled(bool isSleepingEnabled) noexcept;
+
+        /**
+         * @brief GetIslandGraph is a method that gives the islands of the bodies in contact of the last step.
+         * @return The island graph of the world.
+         */
+        [[nodiscard]] const IslandGraph& GetIslandGraph() const noexcept { return _islandGraph; }
+
+        /**
+         * @brief GetVelocityIterationCount is a method that gives the number of times the contacts are solved for
+         * the velocities each step.
+         * @return The number of velocity iterations of the contact solver.
+         */
+        [[nodiscard]] int GetVelocityIterationCount() const noexcept
+        {
+            return _contactConstraintSolver.VelocityIterationCount();
+        }
+
+        /**
+         * @brief SetVelocityIterationCount is a method that sets the number of times the contacts are solved for
+         * the velocities each step, more iterations make the stacks more stable.
+         * @param count The number of velocity iterations of the contact solver.
+         */
+        void SetVelocityIterationCount(const int count) noexcept
+        {
+            _contactConstraintSolver.SetVelocityIterationCount(count);
+        }
+
+        /**
+         * @brief GetPositionIterationCount is a method that gives the number of times the contacts are solved for
+         * the penetrations each step.
+         * @return The number of position iterations of the contact solver.
+         */
+        [[nodiscard]] int GetPositionIterationCount() const noexcept
+        {
+            return _contactConstraintSolver.PositionIterationCount();
+        }
+
+        /**
+         * @brief SetPositionIterationCount is a method that sets the number of times the contacts are solved for
+         * the penetrations each step.
+         * @param count The number of position iterations of the contact solver.
+         */
+        void SetPositionIterationCount(const int count) noexcept
+        {
+            _contactConstraintSolver.SetPositionIterationCount(count);
+        }
+
+        /**
+         * @brief GetContactSolverMode is a method that gives how the contacts of an island are ordered by the solver.
+         * @return The mode of the contact solver (see ContactSolverMode).
+         */
+        [[nodiscard]] ContactSolverMode GetContactSolverMode() const noexcept
+        {
+            return _contactConstraintSolver.Mode();
+        }
+
+        /**
+         * @brief SetContactSolverMode is a method that sets how the contacts of an island are ordered by the solver,
+         * the GraphColored mode lets the large islands be solved on several threads.
+         * @param mode The mode of the contact solver (see ContactSolverMode).
+         */
+        void SetContactSolverMode(const ContactSolverMode mode) noexcept { _contactConstraintSolver.SetMode(mode); }
+
+        /**
+         * @brief SetGraphColoringConstraintCount is a method that sets the number of contacts from which an island
+         * is solved color by color in the GraphColored mode.
+         * @param count The number of contacts of the smallest colored island.
+         */
+        void SetGraphColoringConstraintCount(const std::size_t count) noexcept
+        {
+            _contactConstraintSolver.SetGraphColoringConstraintCount(count);
+        }
+
         /**
          * @brief CreateBody is a method that creates a body in the world and returns a BodyRef to this body.
          * @note Body position, velocity and forces are set to (0, 0) by default and mass is set to 1 by default.
@@ -117,6 +741,15 @@ namespace PhysicsEngine
          */
         [[nodiscard]] BodyRef CreateBody() noexcept;
 
+        /**
+         * @brief CreateBodies is a method that creates several bodies in the world at once, the memory being
+         * allocated only once for all of them.
+         * @note Bodies are created as with CreateBody.
+         * @param count The number of bodies to create.
+         * @param bodyRefs The vector to which the BodyRefs of the new bodies are added.
+         */
+        void CreateBodies(std::size_t count, AllocVector<BodyRef>& bodyRefs) noexcept;
+
         /**
          * @brief DestroyBody is a method that destroys the body corresponding to the BodyRef given as a parameter.
          * @param bodyRef The BodyRef to the body to destroy.
@@ -144,6 +777,21 @@ namespace PhysicsEngine
          */
         [[nodiscard]] Collider& GetCollider(ColliderRef colliderRef);
 
+        /**
+         * @brief GetColliderProxy is a method that gives the proxy of the collider corresponding to the collider
+         * reference given in parameter, as calculated by the last update.
+         * @param colliderRef The collider reference to the collider.
+         * @return The proxy of the collider (see ColliderProxy).
+         */
+        [[nodiscard]] const ColliderProxy& GetColliderProxy(ColliderRef colliderRef) const;
+
+        /**
+         * @brief ColliderProxies is a method that gives the proxies of all the colliders calculated by the last
+         * update, indexed by collider index. Only the enabled proxies are valid.
+         * @return The proxies of the colliders.
+         */
+        [[nodiscard]] const AllocVector<ColliderProxy>& ColliderProxies() const noexcept { return _colliderProxies; }
+
         /**
         * @brief DestroyCollider is a method that destroys the collider corresponding to the collider reference
          * given in parameter.
@@ -159,11 +807,68 @@ namespace PhysicsEngine
          */
         [[nodiscard]] ColliderRef CreateCollider(BodyRef bodyRef) noexcept;
 
+        /**
+         * @brief CreateColliders is a method that creates one collider for each body reference given in parameter,
+         * the memory being allocated only once for all of them.
+         * @param bodyRefs The body references to the bodies on which the colliders would be attached.
+         * @param colliderRefs The vector to which the collider references of the new colliders are added,
+         * in the order of the body references.
+         */
+        void CreateColliders(const AllocVector<BodyRef>& bodyRefs, AllocVector<ColliderRef>& colliderRefs) noexcept;
+
+        /**
+         * @brief IsBroadPhasePersistent is a method that checks if the quad-tree is kept between the steps
+         * instead of being rebuilt from scratch each step.
+         * @return True if the broad phase is persistent.
+         */
+        [[nodiscard]] bool IsBroadPhasePersistent() const noexcept { return _quadTree.IsPersistent(); }
+
+        /**
+         * @brief SetBroadPhasePersistent is a method that sets if the quad-tree is kept between the steps
+         * (colliders are only reinserted when they leave their fat rectangle) or rebuilt from scratch each step.
+         * @param isPersistent Whether the broad phase is persistent or not.
+         */
+        void SetBroadPhasePersistent(bool isPersistent) noexcept { _quadTree.SetPersistent(isPersistent); }
+
+        /**
+         * @brief GetBroadPhaseType is a method that gives the type of the broad phase used by the world.
+         * @return The type of the broad phase used by the world.
+         */
+        [[nodiscard]] BroadPhaseType GetBroadPhaseType() const noexcept { return _broadPhaseType; }
+
+        /**
+         * @brief SetBroadPhaseType is a method that replaces the broad phase used by the world with the one
+         * of the type given in parameter.
+         * @note The previous broad phase is deinitialized and the new one is initialized.
+         * @param broadPhaseType The type of the new broad phase.
+         */
+        void SetBroadPhaseType(BroadPhaseType broadPhaseType) noexcept;
+
         /**
          * @brief QuadTree is a method that gives the quad-tree of the world.
          * @return The quad-tree of the world.
          */
         [[nodiscard]] const QuadTree& QuadTree() const noexcept { return _quadTree; };
+
+        /**
+         * @brief GetAabbTree is a method that gives the dynamic AABB tree of the world.
+         * @return The dynamic AABB tree of the world.
+         */
+        [[nodiscard]] const AabbTree& GetAabbTree() const noexcept { return _aabbTree; }
+
+        /**
+         * @brief SetSpatialHashCellSize is a method that replaces the size of the cells of the spatial hash
+         * broad phase with the one given in parameter, the values that are not positive and finite are ignored.
+         * @param cellSize The new size of the cells.
+         */
+        void SetSpatialHashCellSize(const float cellSize) noexcept { _spatialHash.SetCellSize(cellSize); }
+
+        /**
+         * @brief SetQuadTreeLooseness is a method that replaces the looseness of the quad-tree broad phase
+         * with the one given in parameter.
+         * @param looseness The new looseness, 1 for a tight quad-tree.
+         */
+        void SetQuadTreeLooseness(const float looseness) noexcept { _quadTree.SetLooseness(looseness); }
     };
 }
 
@@ -6,47 +6,85 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
 
 namespace PhysicsEngine
 {
     /**
-     * @brief BodyRef is a struct used to reference a specific body.
+     * @brief BodyRef is a struct used to reference a specific body. The index and the generation index are
+     * 32 bits each, so that a reference fits in a single 64-bit integer (see Handle).
      * @brief Attributes :
      * @brief Index : The index of the body inside the world body vector.
      * @brief GenerationIdx : The index inside the world generation number vector.
      */
     struct BodyRef
     {
-        std::size_t Index;
-        std::size_t GenerationIdx;
+        std::uint32_t Index = 0;
+        std::uint32_t GenerationIdx = 0;
+
+        constexpr BodyRef() noexcept = default;
+        constexpr BodyRef(const std::size_t index, const std::size_t generationIdx) noexcept :
+            Index(static_cast<std::uint32_t>(index)),
+            GenerationIdx(static_cast<std::uint32_t>(generationIdx))
+        {}
+
+        /**
+         * @brief Handle is a method that gives the reference packed in a single integer (aka the index in the
+         * 32 high bits and the generation index in the 32 low bits), so the handles are ordered as the references.
+         * @return The handle of the reference.
+         */
+        [[nodiscard]] constexpr std::uint64_t Handle() const noexcept
+        {
+            return static_cast<std::uint64_t>(Index) << 32 | GenerationIdx;
+        }
 
         constexpr bool operator==(const BodyRef& other) const noexcept
         {
-            return Index == other.Index && GenerationIdx == other.GenerationIdx;
+            return Handle() == other.Handle();
         }
     };
 
     /**
-     * @brief ColliderRef is a struct used to reference a specific collider.
+     * @brief ColliderRef is a struct used to reference a specific collider. The index and the generation index
+     * are 32 bits each, so that a reference fits in a single 64-bit integer (see Handle).
      * @brief Attributes :
      * @brief Index : The index of the collider inside the world colliders vector.
      * @brief GenerationIdx : The index inside the world colliders generation indices vector.
      */
     struct ColliderRef
     {
-        std::size_t Index;
-        std::size_t GenerationIdx;
+        std::uint32_t Index = 0;
+        std::uint32_t GenerationIdx = 0;
+
+        constexpr ColliderRef() noexcept = default;
+        constexpr ColliderRef(const std::size_t index, const std::size_t generationIdx) noexcept :
+            Index(static_cast<std::uint32_t>(index)),
+            GenerationIdx(static_cast<std::uint32_t>(generationIdx))
+        {}
 
         constexpr ColliderRef& operator=(const ColliderRef& colRef) noexcept = default;
 
+        /**
+         * @brief Handle is a method that gives the reference packed in a single integer (aka the index in the
+         * 32 high bits and the generation index in the 32 low bits), so the handles are ordered as the references.
+         * @return The handle of the reference.
+         */
+        [[nodiscard]] constexpr std::uint64_t Handle() const noexcept
+        {
+            return static_cast<std::uint64_t>(Index) << 32 | GenerationIdx;
+        }
+
         constexpr bool operator==(const ColliderRef& other) const noexcept
         {
-            return Index == other.Index && GenerationIdx == other.GenerationIdx;
+            return Handle() == other.Handle();
         }
 
         constexpr bool operator<(const ColliderRef& other) const noexcept
         {
-            return Index < other.Index || (Index == other.Index && GenerationIdx < other.GenerationIdx);
+            return Handle() < other.Handle();
         }
     };
-}
\ No newline at end of file
+
+    static_assert(sizeof(BodyRef) == sizeof(std::uint64_t), "A body reference must fit in 64 bits.");
+    static_assert(sizeof(ColliderRef) == sizeof(std::uint64_t), "A collider reference must fit in 64 bits.");
+}
@@ -0,0 +1,556 @@
+#include "AabbTree.h"
+
+#include <algorithm>
+
+#ifdef TRACY_ENABLE
+#include <Tracy.hpp>
+#endif // TRACY_ENABLE
+
+namespace PhysicsEngine
+{
+    /**
+     * @brief Union gives the smallest rectangle containing the two rectangles given in parameter.
+     */
+    [[nodiscard]] static Math::RectangleF Union(const Math::RectangleF& rectA, const Math::RectangleF& rectB) noexcept
+    {
+        const auto minA = rectA.MinBound(), maxA = rectA.MaxBound();
+        const auto minB = rectB.MinBound(), maxB = rectB.MaxBound();
+
+        return { Math::Vec2F(std::min(minA.X, minB.X), std::min(minA.Y, minB.Y)),
+                 Math::Vec2F(std::max(maxA.X, maxB.X), std::max(maxA.Y, maxB.Y)) };
+    }
+
+    /**
+     * @brief Perimeter gives the perimeter of the rectangle given in parameter.
+     */
+    [[nodiscard]] static float Perimeter(const Math::RectangleF& rect) noexcept
+    {
+        const auto size = rect.Size();
+
+        return 2.f * (size.X + size.Y);
+    }
+
+    void AabbTree::Init() noexcept
+    {
+    #ifdef TRACY_ENABLE
+            ZoneScoped;
+    #endif // TRACY_ENABLE
+
+        _nodes.reserve(_preallocatedNodeCount);
+        _queryStack.reserve(_preallocatedNodeCount);
+    }
+
+    int AabbTree::allocateNode() noexcept
+    {
+        // If the free list is empty, grow the pool and link the new nodes in the free list.
+        if (_freeList == AabbNode::Null)
+        {
+            const auto oldSize = static_cast<int>(_nodes.size());
+            const auto newSize = std::max(oldSize * 2, _preallocatedNodeCount);
+
+            _nodes.resize(newSize);
+
+            for (int i = oldSize; i < newSize - 1; i++)
+            {
+                _nodes[i].Parent = i + 1;
+                _nodes[i].Height = -1;
+            }
+
+            _nodes[newSize - 1].Parent = AabbNode::Null;
+            _nodes[newSize - 1].Height = -1;
+
+            _freeList = oldSize;
+        }
+
+        const int nodeIndex = _freeList;
+        auto& node = _nodes[nodeIndex];
+
+        _freeList = node.Parent;
+
+        node.Parent = AabbNode::Null;
+        node.Child1 = AabbNode::Null;
+        node.Child2 = AabbNode::Null;
+        node.Height = 0;
+
+        return nodeIndex;
+    }
+
+    void AabbTree::freeNode(const int nodeIndex) noexcept
+    {
+        auto& node = _nodes[nodeIndex];
+
+        node.Parent = _freeList;
+        node.Child1 = AabbNode::Null;
+        node.Child2 = AabbNode::Null;
+        node.Height = -1;
+
+        _freeList = nodeIndex;
+    }
+
+    void AabbTree::insertLeaf(const int leaf) noexcept
+    {
+        if (_root == AabbNode::Null)
+        {
+            _root = leaf;
+            _nodes[_root].Parent = AabbNode::Null;
+            return;
+        }
+
+        // Find the best sibling for the leaf (aka the one that increases the least the perimeter of the tree).
+        const auto leafAabb = _nodes[leaf].Aabb;
+        int index = _root;
+
+        while (!_nodes[index].IsLeaf())
+        {
+            const auto& node = _nodes[index];
+            const int child1 = node.Child1;
+            const int child2 = node.Child2;
+
+            const float perimeter = Perimeter(node.Aabb);
+            const float combinedPerimeter = Perimeter(Union(node.Aabb, leafAabb));
+
+            // Cost of creating a new parent for this node and the new leaf.
+            const float cost = 2.f * combinedPerimeter;
+
+            // Minimum cost of pushing the leaf further down the tree.
+            const float inheritanceCost = 2.f * (combinedPerimeter - perimeter);
+
+            const auto descentCost = [this, &leafAabb, inheritanceCost](const int child)
+            {
+                const auto& childNode = _nodes[child];
+                const float childCombinedPerimeter = Perimeter(Union(leafAabb, childNode.Aabb));
+
+                if (childNode.IsLeaf())
+                {
+                    return childCombinedPerimeter + inheritanceCost;
+                }
+
+                return childCombinedPerimeter - Perimeter(childNode.Aabb) + inheritanceCost;
+            };
+
+            const float cost1 = descentCost(child1);
+            const float cost2 = descentCost(child2);
+
+            if (cost < cost1 && cost < cost2) break;
+
+            index = cost1 < cost2 ? child1 : child2;
+        }
+
+        const int sibling = index;
+
+        // Create a new parent for the sibling and the leaf.
+        const int newParent = allocateNode();
+        const int oldParent = _nodes[sibling].Parent;
+
+        auto& newParentNode = _nodes[newParent];
+        newParentNode.Parent = oldParent;
+        newParentNode.Aabb = Union(leafAabb, _nodes[sibling].Aabb);
+        newParentNode.Height = _nodes[sibling].Height + 1;
+        newParentNode.Child1 = sibling;
+        newParentNode.Child2 = leaf;
+
+        _nodes[sibling].Parent = newParent;
+        _nodes[leaf].Parent = newParent;
+
+        if (oldParent != AabbNode::Null)
+        {
+            auto& oldParentNode = _nodes[oldParent];
+
+            if (oldParentNode.Child1 == sibling)
+            {
+                oldParentNode.Child1 = newParent;
+            }
+            else
+            {
+                oldParentNode.Child2 = newParent;
+            }
+        }
+        else
+        {
+            _root = newParent;
+        }
+
+        fixUpwards(_nodes[leaf].Parent);
+    }
+
+    void AabbTree::removeLeaf(const int leaf) noexcept
+    {
+        if (leaf == _root)
+        {
+            _root = AabbNode::Null;
+            return;
+        }
+
+        const int parent = _nodes[leaf].Parent;
+        const int grandParent = _nodes[parent].Parent;
+        const int sibling = _nodes[parent].Child1 == leaf ? _nodes[parent].Child2 : _nodes[parent].Child1;
+
+        // The sibling takes the place of the parent.
+        if (grandParent != AabbNode::Null)
+        {
+            auto& grandParentNode = _nodes[grandParent];
+
+            if (grandParentNode.Child1 == parent)
+            {
+                grandParentNode.Child1 = sibling;
+            }
+            else
+            {
+                grandParentNode.Child2 = sibling;
+            }
+
+            _nodes[sibling].Parent = grandParent;
+            freeNode(parent);
+
+            fixUpwards(grandParent);
+        }
+        else
+        {
+            _root = sibling;
+            _nodes[sibling].Parent = AabbNode::Null;
+            freeNode(parent);
+        }
+
+        _nodes[leaf].Parent = AabbNode::Null;
+    }
+
+    void AabbTree::fixUpwards(int nodeIndex) noexcept
+    {
+        while (nodeIndex != AabbNode::Null)
+        {
+            nodeIndex = balance(nodeIndex);
+
+            auto& node = _nodes[nodeIndex];
+            const auto& child1 = _nodes[node.Child1];
+            const auto& child2 = _nodes[node.Child2];
+
+            node.Height = 1 + std::max(child1.Height, child2.Height);
+            node.Aabb = Union(child1.Aabb, child2.Aabb);
+
+            nodeIndex = node.Parent;
+        }
+    }
+
+    int AabbTree::balance(const int nodeIndex) noexcept
+    {
+        auto& a = _nodes[nodeIndex];
+
+        if (a.IsLeaf() || a.Height < 2) return nodeIndex;
+
+        const int iB = a.Child1;
+        const int iC = a.Child2;
+        auto& b = _nodes[iB];
+        auto& c = _nodes[iC];
+
+        const int heightDifference = c.Height - b.Height;
+
+        // The parent of the node must point to the child which takes its place.
+        const auto replaceInParent = [this, nodeIndex](const int parent, const int newChild)
+        {
+            if (parent == AabbNode::Null)
+            {
+                _root = newChild;
+            }
+            else if (_nodes[parent].Child1 == nodeIndex)
+            {
+                _nodes[parent].Child1 = newChild;
+            }
+            else
+            {
+                _nodes[parent].Child2 = newChild;
+            }
+        };
+
+        // Rotate C up.
+        if (heightDifference > 1)
+        {
+            const int iF = c.Child1;
+            const int iG = c.Child2;
+            auto& f = _nodes[iF];
+            auto& g = _nodes[iG];
+
+            c.Child1 = nodeIndex;
+            c.Parent = a.Parent;
+            a.Parent = iC;
+            replaceInParent(c.Parent, iC);
+
+            // The highest grandchild stays under C, the other one goes under A.
+            if (f.Height > g.Height)
+            {
+                c.Child2 = iF;
+                a.Child2 = iG;
+                g.Parent = nodeIndex;
+                a.Aabb = Union(b.Aabb, g.Aabb);
+                c.Aabb = Union(a.Aabb, f.Aabb);
+
+                a.Height = 1 + std::max(b.Height, g.Height);
+                c.Height = 1 + std::max(a.Height, f.Height);
+            }
+            else
+            {
+                c.Child2 = iG;
+                a.Child2 = iF;
+                f.Parent = nodeIndex;
+                a.Aabb = Union(b.Aabb, f.Aabb);
+                c.Aabb = Union(a.Aabb, g.Aabb);
+
+                a.Height = 1 + std::max(b.Height, f.Height);
+                c.Height = 1 + std::max(a.Height, g.Height);
+            }
+
+            return iC;
+        }
+
+        // Rotate B up.
+        if (heightDifference < -1)
+        {
+            const int iD = b.Child1;
+            const int iE = b.Child2;
+            auto& d = _nodes[iD];
+            auto& e = _nodes[iE];
+
+            b.Child1 = nodeIndex;
+            b.Parent = a.Parent;
+            a.Parent = iB;
+            replaceInParent(b.Parent, iB);
+
+            // The highest grandchild stays under B, the other one goes under A.
+            if (d.Height > e.Height)
+            {
+                b.Child2 = iD;
+                a.Child1 = iE;
+                e.Parent = nodeIndex;
+                a.Aabb = Union(c.Aabb, e.Aabb);
+                b.Aabb = Union(a.Aabb, d.Aabb);
+
+                a.Height = 1 + std::max(c.Height, e.Height);
+                b.Height = 1 + std::max(a.Height, d.Height);
+            }
+            else
+            {
+                b.Child2 = iE;
+                a.Child1 = iD;
+                d.Parent = nodeIndex;
+                a.Aabb = Union(c.Aabb, d.Aabb);
+                b.Aabb = Union(a.Aabb, e.Aabb);
+
+                a.Height = 1 + std::max(c.Height, d.Height);
+                b.Height = 1 + std::max(a.Height, e.Height);
+            }
+
+            return iB;
+        }
+
+        return nodeIndex;
+    }
+
+    void AabbTree::markMoved(const std::size_t proxyIndex) noexcept
+    {
+        auto& proxy = _proxies[proxyIndex];
+
+        if (proxy.Moved) return;
+
+        proxy.Moved = true;
+        _movedProxies.push_back(proxyIndex);
+    }
+
+    bool AabbTree::isProxyStale(const ColliderRef colliderRef) const noexcept
+    {
+        if (colliderRef.Index >= _proxies.size()) return true;
+
+        const auto& proxy = _proxies[colliderRef.Index];
+
+        return proxy.Leaf == AabbNode::Null || proxy.Moved || !(proxy.ColRef == colliderRef);
+    }
+
+    void AabbTree::updateProxy(const SimplifiedCollider& simplCol) noexcept
+    {
+        const auto colliderRef = simplCol.ColRef;
+
+        if (colliderRef.Index >= _proxies.size())
+        {
+            _proxies.resize(colliderRef.Index + 1);
+        }
+
+        auto& proxy = _proxies[colliderRef.Index];
+        proxy.Updated = true;
+
+        // The index is used by another collider, the leaf of the old one must be removed.
+        if (proxy.Leaf != AabbNode::Null && !(proxy.ColRef == colliderRef))
+        {
+            removeProxy(proxy);
+        }
+
+        const Math::Vec2F margin(_fatMargin, _fatMargin);
+        const Math::RectangleF fatRectangle(simplCol.Rectangle.MinBound() - margin,
+                                            simplCol.Rectangle.MaxBound() + margin);
+
+        if (proxy.Leaf == AabbNode::Null)
+        {
+            const int leaf = allocateNode();
+            _nodes[leaf].Aabb = fatRectangle;
+            _nodes[leaf].ColRef = colliderRef;
+
+            proxy.ColRef = colliderRef;
+            proxy.Leaf = leaf;
+
+            insertLeaf(leaf);
+            markMoved(colliderRef.Index);
+            return;
+        }
+
+        // The collider stays in its leaf as long as its simplified shape is inside its fat rectangle.
+        if (_nodes[proxy.Leaf].Aabb.Contains(simplCol.Rectangle)) return;
+
+        removeLeaf(proxy.Leaf);
+        _nodes[proxy.Leaf].Aabb = fatRectangle;
+        insertLeaf(proxy.Leaf);
+
+        markMoved(colliderRef.Index);
+    }
+
+    void AabbTree::removeProxy(AabbProxy& proxy) noexcept
+    {
+        removeLeaf(proxy.Leaf);
+        freeNode(proxy.Leaf);
+
+        proxy.Leaf = AabbNode::Null;
+
+        _hasRemovedProxies = true;
+    }
+
+    void AabbTree::Update(const AllocVector<SimplifiedCollider>& colliders) noexcept
+    {
+    #ifdef TRACY_ENABLE
+            ZoneScoped;
+            ZoneValue(colliders.size());
+    #endif // TRACY_ENABLE
+
+        for (const auto& simplCol : colliders)
+        {
+            updateProxy(simplCol);
+        }
+
+        // The colliders that were not given anymore have been disabled or destroyed.
+        for (auto& proxy : _proxies)
+        {
+            if (proxy.Leaf != AabbNode::Null && !proxy.Updated)
+            {
+                removeProxy(proxy);
+            }
+
+            proxy.Updated = false;
+        }
+
+        if (!_movedProxies.empty() || _hasRemovedProxies)
+        {
+        #ifdef TRACY_ENABLE
+                ZoneNamedN(UpdatePossiblePairs, "UpdatePossiblePairs", true);
+                ZoneValue(_movedProxies.size());
+        #endif // TRACY_ENABLE
+
+            // Remove the pairs whose colliders have moved or have been removed.
+            _possiblePairs.erase(std::remove_if(_possiblePairs.begin(), _possiblePairs.end(),
+                                                [this](const ColliderPair& pair)
+                                                {
+                                                    return isProxyStale(pair.ColliderA) ||
+                                                           isProxyStale(pair.ColliderB);
+                                                }),
+                                 _possiblePairs.end());
+
+            for (const auto proxyIndex : _movedProxies)
+            {
+                const auto& proxy = _proxies[proxyIndex];
+
+                if (proxy.Leaf == AabbNode::Null) continue;
+
+                queryPossiblePairs(proxy);
+            }
+        }
+
+        for (const auto proxyIndex : _movedProxies)
+        {
+            _proxies[proxyIndex].Moved = false;
+        }
+
+        _movedProxies.clear();
+        _hasRemovedProxies = false;
+    }
+
+    void AabbTree::queryPossiblePairs(const AabbProxy& proxy) noexcept
+    {
+        const auto& fatRectangle = _nodes[proxy.Leaf].Aabb;
+
+        _queryStack.clear();
+        _queryStack.push_back(_root);
+
+        while (!_queryStack.empty())
+        {
+            const int nodeIndex = _queryStack.back();
+            _queryStack.pop_back();
+
+            const auto& node = _nodes[nodeIndex];
+
+            if (!Math::Intersect(node.Aabb, fatRectangle)) continue;
+
+            if (!node.IsLeaf())
+            {
+                _queryStack.push_back(node.Child1);
+                _queryStack.push_back(node.Child2);
+                continue;
+            }
+
+            if (nodeIndex == proxy.Leaf) continue;
+
+            // If both colliders have moved, the pair is only added by the collider with the lowest index.
+            const auto& otherProxy = _proxies[node.ColRef.Index];
+
+            if (otherProxy.Moved && otherProxy.ColRef.Index < proxy.ColRef.Index) continue;
+
+            _possiblePairs.push_back(ColliderPair{ proxy.ColRef, node.ColRef });
+        }
+    }
+
+    void AabbTree::Clear() noexcept
+    {
+    #ifdef TRACY_ENABLE
+            ZoneScoped;
+    #endif // TRACY_ENABLE
+
+        // Link all the nodes of the pool in the free list.
+        const auto nodeCount = static_cast<int>(_nodes.size());
+
+        for (int i = 0; i < nodeCount; i++)
+        {
+            _nodes[i].Parent = i + 1 < nodeCount ? i + 1 : AabbNode::Null;
+            _nodes[i].Child1 = AabbNode::Null;
+            _nodes[i].Child2 = AabbNode::Null;
+            _nodes[i].Height = -1;
+        }
+
+        _freeList = nodeCount > 0 ? 0 : AabbNode::Null;
+        _root = AabbNode::Null;
+
+        _proxies.clear();
+        _movedProxies.clear();
+        _possiblePairs.clear();
+        _hasRemovedProxies = false;
+    }
+
+    void AabbTree::Deinit() noexcept
+    {
+    #ifdef TRACY_ENABLE
+            ZoneScoped;
+    #endif // TRACY_ENABLE
+
+        _nodes.clear();
+        _proxies.clear();
+        _movedProxies.clear();
+        _possiblePairs.clear();
+        _queryStack.clear();
+
+        _root = AabbNode::Null;
+        _freeList = AabbNode::Null;
+        _hasRemovedProxies = false;
+    }
+}
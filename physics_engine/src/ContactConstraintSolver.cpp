@@ -0,0 +1,831 @@
+#include "ContactConstraintSolver.h"
+
+#include <algorithm>
+
+#ifdef __SSE__
+#include <xmmintrin.h>
+#endif // __SSE__
+
+#ifdef TRACY_ENABLE
+#include <Tracy.hpp>
+#endif // TRACY_ENABLE
+
+namespace PhysicsEngine
+{
+    ContactConstraintSoA::ContactConstraintSoA(Allocator& allocator) noexcept :
+        NormalsX{ StandardAllocator<float>{allocator} },
+        NormalsY{ StandardAllocator<float>{allocator} },
+        InverseMassesA{ StandardAllocator<float>{allocator} },
+        InverseMassesB{ StandardAllocator<float>{allocator} },
+        NormalMasses{ StandardAllocator<float>{allocator} },
+        VelocityBiases{ StandardAllocator<float>{allocator} },
+        FirstNormalImpulses{ StandardAllocator<float>{allocator} },
+        SecondNormalImpulses{ StandardAllocator<float>{allocator} },
+        PointCounts{ StandardAllocator<float>{allocator} },
+        BodyIndicesA{ StandardAllocator<std::size_t>{allocator} },
+        BodyIndicesB{ StandardAllocator<std::size_t>{allocator} }
+    {}
+
+    void ContactConstraintSoA::Resize(const std::size_t count) noexcept
+    {
+        NormalsX.resize(count);
+        NormalsY.resize(count);
+        InverseMassesA.resize(count);
+        InverseMassesB.resize(count);
+        NormalMasses.resize(count);
+        VelocityBiases.resize(count);
+        FirstNormalImpulses.resize(count);
+        SecondNormalImpulses.resize(count);
+        PointCounts.resize(count);
+        BodyIndicesA.resize(count);
+        BodyIndicesB.resize(count);
+    }
+
+    void ContactConstraintSoA::Clear() noexcept
+    {
+        Resize(0);
+    }
+
+    ContactConstraintSolver::ContactConstraintSolver(Allocator& allocator) noexcept :
+        _constraints{ StandardAllocator<ContactConstraint>{allocator} },
+        _previousConstraints{ StandardAllocator<ContactConstraint>{allocator} },
+        _velocityChanges{ StandardAllocator<Math::Vec2F>{allocator} },
+        _solveOrder{ StandardAllocator<std::size_t>{allocator} },
+        _solverIslands{ StandardAllocator<SolverIsland>{allocator} },
+        _solverTasks{ StandardAllocator<SolverTask>{allocator} },
+        _bodyColorMasks{ StandardAllocator<std::uint64_t>{allocator} },
+        _constraintColors{ StandardAllocator<std::size_t>{allocator} },
+        _colorOrder{ StandardAllocator<std::size_t>{allocator} },
+        _solverColors{ StandardAllocator<SolverColor>{allocator} },
+        _constraintSoA{ allocator }
+    {}
+
+    void ContactConstraintSolver::BeginStep(const std::size_t contactCount) noexcept
+    {
+        _previousConstraints.swap(_constraints);
+        _constraints.clear();
+        _constraints.reserve(contactCount);
+    }
+
+    void ContactConstraintSolver::AddContact(const ColliderPair& pair,
+                                             const std::size_t bodyIndexA,
+                                             const std::size_t bodyIndexB,
+                                             const float restitution,
+                                             const ContactManifold& manifold) noexcept
+    {
+        if (manifold.PointCount <= 0) return;
+
+        ContactConstraint constraint;
+        constraint.Pair = pair;
+        constraint.BodyIndexA = bodyIndexA;
+        constraint.BodyIndexB = bodyIndexB;
+        constraint.Normal = manifold.Normal;
+        constraint.PointCount = manifold.PointCount;
+        constraint.Penetration = manifold.Penetration;
+        constraint.Restitution = restitution;
+
+        for (int i = 0; i < manifold.PointCount; i++)
+        {
+            constraint.Points[i].Point = manifold.Points[i];
+        }
+
+        const auto key = pair.Key();
+        const auto previous = std::lower_bound(_previousConstraints.begin(), _previousConstraints.end(), key,
+                                               [](const ContactConstraint& previousConstraint, const std::uint64_t k)
+                                               {
+                                                   return previousConstraint.Pair.Key() < k;
+                                               });
+
+        // The keys only contain the indices, the pair must also have the same generations to be the same.
+        if (previous != _previousConstraints.end() && previous->Pair == pair)
+        {
+            // The impulses are only kept if the normal has not turned much, its direction depends on the order
+            // of the colliders.
+            const auto sign = previous->Pair.ColliderA == pair.ColliderA ? 1.f : -1.f;
+
+            if ((previous->Normal * sign).Dot(manifold.Normal) >= WarmStartNormalTolerance)
+            {
+                // The manifold kernels always give the points in the same order for the same normal.
+                const auto pointCount = std::min(previous->PointCount, constraint.PointCount);
+
+                for (int i = 0; i < pointCount; i++)
+                {
+                    constraint.Points[i].NormalImpulse = previous->Points[i].NormalImpulse;
+                }
+            }
+        }
+
+        _constraints.push_back(constraint);
+    }
+
+    void ContactConstraintSolver::Solve(AllocVector<Body>& bodies, const float deltaTime) noexcept
+    {
+    #ifdef TRACY_ENABLE
+            ZoneScoped;
+            ZoneValue(_constraints.size());
+    #endif
+
+        if (_velocityChanges.size() < bodies.size()) _velocityChanges.resize(bodies.size(), Math::Vec2F::Zero());
+
+        _solveOrder.resize(_constraints.size());
+
+        for (std::size_t i = 0; i < _constraints.size(); i++)
+        {
+            _solveOrder[i] = i;
+        }
+
+        _solverIslands.clear();
+        _solverTasks.clear();
+        _coloredIslandCount = 0;
+
+        solveIsland(bodies, SolverIsland{ 0, _constraints.size() }, deltaTime);
+    }
+
+    void ContactConstraintSolver::Solve(AllocVector<Body>& bodies,
+                                        const float deltaTime,
+                                        const IslandGraph& islandGraph,
+                                        JobSystem* jobSystem,
+                                        const SimdLevel kernel) noexcept
+    {
+    #ifdef TRACY_ENABLE
+            ZoneScoped;
+            ZoneValue(_constraints.size());
+    #endif
+
+        // Everything is allocated here so that the jobs never allocate.
+        if (_velocityChanges.size() < bodies.size()) _velocityChanges.resize(bodies.size(), Math::Vec2F::Zero());
+
+        groupByIsland(islandGraph);
+
+        // The large islands are solved one by one, each of their colors being solved in parallel.
+        for (std::size_t i = 0; i < _coloredIslandCount; i++)
+        {
+            solveColoredIsland(bodies, _solverIslands[i], deltaTime, jobSystem, kernel);
+        }
+
+        const auto solveTask = [this, &bodies, deltaTime](const std::size_t taskIdx)
+        {
+            const auto& task = _solverTasks[taskIdx];
+
+            for (std::size_t i = task.IslandBegin; i < task.IslandBegin + task.IslandCount; i++)
+            {
+                solveIsland(bodies, _solverIslands[i], deltaTime);
+            }
+        };
+
+        if (jobSystem == nullptr || jobSystem->WorkerCount() == 0 || _solverTasks.size() < 2)
+        {
+            for (std::size_t i = 0; i < _solverTasks.size(); i++)
+            {
+                solveTask(i);
+            }
+        }
+        else
+        {
+            // The jobs are taken in index order, so the largest islands start first.
+            jobSystem->ParallelFor(_solverTasks.size(), solveTask);
+        }
+    }
+
+    void ContactConstraintSolver::groupByIsland(const IslandGraph& islandGraph) noexcept
+    {
+        const auto islandCount = islandGraph.Islands().size();
+
+        // A constraint is in the island of its dynamic bodies, the constraints without any don't move anything.
+        const auto islandOf = [&islandGraph](const ContactConstraint& constraint)
+        {
+            const auto islandA = islandGraph.IslandOf(constraint.BodyIndexA);
+
+            return islandA != IslandGraph::NoIsland ? islandA : islandGraph.IslandOf(constraint.BodyIndexB);
+        };
+
+        _solverIslands.assign(islandCount, SolverIsland{});
+
+        for (const auto& constraint : _constraints)
+        {
+            const auto islandIdx = islandOf(constraint);
+
+            if (islandIdx != IslandGraph::NoIsland) _solverIslands[islandIdx].ConstraintCount++;
+        }
+
+        std::size_t constraintBegin = 0;
+
+        for (auto& island : _solverIslands)
+        {
+            island.ConstraintBegin = constraintBegin;
+            constraintBegin += island.ConstraintCount;
+            island.ConstraintCount = 0;
+        }
+
+        // The constraints stay in key order in each island, as in a solve of all of them together.
+        _solveOrder.resize(constraintBegin);
+
+        for (std::size_t i = 0; i < _constraints.size(); i++)
+        {
+            const auto islandIdx = islandOf(_constraints[i]);
+
+            if (islandIdx == IslandGraph::NoIsland) continue;
+
+            auto& island = _solverIslands[islandIdx];
+            _solveOrder[island.ConstraintBegin + island.ConstraintCount] = i;
+            island.ConstraintCount++;
+        }
+
+        _solverIslands.erase(std::remove_if(_solverIslands.begin(), _solverIslands.end(),
+                                            [](const SolverIsland& island)
+                                            {
+                                                return island.ConstraintCount == 0;
+                                            }), _solverIslands.end());
+
+        std::stable_sort(_solverIslands.begin(), _solverIslands.end(),
+                         [](const SolverIsland& islandA, const SolverIsland& islandB)
+                         {
+                             return islandA.ConstraintCount > islandB.ConstraintCount;
+                         });
+
+        _coloredIslandCount = 0;
+
+        if (_mode == ContactSolverMode::GraphColored)
+        {
+            while (_coloredIslandCount < _solverIslands.size() &&
+                   _solverIslands[_coloredIslandCount].ConstraintCount >= _graphColoringConstraintCount)
+            {
+                _coloredIslandCount++;
+            }
+        }
+
+        // The large islands have their own job, the small ones are batched until they are large enough together.
+        _solverTasks.clear();
+
+        for (std::size_t i = _coloredIslandCount; i < _solverIslands.size();)
+        {
+            SolverTask task{ i, 0 };
+            std::size_t taskConstraintCount = 0;
+
+            while (i < _solverIslands.size() && taskConstraintCount < IslandBatchConstraintCount)
+            {
+                taskConstraintCount += _solverIslands[i].ConstraintCount;
+                task.IslandCount++;
+                i++;
+            }
+
+            _solverTasks.push_back(task);
+        }
+    }
+
+    void ContactConstraintSolver::colorConstraints(const std::size_t begin, const std::size_t end) noexcept
+    {
+    #ifdef TRACY_ENABLE
+            ZoneScoped;
+            ZoneValue(end - begin);
+    #endif
+
+        std::array<std::size_t, MaxColorCount + 1> colorCounts{};
+        _constraintColors.resize(end - begin);
+
+        // The constraints take the first color that none of their dynamic bodies uses yet, in key order so that
+        // the coloring is the same from one run to the other. The bodies that are not dynamic are never written,
+        // so they can be in every color.
+        for (std::size_t i = begin; i < end; i++)
+        {
+            const auto& constraint = _constraints[_solveOrder[i]];
+            const auto maskA = constraint.InverseMassA > 0.f ? _bodyColorMasks[constraint.BodyIndexA] : 0;
+            const auto maskB = constraint.InverseMassB > 0.f ? _bodyColorMasks[constraint.BodyIndexB] : 0;
+            const auto usedColors = maskA | maskB;
+
+            std::size_t color = 0;
+
+            while (color < MaxColorCount && (usedColors & (std::uint64_t{ 1 } << color)) != 0)
+            {
+                color++;
+            }
+
+            if (color < MaxColorCount)
+            {
+                const auto colorBit = std::uint64_t{ 1 } << color;
+
+                if (constraint.InverseMassA > 0.f) _bodyColorMasks[constraint.BodyIndexA] |= colorBit;
+                if (constraint.InverseMassB > 0.f) _bodyColorMasks[constraint.BodyIndexB] |= colorBit;
+            }
+
+            _constraintColors[i - begin] = color;
+            colorCounts[color]++;
+        }
+
+        _solverColors.clear();
+
+        std::array<std::size_t, MaxColorCount + 1> colorBegins{};
+        std::size_t colorBegin = begin;
+
+        for (std::size_t color = 0; color <= MaxColorCount; color++)
+        {
+            colorBegins[color] = colorBegin;
+
+            if (colorCounts[color] == 0) continue;
+
+            _solverColors.push_back(SolverColor{ colorBegin, colorCounts[color], color == MaxColorCount });
+            colorBegin += colorCounts[color];
+        }
+
+        // The constraints keep their key order in each color.
+        _colorOrder.resize(end - begin);
+
+        for (std::size_t i = begin; i < end; i++)
+        {
+            const auto color = _constraintColors[i - begin];
+
+            _colorOrder[colorBegins[color] - begin] = _solveOrder[i];
+            colorBegins[color]++;
+
+            const auto& constraint = _constraints[_solveOrder[i]];
+            _bodyColorMasks[constraint.BodyIndexA] = 0;
+            _bodyColorMasks[constraint.BodyIndexB] = 0;
+        }
+
+        std::copy(_colorOrder.begin(), _colorOrder.end(), _solveOrder.begin() + static_cast<std::ptrdiff_t>(begin));
+    }
+
+    void ContactConstraintSolver::solveColoredIsland(AllocVector<Body>& bodies,
+                                                     const SolverIsland& island,
+                                                     const float deltaTime,
+                                                     JobSystem* jobSystem,
+                                                     const SimdLevel kernel) noexcept
+    {
+    #ifdef TRACY_ENABLE
+            ZoneScoped;
+            ZoneValue(island.ConstraintCount);
+    #endif
+
+        const auto begin = island.ConstraintBegin, end = island.ConstraintBegin + island.ConstraintCount;
+
+        if (_bodyColorMasks.size() < bodies.size()) _bodyColorMasks.resize(bodies.size(), 0);
+
+        prepareConstraints(bodies, begin, end);
+        colorConstraints(begin, end);
+
+        auto& soa = _constraintSoA;
+        soa.Resize(island.ConstraintCount);
+
+        for (std::size_t i = begin; i < end; i++)
+        {
+            const auto& constraint = _constraints[_solveOrder[i]];
+            const auto k = i - begin;
+
+            soa.NormalsX[k] = constraint.Normal.X;
+            soa.NormalsY[k] = constraint.Normal.Y;
+            soa.InverseMassesA[k] = constraint.InverseMassA;
+            soa.InverseMassesB[k] = constraint.InverseMassB;
+            soa.NormalMasses[k] = constraint.NormalMass;
+            soa.VelocityBiases[k] = constraint.VelocityBias;
+            soa.FirstNormalImpulses[k] = constraint.Points[0].NormalImpulse;
+            soa.SecondNormalImpulses[k] = constraint.Points[1].NormalImpulse;
+            soa.PointCounts[k] = static_cast<float>(constraint.PointCount);
+            soa.BodyIndicesA[k] = constraint.BodyIndexA;
+            soa.BodyIndicesB[k] = constraint.BodyIndexB;
+        }
+
+        // The constraints of a color don't share any dynamic body, so its chunks are solved in parallel. The shared
+        // constraints are solved in one chunk.
+        const auto runColors = [this, jobSystem](const auto& solveChunk)
+        {
+            for (const auto& color : _solverColors)
+            {
+                const auto colorEnd = color.ConstraintBegin + color.ConstraintCount;
+                const auto chunkCount = color.IsShared ? 1 :
+                                        (color.ConstraintCount + ColorChunkConstraintCount - 1) / ColorChunkConstraintCount;
+
+                if (jobSystem == nullptr || jobSystem->WorkerCount() == 0 || chunkCount < 2)
+                {
+                    solveChunk(color, color.ConstraintBegin, colorEnd);
+                    continue;
+                }
+
+                jobSystem->ParallelFor(chunkCount, [&color, colorEnd, &solveChunk](const std::size_t chunkIdx)
+                {
+                    const auto chunkBegin = color.ConstraintBegin + chunkIdx * ColorChunkConstraintCount;
+
+                    solveChunk(color, chunkBegin, std::min(chunkBegin + ColorChunkConstraintCount, colorEnd));
+                });
+            }
+        };
+
+        for (int i = 0; i < _velocityIterationCount; i++)
+        {
+            runColors([this, &bodies, begin, kernel](const SolverColor& color,
+                                                     const std::size_t chunkBegin,
+                                                     const std::size_t chunkEnd)
+            {
+                // The lanes of the SIMD kernels must not share any dynamic body.
+                solveVelocitiesSoA(bodies, chunkBegin - begin, chunkEnd - begin,
+                                   color.IsShared ? SimdLevel::Scalar : kernel);
+            });
+        }
+
+        // The impulses are kept in the constraints to warm-start the next step.
+        for (std::size_t i = begin; i < end; i++)
+        {
+            auto& constraint = _constraints[_solveOrder[i]];
+
+            constraint.Points[0].NormalImpulse = soa.FirstNormalImpulses[i - begin];
+            constraint.Points[1].NormalImpulse = soa.SecondNormalImpulses[i - begin];
+        }
+
+        correctIntegratedPositions(bodies, begin, end, deltaTime);
+
+        for (int i = 0; i < _positionIterationCount; i++)
+        {
+            runColors([this, &bodies](const SolverColor&, const std::size_t chunkBegin, const std::size_t chunkEnd)
+            {
+                solvePositions(bodies, chunkBegin, chunkEnd);
+            });
+        }
+    }
+
+#ifdef __SSE__
+
+    /**
+     * @brief SolveVelocitiesSse runs one velocity iteration over the constraints of the SoA 4 by 4 and gives the
+     * index of the first constraint that has not been solved. The operations are the ones of the scalar solve,
+     * in the same order.
+     * @note The constraints of the 4 lanes must not share any dynamic body.
+     */
+    static std::size_t SolveVelocitiesSse(AllocVector<Body>& bodies, AllocVector<Math::Vec2F>& velocityChanges,
+                                          ContactConstraintSoA& soa, std::size_t begin, std::size_t end) noexcept
+    {
+        const __m128 zeros = _mm_setzero_ps();
+        const __m128 ones = _mm_set1_ps(1.f);
+
+        std::size_t i = begin;
+
+        for (; i + 4 <= end; i += 4)
+        {
+            alignas(16) std::array<float, 4> velocitiesAX{}, velocitiesAY{}, velocitiesBX{}, velocitiesBY{};
+            alignas(16) std::array<float, 4> changesAX{}, changesAY{}, changesBX{}, changesBY{};
+
+            for (std::size_t lane = 0; lane < 4; lane++)
+            {
+                const auto velocityA = bodies[soa.BodyIndicesA[i + lane]].Velocity();
+                const auto velocityB = bodies[soa.BodyIndicesB[i + lane]].Velocity();
+                const auto changeA = velocityChanges[soa.BodyIndicesA[i + lane]];
+                const auto changeB = velocityChanges[soa.BodyIndicesB[i + lane]];
+
+                velocitiesAX[lane] = velocityA.X;
+                velocitiesAY[lane] = velocityA.Y;
+                velocitiesBX[lane] = velocityB.X;
+                velocitiesBY[lane] = velocityB.Y;
+                changesAX[lane] = changeA.X;
+                changesAY[lane] = changeA.Y;
+                changesBX[lane] = changeB.X;
+                changesBY[lane] = changeB.Y;
+            }
+
+            __m128 velocityAX = _mm_load_ps(velocitiesAX.data()), velocityAY = _mm_load_ps(velocitiesAY.data());
+            __m128 velocityBX = _mm_load_ps(velocitiesBX.data()), velocityBY = _mm_load_ps(velocitiesBY.data());
+            __m128 changeAX = _mm_load_ps(changesAX.data()), changeAY = _mm_load_ps(changesAY.data());
+            __m128 changeBX = _mm_load_ps(changesBX.data()), changeBY = _mm_load_ps(changesBY.data());
+
+            const __m128 normalX = _mm_loadu_ps(soa.NormalsX.data() + i);
+            const __m128 normalY = _mm_loadu_ps(soa.NormalsY.data() + i);
+            const __m128 inverseMassA = _mm_loadu_ps(soa.InverseMassesA.data() + i);
+            const __m128 negativeInverseMassB = _mm_sub_ps(zeros, _mm_loadu_ps(soa.InverseMassesB.data() + i));
+            const __m128 normalMass = _mm_loadu_ps(soa.NormalMasses.data() + i);
+            const __m128 velocityBias = _mm_loadu_ps(soa.VelocityBiases.data() + i);
+            const __m128 pointCount = _mm_loadu_ps(soa.PointCounts.data() + i);
+            const __m128 hasMass = _mm_cmpgt_ps(normalMass, zeros);
+
+            std::array<float*, 2> impulses{ soa.FirstNormalImpulses.data() + i, soa.SecondNormalImpulses.data() + i };
+            __m128 pointIdx = zeros;
+
+            for (float* impulsePtr : impulses)
+            {
+                // The lanes without this point or without mass keep their impulse, so their bodies don't change.
+                const __m128 isActive = _mm_and_ps(hasMass, _mm_cmpgt_ps(pointCount, pointIdx));
+                const __m128 normalImpulse = _mm_loadu_ps(impulsePtr);
+
+                const __m128 separatingVelocity = _mm_add_ps(_mm_mul_ps(_mm_sub_ps(velocityAX, velocityBX), normalX),
+                                                             _mm_mul_ps(_mm_sub_ps(velocityAY, velocityBY), normalY));
+                const __m128 lambda = _mm_mul_ps(normalMass, _mm_sub_ps(velocityBias, separatingVelocity));
+
+                __m128 newImpulse = _mm_max_ps(_mm_add_ps(normalImpulse, lambda), zeros);
+                newImpulse = _mm_or_ps(_mm_and_ps(isActive, newImpulse), _mm_andnot_ps(isActive, normalImpulse));
+
+                const __m128 impulseLength = _mm_sub_ps(newImpulse, normalImpulse);
+                const __m128 impulseX = _mm_mul_ps(normalX, impulseLength);
+                const __m128 impulseY = _mm_mul_ps(normalY, impulseLength);
+
+                const __m128 velocityChangeAX = _mm_mul_ps(impulseX, inverseMassA);
+                const __m128 velocityChangeAY = _mm_mul_ps(impulseY, inverseMassA);
+                const __m128 velocityChangeBX = _mm_mul_ps(impulseX, negativeInverseMassB);
+                const __m128 velocityChangeBY = _mm_mul_ps(impulseY, negativeInverseMassB);
+
+                velocityAX = _mm_add_ps(velocityAX, velocityChangeAX);
+                velocityAY = _mm_add_ps(velocityAY, velocityChangeAY);
+                velocityBX = _mm_add_ps(velocityBX, velocityChangeBX);
+                velocityBY = _mm_add_ps(velocityBY, velocityChangeBY);
+                changeAX = _mm_add_ps(changeAX, velocityChangeAX);
+                changeAY = _mm_add_ps(changeAY, velocityChangeAY);
+                changeBX = _mm_add_ps(changeBX, velocityChangeBX);
+                changeBY = _mm_add_ps(changeBY, velocityChangeBY);
+
+                _mm_storeu_ps(impulsePtr, newImpulse);
+                pointIdx = _mm_add_ps(pointIdx, ones);
+            }
+
+            _mm_store_ps(velocitiesAX.data(), velocityAX);
+            _mm_store_ps(velocitiesAY.data(), velocityAY);
+            _mm_store_ps(velocitiesBX.data(), velocityBX);
+            _mm_store_ps(velocitiesBY.data(), velocityBY);
+            _mm_store_ps(changesAX.data(), changeAX);
+            _mm_store_ps(changesAY.data(), changeAY);
+            _mm_store_ps(changesBX.data(), changeBX);
+            _mm_store_ps(changesBY.data(), changeBY);
+
+            // The bodies that are not dynamic can be in several lanes, they are never written.
+            for (std::size_t lane = 0; lane < 4; lane++)
+            {
+                if (soa.InverseMassesA[i + lane] > 0.f)
+                {
+                    const auto bodyIdx = soa.BodyIndicesA[i + lane];
+
+                    bodies[bodyIdx].SetVelocity(Math::Vec2F(velocitiesAX[lane], velocitiesAY[lane]));
+                    velocityChanges[bodyIdx] = Math::Vec2F(changesAX[lane], changesAY[lane]);
+                }
+
+                if (soa.InverseMassesB[i + lane] > 0.f)
+                {
+                    const auto bodyIdx = soa.BodyIndicesB[i + lane];
+
+                    bodies[bodyIdx].SetVelocity(Math::Vec2F(velocitiesBX[lane], velocitiesBY[lane]));
+                    velocityChanges[bodyIdx] = Math::Vec2F(changesBX[lane], changesBY[lane]);
+                }
+            }
+        }
+
+        return i;
+    }
+
+#endif // __SSE__
+
+    void ContactConstraintSolver::solveVelocitiesSoA(AllocVector<Body>& bodies,
+                                                     const std::size_t begin,
+                                                     const std::size_t end,
+                                                     const SimdLevel kernel) noexcept
+    {
+        auto& soa = _constraintSoA;
+        std::size_t solvedEnd = begin;
+
+    #ifdef __SSE__
+        if (kernel != SimdLevel::Scalar)
+        {
+            solvedEnd = SolveVelocitiesSse(bodies, _velocityChanges, soa, begin, end);
+        }
+    #endif // __SSE__
+
+        // Scalar tail.
+        for (std::size_t i = solvedEnd; i < end; i++)
+        {
+            const auto normalMass = soa.NormalMasses[i];
+
+            if (normalMass <= 0.f) continue;
+
+            const Math::Vec2F normal(soa.NormalsX[i], soa.NormalsY[i]);
+            const auto bodyIdxA = soa.BodyIndicesA[i], bodyIdxB = soa.BodyIndicesB[i];
+            const auto inverseMassA = soa.InverseMassesA[i], inverseMassB = soa.InverseMassesB[i];
+
+            auto velocityA = bodies[bodyIdxA].Velocity(), velocityB = bodies[bodyIdxB].Velocity();
+            auto changeA = _velocityChanges[bodyIdxA], changeB = _velocityChanges[bodyIdxB];
+
+            std::array<float*, 2> impulses{ &soa.FirstNormalImpulses[i], &soa.SecondNormalImpulses[i] };
+
+            for (int j = 0; j < static_cast<int>(soa.PointCounts[i]); j++)
+            {
+                auto& normalImpulse = *impulses[j];
+
+                const auto separatingVelocity = (velocityA - velocityB).Dot(normal);
+                const auto lambda = normalMass * (soa.VelocityBiases[i] - separatingVelocity);
+
+                const auto newImpulse = std::max(normalImpulse + lambda, 0.f);
+                const auto impulse = normal * (newImpulse - normalImpulse);
+                normalImpulse = newImpulse;
+
+                const auto velocityChangeA = impulse * inverseMassA;
+                const auto velocityChangeB = impulse * -inverseMassB;
+
+                velocityA += velocityChangeA;
+                velocityB += velocityChangeB;
+                changeA += velocityChangeA;
+                changeB += velocityChangeB;
+            }
+
+            if (inverseMassA > 0.f)
+            {
+                bodies[bodyIdxA].SetVelocity(velocityA);
+                _velocityChanges[bodyIdxA] = changeA;
+            }
+
+            if (inverseMassB > 0.f)
+            {
+                bodies[bodyIdxB].SetVelocity(velocityB);
+                _velocityChanges[bodyIdxB] = changeB;
+            }
+        }
+    }
+
+    void ContactConstraintSolver::solveIsland(AllocVector<Body>& bodies,
+                                              const SolverIsland& island,
+                                              const float deltaTime) noexcept
+    {
+        const auto begin = island.ConstraintBegin, end = island.ConstraintBegin + island.ConstraintCount;
+
+        prepareConstraints(bodies, begin, end);
+
+        for (int i = 0; i < _velocityIterationCount; i++)
+        {
+            solveVelocities(bodies, begin, end);
+        }
+
+        correctIntegratedPositions(bodies, begin, end, deltaTime);
+
+        for (int i = 0; i < _positionIterationCount; i++)
+        {
+            solvePositions(bodies, begin, end);
+        }
+    }
+
+    void ContactConstraintSolver::prepareConstraints(AllocVector<Body>& bodies,
+                                                     const std::size_t begin,
+                                                     const std::size_t end) noexcept
+    {
+        for (std::size_t i = begin; i < end; i++)
+        {
+            auto& constraint = _constraints[_solveOrder[i]];
+            const auto& bodyA = bodies[constraint.BodyIndexA];
+            const auto& bodyB = bodies[constraint.BodyIndexB];
+
+            constraint.InverseMassA = bodyA.GetBodyType() == BodyType::Dynamic ? bodyA.InverseMass() : 0.f;
+            constraint.InverseMassB = bodyB.GetBodyType() == BodyType::Dynamic ? bodyB.InverseMass() : 0.f;
+
+            const auto totalInverseMass = constraint.InverseMassA + constraint.InverseMassB;
+
+            constraint.NormalMass = totalInverseMass > 0.f ? 1.f / totalInverseMass : 0.f;
+            constraint.StartPositionA = bodyA.Position();
+            constraint.StartPositionB = bodyB.Position();
+
+            const auto separatingVelocity = (bodyA.Velocity() - bodyB.Velocity()).Dot(constraint.Normal);
+
+            constraint.VelocityBias = separatingVelocity < -RestitutionVelocityThreshold ?
+                                      -constraint.Restitution * separatingVelocity : 0.f;
+        }
+
+        // The bounces are calculated before the warm start, from the velocities with which the bodies met.
+        for (std::size_t i = begin; i < end; i++)
+        {
+            const auto& constraint = _constraints[_solveOrder[i]];
+            float warmStartImpulse = 0.f;
+
+            for (int j = 0; j < constraint.PointCount; j++)
+            {
+                warmStartImpulse += constraint.Points[j].NormalImpulse;
+            }
+
+            applyImpulse(bodies, constraint, constraint.Normal * warmStartImpulse);
+        }
+    }
+
+    void ContactConstraintSolver::solveVelocities(AllocVector<Body>& bodies,
+                                                  const std::size_t begin,
+                                                  const std::size_t end) noexcept
+    {
+        for (std::size_t i = begin; i < end; i++)
+        {
+            auto& constraint = _constraints[_solveOrder[i]];
+
+            if (constraint.NormalMass <= 0.f) continue;
+
+            const auto& bodyA = bodies[constraint.BodyIndexA];
+            const auto& bodyB = bodies[constraint.BodyIndexB];
+
+            for (int j = 0; j < constraint.PointCount; j++)
+            {
+                auto& point = constraint.Points[j];
+
+                const auto separatingVelocity = (bodyA.Velocity() - bodyB.Velocity()).Dot(constraint.Normal);
+                const auto lambda = constraint.NormalMass * (constraint.VelocityBias - separatingVelocity);
+
+                // The accumulated impulse can only push the bodies apart, so it is clamped and not each impulse.
+                const auto newImpulse = std::max(point.NormalImpulse + lambda, 0.f);
+                const auto impulse = constraint.Normal * (newImpulse - point.NormalImpulse);
+                point.NormalImpulse = newImpulse;
+
+                applyImpulse(bodies, constraint, impulse);
+            }
+        }
+    }
+
+    void ContactConstraintSolver::applyImpulse(AllocVector<Body>& bodies,
+                                               const ContactConstraint& constraint,
+                                               const Math::Vec2F impulse) noexcept
+    {
+        // The bodies that are not dynamic are shared by the islands, so they are never written.
+        if (constraint.InverseMassA > 0.f)
+        {
+            auto& bodyA = bodies[constraint.BodyIndexA];
+            const auto velocityChangeA = impulse * constraint.InverseMassA;
+
+            bodyA.SetVelocity(bodyA.Velocity() + velocityChangeA);
+            _velocityChanges[constraint.BodyIndexA] += velocityChangeA;
+        }
+
+        if (constraint.InverseMassB > 0.f)
+        {
+            auto& bodyB = bodies[constraint.BodyIndexB];
+            const auto velocityChangeB = impulse * -constraint.InverseMassB;
+
+            bodyB.SetVelocity(bodyB.Velocity() + velocityChangeB);
+            _velocityChanges[constraint.BodyIndexB] += velocityChangeB;
+        }
+    }
+
+    void ContactConstraintSolver::correctIntegratedPositions(AllocVector<Body>& bodies,
+                                                             const std::size_t begin,
+                                                             const std::size_t end,
+                                                             const float deltaTime) noexcept
+    {
+        // The change of velocity of a body is reset once applied, so a body in several contacts moves once.
+        const auto correct = [this, &bodies, deltaTime](const std::size_t bodyIdx)
+        {
+            auto& body = bodies[bodyIdx];
+
+            body.SetPosition(body.Position() + _velocityChanges[bodyIdx] * deltaTime);
+            _velocityChanges[bodyIdx] = Math::Vec2F::Zero();
+        };
+
+        for (std::size_t i = begin; i < end; i++)
+        {
+            const auto& constraint = _constraints[_solveOrder[i]];
+
+            if (constraint.InverseMassA > 0.f) correct(constraint.BodyIndexA);
+            if (constraint.InverseMassB > 0.f) correct(constraint.BodyIndexB);
+        }
+    }
+
+    void ContactConstraintSolver::solvePositions(AllocVector<Body>& bodies,
+                                                 const std::size_t begin,
+                                                 const std::size_t end) const noexcept
+    {
+        for (std::size_t i = begin; i < end; i++)
+        {
+            const auto& constraint = _constraints[_solveOrder[i]];
+
+            if (constraint.NormalMass <= 0.f) continue;
+
+            auto& bodyA = bodies[constraint.BodyIndexA];
+            auto& bodyB = bodies[constraint.BodyIndexB];
+
+            // The bodies don't rotate, so the penetration only changes with the moves of the bodies since the
+            // start of the solve.
+            const auto moveA = bodyA.Position() - constraint.StartPositionA;
+            const auto moveB = bodyB.Position() - constraint.StartPositionB;
+            const auto penetration = constraint.Penetration - (moveA - moveB).Dot(constraint.Normal);
+
+            const auto correction = PositionCorrectionFactor * (penetration - LinearSlop);
+
+            if (correction <= 0.f) continue;
+
+            const auto move = constraint.Normal * (correction * constraint.NormalMass);
+
+            if (constraint.InverseMassA > 0.f) bodyA.SetPosition(bodyA.Position() + move * constraint.InverseMassA);
+            if (constraint.InverseMassB > 0.f) bodyB.SetPosition(bodyB.Position() - move * constraint.InverseMassB);
+        }
+    }
+
+    void ContactConstraintSolver::Clear() noexcept
+    {
+        _constraints.clear();
+        _previousConstraints.clear();
+        _velocityChanges.clear();
+        _solveOrder.clear();
+        _solverIslands.clear();
+        _solverTasks.clear();
+        _coloredIslandCount = 0;
+        _bodyColorMasks.clear();
+        _constraintColors.clear();
+        _colorOrder.clear();
+        _solverColors.clear();
+        _constraintSoA.Clear();
+    }
+
+    float ContactConstraintSolver::CombinedRestitution(const Body& bodyA,
+                                                       const Body& bodyB,
+                                                       const Collider& colliderA,
+                                                       const Collider& colliderB) noexcept
+    {
+        const auto mA = bodyA.Mass(), mB = bodyB.Mass();
+        const auto eA = colliderA.Restitution(), eB = colliderB.Restitution();
+
+        // The restitution of a collider is negative until it is set, which means that it doesn't bounce.
+        if (mA + mB <= 0.f) return 0.f;
+
+        return std::max((mA * eA + mB * eB) / (mA + mB), 0.f);
+    }
+}
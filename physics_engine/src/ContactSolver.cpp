@@ -13,139 +13,72 @@ namespace PhysicsEngine
         ColliderB = &colB;
     }
 
-    void ContactSolver::CalculateContactProperties() noexcept
+    /**
+     * @brief shapeInstanceOf gives the shape instance of a collider shape at the position of its body, the local
+     * vertices of a polygon being translated by the position when they are read.
+     */
+    static ShapeInstance shapeInstanceOf(const ColliderShape& shape, const Math::Vec2F position) noexcept
     {
-        const auto colShapeA = ColliderA->Shape();
-        const auto colShapeB = ColliderB->Shape();
-
-        switch (static_cast<Math::ShapeType>(colShapeA.index()))
-        {
-        case Math::ShapeType::Circle:
-        {
-            const auto circleA = std::get<Math::CircleF>(colShapeA) + BodyA->Position();
-
-            switch (static_cast<Math::ShapeType>(colShapeB.index()))
-            {
-            case Math::ShapeType::Circle:
-            {
-                const auto circleB = std::get<Math::CircleF>(colShapeB) + BodyB->Position();
-                const auto cA = circleA.Center(), cB = circleB.Center();
-                const auto rA = circleA.Radius(), rB = circleB.Radius();
+        const auto* polygon = std::get_if<Math::PolygonF>(&shape);
 
-                const auto delta = cA - cB;
-                Normal = delta.Normalized();
-                Point = cA + delta * 0.5f;
-                Penetration = rA + rB - delta.Length();
+        if (polygon == nullptr) return ShapeInstance{&shape, position};
 
-                break;
-            } // Case circle B.
-
-            case Math::ShapeType::Rectangle:
-            {
-                const auto rectB = std::get<Math::RectangleF>(colShapeB) +
-                    BodyB->Position();
+        return ShapeInstance{&shape, position, Math::PolygonSpanF(*polygon), position};
+    }
 
-                const auto circleCenter = circleA.Center(), rectCenter = rectB.Center();
-                const auto rectHalfSize = rectB.HalfSize();
+    /**
+     * @brief shapeCenterOf gives the center of a circle or a rectangle collider shape at the position of its body.
+     */
+    static Math::Vec2F shapeCenterOf(const ColliderShape& shape, const Math::Vec2F position) noexcept
+    {
+        if (const auto* circle = std::get_if<Math::CircleF>(&shape)) return (*circle + position).Center();
+        if (const auto* rectangle = std::get_if<Math::RectangleF>(&shape)) return (*rectangle + position).Center();
 
-                const auto delta = circleCenter - rectCenter;
+        return position;
+    }
 
-                Math::Vec2F closestPoint;
+    void ContactSolver::CalculateContactProperties() noexcept
+    {
+        // The actors are swapped when the shape type of A comes after the one of B (aka a rectangle A and a
+        // circle B), so that the normal always has the orientation of the ordered pair of shape types.
+        if (ColliderB->Shape().index() < ColliderA->Shape().index())
+        {
+            std::swap(BodyA, BodyB);
+            std::swap(ColliderA, ColliderB);
+        }
 
-                closestPoint.X = Math::Clamp(delta.X, -rectHalfSize.X, rectHalfSize.X);
-                closestPoint.Y = Math::Clamp(delta.Y, -rectHalfSize.Y, rectHalfSize.Y);
+        const auto& colShapeA = ColliderA->Shape();
+        const auto& colShapeB = ColliderB->Shape();
 
-                const auto distance = (closestPoint - delta).Length();
-                const auto closestPoinOnRect = rectCenter + closestPoint;
+        const auto shapeA = shapeInstanceOf(colShapeA, BodyA->Position());
+        const auto shapeB = shapeInstanceOf(colShapeB, BodyB->Position());
 
-                auto circleToRect = (circleCenter - closestPoinOnRect);
+        const auto typeA = static_cast<Math::ShapeType>(colShapeA.index());
+        const auto typeB = static_cast<Math::ShapeType>(colShapeB.index());
 
-                if (circleToRect.Length() <= Math::Epsilon)
-                {
-                    circleToRect = Math::Vec2F(0.f, 1.f);
-                }
+        const auto manifold = CalculateManifold(typeA, shapeA, typeB, shapeB);
 
-                Normal = circleToRect.Normalized();
-                Point = closestPoinOnRect;
-                Penetration = circleA.Radius() - distance;
+        Normal = manifold.Normal;
+        Penetration = manifold.Penetration;
 
-                break;
-            } // Case rectangle B.
+        // This solver moves the bodies along a single point: the one of the previous solver for two circles or
+        // two rectangles (half of the distance between the centers beyond the center of A), the middle of the
+        // points of the manifold otherwise.
+        if (typeA == typeB && (typeA == Math::ShapeType::Circle || typeA == Math::ShapeType::Rectangle))
+        {
+            const auto cA = shapeCenterOf(colShapeA, BodyA->Position());
+            const auto cB = shapeCenterOf(colShapeB, BodyB->Position());
 
-            case Math::ShapeType::None:
-                break;
-            default:
-                break;
-            } // Switch shape collider B.
+            Point = cA + (cA - cB) * 0.5f;
+            return;
+        }
 
-            break;
-        } // Case circle A.
+        Point = Math::Vec2F::Zero();
 
-        case Math::ShapeType::Rectangle:
+        for (int i = 0; i < manifold.PointCount; i++)
         {
-            const auto rectA = std::get<Math::RectangleF>(colShapeA) + BodyA->Position();
-
-            switch (static_cast<Math::ShapeType>(colShapeB.index()))
-            {
-            case Math::ShapeType::Circle:
-            {
-                const auto circleB = std::get<Math::CircleF>(colShapeB) +
-                    BodyB->Position();
-
-                std::swap(BodyA, BodyB);
-                std::swap(ColliderA, ColliderB);
-                CalculateContactProperties();
-
-                break;
-            } // Case circle B.
-
-            case Math::ShapeType::Rectangle:
-            {
-                const auto rectB = std::get<Math::RectangleF>(colShapeB) +
-                    BodyB->Position();
-
-                const auto cA = rectA.Center(), cB = rectB.Center();
-                const auto halfSizeA = rectA.HalfSize(), halfSizeB = rectB.HalfSize();
-
-                const auto delta = cA - cB;
-                Point = cA + delta * 0.5f;
-
-                // Calculate the penetration in x-axis
-                const auto penetrationX = halfSizeA.X + halfSizeB.X - Math::Abs(delta.X);
-                // Calculate the penetration in y-axis
-                const auto penetrationY = halfSizeA.Y + halfSizeB.Y - Math::Abs(delta.Y);
-
-                if (penetrationX < penetrationY)
-                {
-                    Normal = delta.X > 0 ?
-                        Math::Vec2F::Right() : Math::Vec2F::Left();
-
-                    Penetration = penetrationX;
-                }
-                else
-                {
-                    Normal = delta.Y > 0 ? Math::Vec2F::Up() : Math::Vec2F::Down();
-
-                    Penetration = penetrationY;
-                }
-
-                break;
-            } // Case rectangle B.
-
-            case Math::ShapeType::None:
-                break;
-            default:
-                break;
-            } // Switch shape collider B.
-
-            break;
-        } // Case rectangle A.
-
-        case Math::ShapeType::None:
-            break;
-        default:
-            break;
-        } // Switch shape collider A.
+            Point += manifold.Points[i] / static_cast<float>(manifold.PointCount);
+        }
     }
 
     float ContactSolver::CalculateSeparatingVelocity() const noexcept
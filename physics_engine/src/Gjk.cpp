@@ -0,0 +1,226 @@
+#include "Gjk.h"
+
+#include <algorithm>
+
+namespace PhysicsEngine
+{
+    /**
+     * @brief KeepPoints reduces the simplex to the points at the indices given in parameter, in this order.
+     */
+    static void KeepPoints(Simplex& simplex, const int firstIdx, const int secondIdx = -1) noexcept
+    {
+        Simplex reduced;
+        reduced.Push(simplex.Points[firstIdx], simplex.Directions[firstIdx]);
+
+        if (secondIdx >= 0) reduced.Push(simplex.Points[secondIdx], simplex.Directions[secondIdx]);
+
+        simplex = reduced;
+    }
+
+    /**
+     * @brief UpdateSegment reduces a simplex of two points to the closest feature to the origin.
+     */
+    static bool UpdateSegment(Simplex& simplex, Math::Vec2F& direction) noexcept
+    {
+        const auto pointA = simplex.Points[1], pointB = simplex.Points[0];
+        const auto ab = pointB - pointA;
+
+        // The origin is closest to the point A or to the point B.
+        if (ab.Dot(-pointA) <= 0.f)
+        {
+            KeepPoints(simplex, 1);
+            direction = -pointA;
+
+            return direction.SquareLength() <= 0.f;
+        }
+
+        if ((-ab).Dot(-pointB) <= 0.f)
+        {
+            KeepPoints(simplex, 0);
+            direction = -pointB;
+
+            return direction.SquareLength() <= 0.f;
+        }
+
+        // The origin is closest to the edge, the next direction is its normal towards the origin.
+        auto normal = Math::Vec2F(-ab.Y, ab.X);
+        const auto side = normal.Dot(-pointA);
+
+        if (side == 0.f)
+        {
+            direction = Math::Vec2F::Zero();
+
+            return true;
+        }
+
+        direction = side > 0.f ? normal : -normal;
+
+        return false;
+    }
+
+    bool UpdateSimplex(Simplex& simplex, Math::Vec2F& direction) noexcept
+    {
+        switch (simplex.Count)
+        {
+            case 1:
+            {
+                direction = -simplex.Points[0];
+
+                return direction.SquareLength() <= 0.f;
+            }
+            case 2:
+            {
+                return UpdateSegment(simplex, direction);
+            }
+            case 3:
+            {
+                const auto& points = simplex.Points;
+                const auto area = (points[1] - points[0]).X * (points[2] - points[0]).Y -
+                                  (points[1] - points[0]).Y * (points[2] - points[0]).X;
+
+                // A flat triangle (from a warm start) is reduced to its longest edge.
+                if (area == 0.f)
+                {
+                    const auto length01 = (points[1] - points[0]).SquareLength();
+                    const auto length12 = (points[2] - points[1]).SquareLength();
+                    const auto length02 = (points[2] - points[0]).SquareLength();
+
+                    if (length01 >= length12 && length01 >= length02) KeepPoints(simplex, 0, 1);
+                    else if (length12 >= length02) KeepPoints(simplex, 1, 2);
+                    else KeepPoints(simplex, 0, 2);
+
+                    return UpdateSegment(simplex, direction);
+                }
+
+                // The edges containing the newest point are checked first, the origin can't be outside the
+                // last one unless the simplex comes from a warm start.
+                constexpr std::array<std::pair<int, int>, 3> edges = {
+                    std::pair{2, 0}, std::pair{1, 2}, std::pair{0, 1}
+                };
+
+                for (const auto& [startIdx, endIdx] : edges)
+                {
+                    const auto edge = points[endIdx] - points[startIdx];
+
+                    // Outward normal of a counter-clockwise triangle, flipped for a clockwise one.
+                    auto normal = Math::Vec2F(edge.Y, -edge.X);
+
+                    if (area < 0.f) normal = -normal;
+
+                    if (normal.Dot(-points[startIdx]) > 0.f)
+                    {
+                        KeepPoints(simplex, startIdx, endIdx);
+
+                        return UpdateSegment(simplex, direction);
+                    }
+                }
+
+                return true;
+            }
+            default:
+                return false;
+        }
+    }
+
+    Math::Vec2F ClosestPointOnRay(std::array<Math::Vec2F, 3>& points, int& count, const Math::Vec2F rayPoint) noexcept
+    {
+        // The closest point of the segment [x - pA, x - pB] with the reduction to the feature that contains it.
+        const auto closestOnSegment = [rayPoint](const Math::Vec2F pointA, const Math::Vec2F pointB,
+                                                 float& segmentTime)
+        {
+            const auto a = rayPoint - pointA, b = rayPoint - pointB;
+            const auto ab = b - a;
+            const auto squareLength = ab.SquareLength();
+
+            segmentTime = squareLength > 0.f ? std::clamp(-a.Dot(ab) / squareLength, 0.f, 1.f) : 0.f;
+
+            return a + ab * segmentTime;
+        };
+
+        const auto keepSegment = [&points, &count](const int idxA, const int idxB, const float segmentTime)
+        {
+            const auto pointA = points[idxA], pointB = points[idxB];
+
+            if (segmentTime <= 0.f)
+            {
+                points[0] = pointA;
+                count = 1;
+            }
+            else if (segmentTime >= 1.f)
+            {
+                points[0] = pointB;
+                count = 1;
+            }
+            else
+            {
+                points[0] = pointA;
+                points[1] = pointB;
+                count = 2;
+            }
+        };
+
+        switch (count)
+        {
+            case 1:
+                return rayPoint - points[0];
+            case 2:
+            {
+                float segmentTime = 0.f;
+                const auto closest = closestOnSegment(points[0], points[1], segmentTime);
+                keepSegment(0, 1, segmentTime);
+
+                return closest;
+            }
+            case 3:
+            {
+                std::array<Math::Vec2F, 3> y{};
+
+                for (int i = 0; i < 3; i++)
+                {
+                    y[i] = rayPoint - points[i];
+                }
+
+                const auto cross = [](const Math::Vec2F u, const Math::Vec2F v) { return u.X * v.Y - u.Y * v.X; };
+
+                const auto c0 = cross(y[1] - y[0], -y[0]);
+                const auto c1 = cross(y[2] - y[1], -y[1]);
+                const auto c2 = cross(y[0] - y[2], -y[2]);
+
+                // The origin is inside the triangle.
+                if ((c0 >= 0.f && c1 >= 0.f && c2 >= 0.f) || (c0 <= 0.f && c1 <= 0.f && c2 <= 0.f))
+                {
+                    return Math::Vec2F::Zero();
+                }
+
+                constexpr std::array<std::pair<int, int>, 3> edges = {
+                    std::pair{0, 1}, std::pair{1, 2}, std::pair{2, 0}
+                };
+
+                Math::Vec2F closest = Math::Vec2F::Zero();
+                float closestSquareLength = std::numeric_limits<float>::max();
+                float closestTime = 0.f;
+                std::pair<int, int> closestEdge = edges[0];
+
+                for (const auto& edge : edges)
+                {
+                    float segmentTime = 0.f;
+                    const auto point = closestOnSegment(points[edge.first], points[edge.second], segmentTime);
+
+                    if (point.SquareLength() < closestSquareLength)
+                    {
+                        closest = point;
+                        closestSquareLength = point.SquareLength();
+                        closestTime = segmentTime;
+                        closestEdge = edge;
+                    }
+                }
+
+                keepSegment(closestEdge.first, closestEdge.second, closestTime);
+
+                return closest;
+            }
+            default:
+                return rayPoint;
+        }
+    }
+}
@@ -0,0 +1,111 @@
+#include "IslandGraph.h"
+
+#ifdef TRACY_ENABLE
+#include <Tracy.hpp>
+#endif // TRACY_ENABLE
+
+namespace PhysicsEngine
+{
+    IslandGraph::IslandGraph(Allocator& allocator) noexcept :
+        _parents{ StandardAllocator<std::size_t>{allocator} },
+        _bodyIslands{ StandardAllocator<std::size_t>{allocator} },
+        _islandBodies{ StandardAllocator<std::size_t>{allocator} },
+        _islands{ StandardAllocator<Island>{allocator} }
+    {}
+
+    void IslandGraph::Reset(const std::size_t bodyCount) noexcept
+    {
+        _parents.resize(bodyCount);
+
+        for (std::size_t i = 0; i < bodyCount; i++)
+        {
+            _parents[i] = i;
+        }
+    }
+
+    std::size_t IslandGraph::find(std::size_t bodyIdx) noexcept
+    {
+        while (_parents[bodyIdx] != bodyIdx)
+        {
+            _parents[bodyIdx] = _parents[_parents[bodyIdx]];
+            bodyIdx = _parents[bodyIdx];
+        }
+
+        return bodyIdx;
+    }
+
+    void IslandGraph::Link(const std::size_t bodyIdxA, const std::size_t bodyIdxB) noexcept
+    {
+        const auto rootA = find(bodyIdxA), rootB = find(bodyIdxB);
+
+        if (rootA == rootB) return;
+
+        // The lowest root is kept so that the islands don't depend on the order of the links.
+        if (rootA < rootB) _parents[rootB] = rootA;
+        else _parents[rootA] = rootB;
+    }
+
+    void IslandGraph::Build(const AllocVector<Body>& bodies) noexcept
+    {
+    #ifdef TRACY_ENABLE
+            ZoneScoped;
+            ZoneValue(bodies.size());
+    #endif // TRACY_ENABLE
+
+        _islands.clear();
+        _islandBodies.clear();
+        _bodyIslands.assign(bodies.size(), NoIsland);
+
+        const auto isInIsland = [&bodies](const std::size_t bodyIdx)
+        {
+            return bodies[bodyIdx].IsValid() && bodies[bodyIdx].GetBodyType() == BodyType::Dynamic;
+        };
+
+        // The islands are numbered in the order of their lowest body, which is also their root.
+        for (std::size_t i = 0; i < bodies.size(); i++)
+        {
+            if (!isInIsland(i)) continue;
+
+            const auto root = find(i);
+
+            if (root == i)
+            {
+                _bodyIslands[i] = _islands.size();
+                _islands.push_back(Island{ 0, 0 });
+            }
+
+            _islands[_bodyIslands[root]].BodyCount++;
+        }
+
+        std::size_t bodyBegin = 0;
+
+        for (auto& island : _islands)
+        {
+            island.BodyBegin = bodyBegin;
+            bodyBegin += island.BodyCount;
+            island.BodyCount = 0;
+        }
+
+        _islandBodies.resize(bodyBegin);
+
+        for (std::size_t i = 0; i < bodies.size(); i++)
+        {
+            if (!isInIsland(i)) continue;
+
+            const auto islandIdx = _bodyIslands[find(i)];
+            auto& island = _islands[islandIdx];
+
+            _bodyIslands[i] = islandIdx;
+            _islandBodies[island.BodyBegin + island.BodyCount] = i;
+            island.BodyCount++;
+        }
+    }
+
+    void IslandGraph::Clear() noexcept
+    {
+        _parents.clear();
+        _bodyIslands.clear();
+        _islandBodies.clear();
+        _islands.clear();
+    }
+}
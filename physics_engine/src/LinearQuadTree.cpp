@@ -0,0 +1,282 @@
+#include "LinearQuadTree.h"
+
+#include <algorithm>
+
+#ifdef TRACY_ENABLE
+#include <Tracy.hpp>
+#endif // TRACY_ENABLE
+
+namespace PhysicsEngine
+{
+    void LinearQuadTree::Init() noexcept
+    {
+    #ifdef TRACY_ENABLE
+            ZoneScoped;
+    #endif // TRACY_ENABLE
+
+        _digitCounts.reserve(_radixDigitCount);
+    }
+
+    void LinearQuadTree::Update(const AllocVector<SimplifiedCollider>& colliders) noexcept
+    {
+    #ifdef TRACY_ENABLE
+            ZoneScoped;
+            ZoneValue(colliders.size());
+    #endif // TRACY_ENABLE
+
+        _possiblePairs.clear();
+        _nodes.clear();
+
+        const auto colliderCount = colliders.size();
+
+        _entries.resize(colliderCount);
+        _sortedEntries.resize(colliderCount);
+
+        if (colliderCount == 0) return;
+
+        // The root node is fitted to the simplified shapes, so no collider is outside of it.
+        auto rootMin = colliders[0].Rectangle.MinBound();
+        auto rootMax = colliders[0].Rectangle.MaxBound();
+
+        for (const auto& simplCol : colliders)
+        {
+            const auto min = simplCol.Rectangle.MinBound(), max = simplCol.Rectangle.MaxBound();
+
+            rootMin = Math::Vec2F(std::min(rootMin.X, min.X), std::min(rootMin.Y, min.Y));
+            rootMax = Math::Vec2F(std::max(rootMax.X, max.X), std::max(rootMax.Y, max.Y));
+        }
+
+        const auto rootSize = rootMax - rootMin;
+        constexpr auto gridSize = static_cast<float>(1 << _maxDepth);
+
+        const Math::Vec2F cellsPerMeter(rootSize.X > 0.f ? gridSize / rootSize.X : 0.f,
+                                        rootSize.Y > 0.f ? gridSize / rootSize.Y : 0.f);
+
+        const bool isParallel = _jobSystem != nullptr && _jobSystem->WorkerCount() > 0 &&
+                                colliderCount >= _parallelSortMinColliderCount;
+        const auto chunkCount = isParallel ? (colliderCount + _sortChunkSize - 1) / _sortChunkSize : 1;
+
+        if (chunkCount > 1)
+        {
+            _jobSystem->ParallelFor(chunkCount, [&](const std::size_t chunkIdx)
+            {
+                const auto begin = chunkIdx * _sortChunkSize;
+                calculateKeys(colliders, begin, std::min(begin + _sortChunkSize, colliderCount), rootMin,
+                              cellsPerMeter);
+            });
+        }
+        else
+        {
+            calculateKeys(colliders, 0, colliderCount, rootMin, cellsPerMeter);
+        }
+
+        sortEntries(chunkCount);
+        calculatePossiblePairs(colliders);
+    }
+
+    void LinearQuadTree::calculateKeys(const AllocVector<SimplifiedCollider>& colliders,
+                                       const std::size_t begin,
+                                       const std::size_t end,
+                                       const Math::Vec2F rootMin,
+                                       const Math::Vec2F cellsPerMeter) noexcept
+    {
+    #ifdef TRACY_ENABLE
+            ZoneScoped;
+            ZoneValue(end - begin);
+    #endif // TRACY_ENABLE
+
+        constexpr int maxCell = (1 << _maxDepth) - 1;
+
+        const auto cellOf = [maxCell](const float value, const float min, const float cellsPerMeter)
+        {
+            return static_cast<std::uint32_t>(std::clamp(static_cast<int>((value - min) * cellsPerMeter),
+                                                         0, maxCell));
+        };
+
+        for (std::size_t i = begin; i < end; i++)
+        {
+            const auto& rectangle = colliders[i].Rectangle;
+            const auto min = rectangle.MinBound(), max = rectangle.MaxBound();
+
+            const auto minX = cellOf(min.X, rootMin.X, cellsPerMeter.X);
+            const auto minY = cellOf(min.Y, rootMin.Y, cellsPerMeter.Y);
+            const auto maxX = cellOf(max.X, rootMin.X, cellsPerMeter.X);
+            const auto maxY = cellOf(max.Y, rootMin.Y, cellsPerMeter.Y);
+
+            // The corners are in the same node from the depth above the highest bit in which their cells differ.
+            const auto differentBits = (minX ^ maxX) | (minY ^ maxY);
+            int shift = 0;
+
+            while ((differentBits >> shift) != 0) shift++;
+
+            const auto depth = static_cast<std::uint32_t>(_maxDepth - shift);
+            const auto code = MortonCode(minX >> shift, minY >> shift) << (2 * shift);
+
+            _entries[i] = MortonEntry{ code << _depthBitCount | depth, static_cast<std::uint32_t>(i) };
+        }
+    }
+
+    void LinearQuadTree::sortEntries(const std::size_t chunkCount) noexcept
+    {
+    #ifdef TRACY_ENABLE
+            ZoneScoped;
+            ZoneValue(_entries.size());
+    #endif // TRACY_ENABLE
+
+        const auto entryCount = _entries.size();
+        const auto chunkSize = chunkCount > 1 ? _sortChunkSize : entryCount;
+
+        _digitCounts.resize(chunkCount * _radixDigitCount);
+
+        for (int pass = 0; pass < _radixPassCount; pass++)
+        {
+            const int bitShift = pass * _radixBitCount;
+
+            const auto digitOf = [bitShift](const MortonEntry& entry)
+            {
+                return (entry.Key >> bitShift) & (_radixDigitCount - 1);
+            };
+
+            const auto countDigits = [&](const std::size_t chunkIdx)
+            {
+                auto* counts = _digitCounts.data() + chunkIdx * _radixDigitCount;
+                std::fill(counts, counts + _radixDigitCount, 0);
+
+                const auto begin = chunkIdx * chunkSize, end = std::min(begin + chunkSize, entryCount);
+
+                for (std::size_t i = begin; i < end; i++)
+                {
+                    counts[digitOf(_entries[i])]++;
+                }
+            };
+
+            const auto scatterEntries = [&](const std::size_t chunkIdx)
+            {
+                auto* offsets = _digitCounts.data() + chunkIdx * _radixDigitCount;
+
+                const auto begin = chunkIdx * chunkSize, end = std::min(begin + chunkSize, entryCount);
+
+                for (std::size_t i = begin; i < end; i++)
+                {
+                    _sortedEntries[offsets[digitOf(_entries[i])]++] = _entries[i];
+                }
+            };
+
+            if (chunkCount > 1) _jobSystem->ParallelFor(chunkCount, countDigits);
+            else countDigits(0);
+
+            // The entries of a digit are placed chunk after chunk, so that the sort is stable.
+            std::size_t offset = 0;
+
+            for (std::size_t digit = 0; digit < _radixDigitCount; digit++)
+            {
+                for (std::size_t chunkIdx = 0; chunkIdx < chunkCount; chunkIdx++)
+                {
+                    auto& count = _digitCounts[chunkIdx * _radixDigitCount + digit];
+                    const auto digitCount = count;
+                    count = offset;
+                    offset += digitCount;
+                }
+            }
+
+            if (chunkCount > 1) _jobSystem->ParallelFor(chunkCount, scatterEntries);
+            else scatterEntries(0);
+
+            _entries.swap(_sortedEntries);
+        }
+    }
+
+    void LinearQuadTree::calculatePossiblePairs(const AllocVector<SimplifiedCollider>& colliders) noexcept
+    {
+    #ifdef TRACY_ENABLE
+            ZoneScoped;
+    #endif // TRACY_ENABLE
+
+        for (std::size_t i = 0; i < _entries.size(); i++)
+        {
+            if (_nodes.empty() || _nodes.back().Key != _entries[i].Key)
+            {
+                _nodes.push_back(LinearNode{ _entries[i].Key, i, i + 1 });
+            }
+            else
+            {
+                _nodes.back().EntryEnd = i + 1;
+            }
+        }
+
+    #ifdef TRACY_ENABLE
+            ZoneValue(_nodes.size());
+    #endif // TRACY_ENABLE
+
+        constexpr std::uint32_t depthMask = (1u << _depthBitCount) - 1;
+
+        const auto addPairsWith = [this, &colliders](const SimplifiedCollider& simplColA, const std::size_t begin,
+                                                     const std::size_t end)
+        {
+            for (std::size_t j = begin; j < end; j++)
+            {
+                const auto& simplColB = colliders[_entries[j].ColliderIdx];
+
+                if (!Math::Intersect(simplColA.Rectangle, simplColB.Rectangle)) continue;
+
+                _possiblePairs.push_back(ColliderPair{ simplColA.ColRef, simplColB.ColRef });
+            }
+        };
+
+        _ancestorNodes.clear();
+
+        for (std::size_t nodeIdx = 0; nodeIdx < _nodes.size(); nodeIdx++)
+        {
+            const auto& node = _nodes[nodeIdx];
+            const auto code = node.Key >> _depthBitCount;
+
+            // The nodes are in depth-first order, so the nodes of the stack that don't contain this one are done.
+            while (!_ancestorNodes.empty())
+            {
+                const auto ancestorKey = _nodes[_ancestorNodes.back()].Key;
+                const auto ancestorShift = 2 * (_maxDepth - static_cast<int>(ancestorKey & depthMask));
+
+                if ((code >> ancestorShift) == ((ancestorKey >> _depthBitCount) >> ancestorShift)) break;
+
+                _ancestorNodes.pop_back();
+            }
+
+            for (std::size_t i = node.EntryBegin; i < node.EntryEnd; i++)
+            {
+                const auto& simplColA = colliders[_entries[i].ColliderIdx];
+
+                addPairsWith(simplColA, i + 1, node.EntryEnd);
+
+                for (const auto ancestorIdx : _ancestorNodes)
+                {
+                    addPairsWith(simplColA, _nodes[ancestorIdx].EntryBegin, _nodes[ancestorIdx].EntryEnd);
+                }
+            }
+
+            _ancestorNodes.push_back(nodeIdx);
+        }
+    }
+
+    void LinearQuadTree::Clear() noexcept
+    {
+    #ifdef TRACY_ENABLE
+            ZoneScoped;
+    #endif // TRACY_ENABLE
+
+        _entries.clear();
+        _sortedEntries.clear();
+        _nodes.clear();
+        _ancestorNodes.clear();
+        _possiblePairs.clear();
+    }
+
+    void LinearQuadTree::Deinit() noexcept
+    {
+    #ifdef TRACY_ENABLE
+            ZoneScoped;
+    #endif // TRACY_ENABLE
+
+        Clear();
+        _digitCounts.clear();
+    }
+}
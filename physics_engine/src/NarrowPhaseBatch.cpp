@@ -0,0 +1,358 @@
+#include "NarrowPhaseBatch.h"
+#include "Definition.h"
+#include "Intrinsics.h"
+
+#include <algorithm>
+
+#ifdef TRACY_ENABLE
+#include <Tracy.hpp>
+#endif // TRACY_ENABLE
+
+namespace PhysicsEngine
+{
+    NarrowPhaseBatch::NarrowPhaseBatch(Allocator& allocator) noexcept :
+        _circleCentersAX{ StandardAllocator<float>{allocator} },
+        _circleCentersAY{ StandardAllocator<float>{allocator} },
+        _circleCentersBX{ StandardAllocator<float>{allocator} },
+        _circleCentersBY{ StandardAllocator<float>{allocator} },
+        _radiusSums{ StandardAllocator<float>{allocator} },
+        _circlePairs{ StandardAllocator<ColliderPair>{allocator} },
+        _rectMinBoundsAX{ StandardAllocator<float>{allocator} },
+        _rectMinBoundsAY{ StandardAllocator<float>{allocator} },
+        _rectMaxBoundsAX{ StandardAllocator<float>{allocator} },
+        _rectMaxBoundsAY{ StandardAllocator<float>{allocator} },
+        _rectMinBoundsBX{ StandardAllocator<float>{allocator} },
+        _rectMinBoundsBY{ StandardAllocator<float>{allocator} },
+        _rectMaxBoundsBX{ StandardAllocator<float>{allocator} },
+        _rectMaxBoundsBY{ StandardAllocator<float>{allocator} },
+        _rectanglePairs{ StandardAllocator<ColliderPair>{allocator} },
+        _overlaps{ StandardAllocator<std::uint8_t>{allocator} },
+        _pairBuckets{ StandardAllocator<AllocVector<ColliderPair>>{allocator} }
+    {
+        _pairBuckets.reserve(WorldShapeTypeCount * WorldShapeTypeCount);
+
+        for (std::size_t i = 0; i < WorldShapeTypeCount * WorldShapeTypeCount; i++)
+        {
+            _pairBuckets.emplace_back(StandardAllocator<ColliderPair>{allocator});
+        }
+    }
+
+    void NarrowPhaseBatch::Reserve(const std::size_t pairCount) noexcept
+    {
+        _circleCentersAX.reserve(pairCount);
+        _circleCentersAY.reserve(pairCount);
+        _circleCentersBX.reserve(pairCount);
+        _circleCentersBY.reserve(pairCount);
+        _radiusSums.reserve(pairCount);
+        _circlePairs.reserve(pairCount);
+
+        _rectMinBoundsAX.reserve(pairCount);
+        _rectMinBoundsAY.reserve(pairCount);
+        _rectMaxBoundsAX.reserve(pairCount);
+        _rectMaxBoundsAY.reserve(pairCount);
+        _rectMinBoundsBX.reserve(pairCount);
+        _rectMinBoundsBY.reserve(pairCount);
+        _rectMaxBoundsBX.reserve(pairCount);
+        _rectMaxBoundsBY.reserve(pairCount);
+        _rectanglePairs.reserve(pairCount);
+
+        _overlaps.reserve(pairCount);
+
+        for (auto& bucket : _pairBuckets)
+        {
+            bucket.reserve(pairCount);
+        }
+    }
+
+    void NarrowPhaseBatch::AddCircles(const ColliderPair& pair,
+                                      const Math::CircleF circleA,
+                                      const Math::CircleF circleB) noexcept
+    {
+        const auto centerA = circleA.Center(), centerB = circleB.Center();
+
+        _circleCentersAX.push_back(centerA.X);
+        _circleCentersAY.push_back(centerA.Y);
+        _circleCentersBX.push_back(centerB.X);
+        _circleCentersBY.push_back(centerB.Y);
+        _radiusSums.push_back(circleA.Radius() + circleB.Radius());
+        _circlePairs.push_back(pair);
+    }
+
+    void NarrowPhaseBatch::AddRectangles(const ColliderPair& pair,
+                                         const Math::RectangleF rectA,
+                                         const Math::RectangleF rectB) noexcept
+    {
+        _rectMinBoundsAX.push_back(rectA.MinBound().X);
+        _rectMinBoundsAY.push_back(rectA.MinBound().Y);
+        _rectMaxBoundsAX.push_back(rectA.MaxBound().X);
+        _rectMaxBoundsAY.push_back(rectA.MaxBound().Y);
+        _rectMinBoundsBX.push_back(rectB.MinBound().X);
+        _rectMinBoundsBY.push_back(rectB.MinBound().Y);
+        _rectMaxBoundsBX.push_back(rectB.MaxBound().X);
+        _rectMaxBoundsBY.push_back(rectB.MaxBound().Y);
+        _rectanglePairs.push_back(pair);
+    }
+
+    /**
+     * @brief CirclesScalar tests the circle pairs in [begin, count) one by one, with the same operations as
+     * Math::Intersect.
+     */
+    static void CirclesScalar(const float* centerAX, const float* centerAY,
+                              const float* centerBX, const float* centerBY, const float* radiusSum,
+                              std::uint8_t* overlaps, std::size_t begin, std::size_t count) noexcept
+    {
+        for (std::size_t i = begin; i < count; i++)
+        {
+            const float deltaX = centerAX[i] - centerBX[i];
+            const float deltaY = centerAY[i] - centerBY[i];
+
+            overlaps[i] = deltaX * deltaX + deltaY * deltaY <= radiusSum[i] * radiusSum[i];
+        }
+    }
+
+    /**
+     * @brief RectanglesScalar tests the rectangle pairs in [begin, count) one by one.
+     */
+    static void RectanglesScalar(const float* minAX, const float* minAY, const float* maxAX, const float* maxAY,
+                                 const float* minBX, const float* minBY, const float* maxBX, const float* maxBY,
+                                 std::uint8_t* overlaps, std::size_t begin, std::size_t count) noexcept
+    {
+        for (std::size_t i = begin; i < count; i++)
+        {
+            const bool isSeparated = maxAX[i] < minBX[i] || minAX[i] > maxBX[i] ||
+                                     maxAY[i] < minBY[i] || minAY[i] > maxBY[i];
+
+            overlaps[i] = !isSeparated;
+        }
+    }
+
+#ifdef __SSE__
+
+    /**
+     * @brief StoreMask writes the lanes of the mask given by a movemask in the overlaps.
+     */
+    static void StoreMask(const int mask, std::uint8_t* overlaps, const int laneCount) noexcept
+    {
+        for (int lane = 0; lane < laneCount; lane++)
+        {
+            overlaps[lane] = (mask >> lane) & 1;
+        }
+    }
+
+    /**
+     * @brief CirclesSse tests the circle pairs 4 by 4 and gives the index of the first pair that has not
+     * been tested.
+     */
+    static std::size_t CirclesSse(const float* centerAX, const float* centerAY,
+                                  const float* centerBX, const float* centerBY, const float* radiusSum,
+                                  std::uint8_t* overlaps, std::size_t count) noexcept
+    {
+        std::size_t i = 0;
+
+        for (; i + 4 <= count; i += 4)
+        {
+            const __m128 deltaX = _mm_sub_ps(_mm_loadu_ps(centerAX + i), _mm_loadu_ps(centerBX + i));
+            const __m128 deltaY = _mm_sub_ps(_mm_loadu_ps(centerAY + i), _mm_loadu_ps(centerBY + i));
+            const __m128 radiusSums = _mm_loadu_ps(radiusSum + i);
+
+            const __m128 squareDistances = _mm_add_ps(_mm_mul_ps(deltaX, deltaX), _mm_mul_ps(deltaY, deltaY));
+            const __m128 isOverlapping = _mm_cmple_ps(squareDistances, _mm_mul_ps(radiusSums, radiusSums));
+
+            StoreMask(_mm_movemask_ps(isOverlapping), overlaps + i, 4);
+        }
+
+        return i;
+    }
+
+    /**
+     * @brief RectanglesSse tests the rectangle pairs 4 by 4 and gives the index of the first pair that has not
+     * been tested.
+     */
+    static std::size_t RectanglesSse(const float* minAX, const float* minAY, const float* maxAX, const float* maxAY,
+                                     const float* minBX, const float* minBY, const float* maxBX, const float* maxBY,
+                                     std::uint8_t* overlaps, std::size_t count) noexcept
+    {
+        std::size_t i = 0;
+
+        for (; i + 4 <= count; i += 4)
+        {
+            const __m128 isSeparatedX = _mm_or_ps(_mm_cmplt_ps(_mm_loadu_ps(maxAX + i), _mm_loadu_ps(minBX + i)),
+                                                  _mm_cmpgt_ps(_mm_loadu_ps(minAX + i), _mm_loadu_ps(maxBX + i)));
+            const __m128 isSeparatedY = _mm_or_ps(_mm_cmplt_ps(_mm_loadu_ps(maxAY + i), _mm_loadu_ps(minBY + i)),
+                                                  _mm_cmpgt_ps(_mm_loadu_ps(minAY + i), _mm_loadu_ps(maxBY + i)));
+
+            const int separatedMask = _mm_movemask_ps(_mm_or_ps(isSeparatedX, isSeparatedY));
+
+            StoreMask(~separatedMask, overlaps + i, 4);
+        }
+
+        return i;
+    }
+
+    /**
+     * @brief CirclesAvx2 tests the circle pairs 8 by 8 and gives the index of the first pair that has not
+     * been tested.
+     * @note This function is compiled for AVX2 whatever the compilation flags, it must only be called
+     * when the CPU supports AVX2.
+     */
+    static TARGET_AVX2 std::size_t CirclesAvx2(const float* centerAX, const float* centerAY,
+                                               const float* centerBX, const float* centerBY, const float* radiusSum,
+                                               std::uint8_t* overlaps, std::size_t count) noexcept
+    {
+        std::size_t i = 0;
+
+        for (; i + 8 <= count; i += 8)
+        {
+            const __m256 deltaX = _mm256_sub_ps(_mm256_loadu_ps(centerAX + i), _mm256_loadu_ps(centerBX + i));
+            const __m256 deltaY = _mm256_sub_ps(_mm256_loadu_ps(centerAY + i), _mm256_loadu_ps(centerBY + i));
+            const __m256 radiusSums = _mm256_loadu_ps(radiusSum + i);
+
+            const __m256 squareDistances = _mm256_add_ps(_mm256_mul_ps(deltaX, deltaX),
+                                                         _mm256_mul_ps(deltaY, deltaY));
+            const __m256 isOverlapping = _mm256_cmp_ps(squareDistances, _mm256_mul_ps(radiusSums, radiusSums),
+                                                       _CMP_LE_OQ);
+
+            StoreMask(_mm256_movemask_ps(isOverlapping), overlaps + i, 8);
+        }
+
+        return i;
+    }
+
+    /**
+     * @brief RectanglesAvx2 tests the rectangle pairs 8 by 8 and gives the index of the first pair that has not
+     * been tested.
+     * @note This function is compiled for AVX2 whatever the compilation flags, it must only be called
+     * when the CPU supports AVX2.
+     */
+    static TARGET_AVX2 std::size_t RectanglesAvx2(const float* minAX, const float* minAY,
+                                                  const float* maxAX, const float* maxAY,
+                                                  const float* minBX, const float* minBY,
+                                                  const float* maxBX, const float* maxBY,
+                                                  std::uint8_t* overlaps, std::size_t count) noexcept
+    {
+        std::size_t i = 0;
+
+        for (; i + 8 <= count; i += 8)
+        {
+            const __m256 isSeparatedX = _mm256_or_ps(
+                _mm256_cmp_ps(_mm256_loadu_ps(maxAX + i), _mm256_loadu_ps(minBX + i), _CMP_LT_OQ),
+                _mm256_cmp_ps(_mm256_loadu_ps(minAX + i), _mm256_loadu_ps(maxBX + i), _CMP_GT_OQ));
+            const __m256 isSeparatedY = _mm256_or_ps(
+                _mm256_cmp_ps(_mm256_loadu_ps(maxAY + i), _mm256_loadu_ps(minBY + i), _CMP_LT_OQ),
+                _mm256_cmp_ps(_mm256_loadu_ps(minAY + i), _mm256_loadu_ps(maxBY + i), _CMP_GT_OQ));
+
+            const int separatedMask = _mm256_movemask_ps(_mm256_or_ps(isSeparatedX, isSeparatedY));
+
+            StoreMask(~separatedMask, overlaps + i, 8);
+        }
+
+        return i;
+    }
+
+#endif // __SSE__
+
+    void NarrowPhaseBatch::Run(const SimdLevel kernel, AllocVector<ColliderPair>& overlappingPairs) noexcept
+    {
+    #ifdef TRACY_ENABLE
+            ZoneScoped;
+            ZoneValue(_circlePairs.size() + _rectanglePairs.size());
+    #endif // TRACY_ENABLE
+
+        const auto circleCount = _circlePairs.size();
+        const auto rectangleCount = _rectanglePairs.size();
+
+        _overlaps.resize(std::max(circleCount, rectangleCount));
+        std::uint8_t* overlaps = _overlaps.data();
+
+        // Circle-circle pairs.
+        std::size_t testedCount = 0;
+
+    #ifdef __SSE__
+        switch (kernel)
+        {
+            case SimdLevel::Avx2:
+                testedCount = CirclesAvx2(_circleCentersAX.data(), _circleCentersAY.data(),
+                                          _circleCentersBX.data(), _circleCentersBY.data(), _radiusSums.data(),
+                                          overlaps, circleCount);
+                break;
+            case SimdLevel::Sse:
+                testedCount = CirclesSse(_circleCentersAX.data(), _circleCentersAY.data(),
+                                         _circleCentersBX.data(), _circleCentersBY.data(), _radiusSums.data(),
+                                         overlaps, circleCount);
+                break;
+            case SimdLevel::Scalar:
+                break;
+        }
+    #endif // __SSE__
+
+        CirclesScalar(_circleCentersAX.data(), _circleCentersAY.data(),
+                      _circleCentersBX.data(), _circleCentersBY.data(), _radiusSums.data(),
+                      overlaps, testedCount, circleCount);
+
+        for (std::size_t i = 0; i < circleCount; i++)
+        {
+            if (overlaps[i]) overlappingPairs.push_back(_circlePairs[i]);
+        }
+
+        // Rectangle-rectangle pairs.
+        testedCount = 0;
+
+    #ifdef __SSE__
+        switch (kernel)
+        {
+            case SimdLevel::Avx2:
+                testedCount = RectanglesAvx2(_rectMinBoundsAX.data(), _rectMinBoundsAY.data(),
+                                             _rectMaxBoundsAX.data(), _rectMaxBoundsAY.data(),
+                                             _rectMinBoundsBX.data(), _rectMinBoundsBY.data(),
+                                             _rectMaxBoundsBX.data(), _rectMaxBoundsBY.data(),
+                                             overlaps, rectangleCount);
+                break;
+            case SimdLevel::Sse:
+                testedCount = RectanglesSse(_rectMinBoundsAX.data(), _rectMinBoundsAY.data(),
+                                            _rectMaxBoundsAX.data(), _rectMaxBoundsAY.data(),
+                                            _rectMinBoundsBX.data(), _rectMinBoundsBY.data(),
+                                            _rectMaxBoundsBX.data(), _rectMaxBoundsBY.data(),
+                                            overlaps, rectangleCount);
+                break;
+            case SimdLevel::Scalar:
+                break;
+        }
+    #endif // __SSE__
+
+        RectanglesScalar(_rectMinBoundsAX.data(), _rectMinBoundsAY.data(),
+                         _rectMaxBoundsAX.data(), _rectMaxBoundsAY.data(),
+                         _rectMinBoundsBX.data(), _rectMinBoundsBY.data(),
+                         _rectMaxBoundsBX.data(), _rectMaxBoundsBY.data(),
+                         overlaps, testedCount, rectangleCount);
+
+        for (std::size_t i = 0; i < rectangleCount; i++)
+        {
+            if (overlaps[i]) overlappingPairs.push_back(_rectanglePairs[i]);
+        }
+    }
+
+    void NarrowPhaseBatch::Clear() noexcept
+    {
+        _circleCentersAX.clear();
+        _circleCentersAY.clear();
+        _circleCentersBX.clear();
+        _circleCentersBY.clear();
+        _radiusSums.clear();
+        _circlePairs.clear();
+
+        _rectMinBoundsAX.clear();
+        _rectMinBoundsAY.clear();
+        _rectMaxBoundsAX.clear();
+        _rectMaxBoundsAY.clear();
+        _rectMinBoundsBX.clear();
+        _rectMinBoundsBY.clear();
+        _rectMaxBoundsBX.clear();
+        _rectMaxBoundsBY.clear();
+        _rectanglePairs.clear();
+
+        for (auto& bucket : _pairBuckets)
+        {
+            bucket.clear();
+        }
+    }
+}
@@ -4,6 +4,9 @@
 
 #include "QuadTree.h"
 
+#include <algorithm>
+#include <limits>
+
 #ifdef TRACY_ENABLE
 #include <Tracy.hpp>
 #endif // TRACY_ENABLE
@@ -37,17 +40,90 @@ namespace PhysicsEngine
         {
             node.Colliders.reserve(QuadNode::MaxColliderNbr + 1);
         }
+
+        while (_quadrantColliders.size() < QuadNode::BoundaryDivisionCount)
+        {
+            _quadrantColliders.emplace_back(StandardAllocator<SimplifiedCollider>{_heapAllocator});
+        }
+
+        // One more output for the pairs of the root node colliders.
+        while (_subtreePairs.size() < QuadNode::BoundaryDivisionCount + 1)
+        {
+            _subtreePairs.emplace_back(StandardAllocator<ColliderPair>{_heapAllocator});
+        }
     }
 
     void QuadTree::Insert(Math::RectangleF simplifiedShape, ColliderRef colliderRef) noexcept
     {
-        insertInNode(_nodes[0], simplifiedShape, colliderRef, 0);
+        insertInNode(_nodes[0], simplifiedShape, colliderRef, 0, _nodeIndex);
+    }
+
+    void QuadTree::subdivide(QuadNode& node, int& nodeIndex) noexcept
+    {
+        // Subdivide the node rectangle in 4 rectangle.
+        const auto center = node.Boundary.Center();
+        const auto halfSize = node.Boundary.HalfSize();
+
+        const auto topMiddle = Math::Vec2F(center.X, center.Y + halfSize.Y);
+        const auto topRightCorner = center + halfSize;
+        const auto rightMiddle = Math::Vec2F(center.X + halfSize.X, center.Y);
+        const auto bottomMiddle = Math::Vec2F(center.X, center.Y - halfSize.Y);
+        const auto bottomLeftCorner = center - halfSize;
+        const auto leftMiddle = Math::Vec2F(center.X - halfSize.X, center.Y);
+
+        node.Children[0] = &_nodes[nodeIndex];
+        node.Children[1] = &_nodes[nodeIndex + 1];
+        node.Children[2] = &_nodes[nodeIndex + 2];
+        node.Children[3] = &_nodes[nodeIndex + 3];
+
+        nodeIndex += 4;
+
+        node.Children[0]->Boundary = Math::RectangleF(leftMiddle, topMiddle);
+        node.Children[1]->Boundary = Math::RectangleF(center, topRightCorner);
+        node.Children[2]->Boundary = Math::RectangleF(bottomLeftCorner, center);
+        node.Children[3]->Boundary = Math::RectangleF(bottomMiddle, rightMiddle);
+
+        for (const auto& child : node.Children)
+        {
+            child->LooseBoundary = Math::RectangleF::FromCenter(child->Boundary.Center(),
+                                                                child->Boundary.HalfSize() * _looseness);
+        }
+    }
+
+    QuadNode* QuadTree::childToInsertIn(const QuadNode& node, const Math::RectangleF simplifiedShape) const noexcept
+    {
+        if (IsLoose())
+        {
+            // The children are in the order top-left, top-right, bottom-left and bottom-right.
+            const auto center = node.Boundary.Center();
+            const auto shapeCenter = simplifiedShape.Center();
+            const std::size_t childIdx = (shapeCenter.Y >= center.Y ? 0 : 2) + (shapeCenter.X >= center.X ? 1 : 0);
+
+            QuadNode* child = node.Children[childIdx];
+
+            return child->LooseBoundary.Contains(simplifiedShape) ? child : nullptr;
+        }
+
+        int boundInterestCount = 0;
+        QuadNode* intersectNode = nullptr;
+
+        for (const auto& child : node.Children)
+        {
+            if (Math::Intersect(child->Boundary, simplifiedShape))
+            {
+                boundInterestCount++;
+                intersectNode = child;
+            }
+        }
+
+        return boundInterestCount == 1 ? intersectNode : nullptr;
     }
 
     void QuadTree::insertInNode(QuadNode& node,
         Math::RectangleF simplifiedShape,
         ColliderRef colliderRef,
-        int depth) noexcept
+        int depth,
+        int& nodeIndex) noexcept
     {
         #ifdef TRACY_ENABLE
                 ZoneScoped;
@@ -57,8 +133,7 @@ namespace PhysicsEngine
         if (node.Children[0] == nullptr)
         {
             // Add the simplified collider to the node.
-            SimplifiedCollider simplifiedCollider = { colliderRef, simplifiedShape };
-            node.Colliders.push_back(simplifiedCollider);
+            addToNode(node, { colliderRef, simplifiedShape });
 
             // If the node has fewer colliders than the max number and the depth is not equal to the max depth.
             if (node.Colliders.size() > QuadNode::MaxColliderNbr && depth != _maxDepth)
@@ -67,29 +142,8 @@ namespace PhysicsEngine
                     ZoneNamed(SubDivision, "Sub-division", true);
             #endif
 
-                // Subdivide the node rectangle in 4 rectangle.
-                const auto center = node.Boundary.Center();
-                const auto halfSize = node.Boundary.HalfSize();
-
-                const auto topMiddle = Math::Vec2F(center.X, center.Y + halfSize.Y);
-                const auto topRightCorner = center + halfSize;
-                const auto rightMiddle = Math::Vec2F(center.X + halfSize.X, center.Y);
-                const auto bottomMiddle = Math::Vec2F(center.X, center.Y - halfSize.Y);
-                const auto bottomLeftCorner = center - halfSize;
-                const auto leftMiddle = Math::Vec2F(center.X - halfSize.X, center.Y);
-
-                node.Children[0] = &_nodes[_nodeIndex];
-                node.Children[1] = &_nodes[_nodeIndex + 1];
-                node.Children[2] = &_nodes[_nodeIndex + 2];
-                node.Children[3] = &_nodes[_nodeIndex + 3];
+                subdivide(node, nodeIndex);
 
-                _nodeIndex += 4;
-
-                node.Children[0]->Boundary = Math::RectangleF(leftMiddle, topMiddle);
-                node.Children[1]->Boundary = Math::RectangleF(center, topRightCorner);
-                node.Children[2]->Boundary = Math::RectangleF(bottomLeftCorner, center);
-                node.Children[3]->Boundary = Math::RectangleF(bottomMiddle, rightMiddle);
-                
                 std::array<SimplifiedCollider, QuadNode::MaxColliderNbr + 1> remainingColliders;
                 
                 for (std::size_t i = 0; i < QuadNode::MaxColliderNbr + 1; i++)
@@ -101,25 +155,15 @@ namespace PhysicsEngine
 
                 for (const auto& col : remainingColliders)
                 {
-                    int boundInterestCount = 0;
-                    QuadNode* intersectNode = nullptr;
+                    QuadNode* intersectNode = childToInsertIn(node, col.Rectangle);
 
-                    for (const auto& child : node.Children)
+                    if (intersectNode != nullptr)
                     {
-                        if (Math::Intersect(child->Boundary, col.Rectangle))
-                        {
-                            boundInterestCount++;
-                            intersectNode = child;
-                        }
-                    }
-
-                    if (boundInterestCount == 1)
-                    {
-                        insertInNode(*intersectNode, col.Rectangle, col.ColRef, depth + 1);
+                        insertInNode(*intersectNode, col.Rectangle, col.ColRef, depth + 1, nodeIndex);
                     }
                     else
                     {
-                        node.Colliders.push_back(col);
+                        addToNode(node, col);
                     }
                 }
             }
@@ -128,40 +172,486 @@ namespace PhysicsEngine
         // If the node has children.
         else
         {
-            int boundInterestCount = 0;
-            QuadNode* intersectNode = nullptr;
+            QuadNode* intersectNode = childToInsertIn(node, simplifiedShape);
 
-            for (const auto& child : node.Children)
+            if (intersectNode != nullptr)
             {
-                if (Math::Intersect(child->Boundary, simplifiedShape))
+                insertInNode(*intersectNode, simplifiedShape, colliderRef, depth + 1, nodeIndex);
+            }
+            else
+            {
+                addToNode(node, { colliderRef, simplifiedShape });
+            }
+        }
+    }
+
+    void QuadTree::Update(const AllocVector<SimplifiedCollider>& colliders) noexcept
+    {
+    #ifdef TRACY_ENABLE
+            ZoneScoped;
+            ZoneValue(colliders.size());
+    #endif
+
+        if (_isPersistent)
+        {
+            for (const auto& simplCol : colliders)
+            {
+                UpdateProxy(simplCol.Rectangle, simplCol.ColRef);
+            }
+
+            // The colliders that were not given anymore have been disabled or destroyed.
+            for (auto& proxy : _proxies)
+            {
+                if (proxy.Enabled && !proxy.Updated)
                 {
-                    boundInterestCount++;
-                    intersectNode = child;
+                    RemoveProxy(proxy.ColRef);
                 }
+
+                proxy.Updated = false;
             }
 
-            if (boundInterestCount == 1)
+            UpdatePossiblePairs();
+            return;
+        }
+
+        Clear();
+
+        // Sets the minimum and maximum collision zone limits of the world rectangle to floating maximum and
+        // lowest values.
+        Math::Vec2F worldMinBound(std::numeric_limits<float>::max(), std::numeric_limits<float>::max());
+        Math::Vec2F worldMaxBound(std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest());
+
+        // Adjust the size of the collision zone in the world rectangle to the most distant colliders.
+        for (const auto& simplCol : colliders)
+        {
+            const auto colCenter = simplCol.Rectangle.Center();
+
+            worldMinBound = Math::Vec2F(std::min(worldMinBound.X, colCenter.X), std::min(worldMinBound.Y, colCenter.Y));
+            worldMaxBound = Math::Vec2F(std::max(worldMaxBound.X, colCenter.X), std::max(worldMaxBound.Y, colCenter.Y));
+        }
+
+        // Set the first rectangle of the quad-tree to calculated collision area rectangle.
+        SetRootNodeBoundary(Math::RectangleF(worldMinBound, worldMaxBound));
+
+        if (_jobSystem != nullptr && _jobSystem->WorkerCount() > 0 &&
+            colliders.size() >= _parallelBuildMinColliderCount)
+        {
+            buildInParallel(colliders);
+            return;
+        }
+
+        for (const auto& simplCol : colliders)
+        {
+            Insert(simplCol.Rectangle, simplCol.ColRef);
+        }
+
+        CalculatePossiblePairs();
+    }
+
+    void QuadTree::SetPersistent(const bool isPersistent) noexcept
+    {
+        if (_isPersistent == isPersistent) return;
+
+        // The quad-tree is filled differently in the two modes, so it must start again from scratch.
+        Clear();
+        _isPersistent = isPersistent;
+    }
+
+    void QuadTree::SetLooseness(const float looseness) noexcept
+    {
+        const auto newLooseness = std::max(looseness, 1.f);
+
+        if (_looseness == newLooseness) return;
+
+        // The colliders are in other nodes with another looseness, so the quad-tree must start again from scratch.
+        Clear();
+        _looseness = newLooseness;
+    }
+
+    void QuadTree::addToNode(QuadNode& node, const SimplifiedCollider simplifiedCollider) noexcept
+    {
+        node.Colliders.push_back(simplifiedCollider);
+
+        const auto index = simplifiedCollider.ColRef.Index;
+
+        if (index < _proxies.size() && _proxies[index].Enabled && _proxies[index].ColRef == simplifiedCollider.ColRef)
+        {
+            _proxies[index].Node = &node;
+        }
+    }
+
+    void QuadTree::removeFromNode(QuadProxy& proxy) noexcept
+    {
+        if (proxy.Node == nullptr) return;
+
+        auto& colliders = proxy.Node->Colliders;
+
+        const auto it = std::find_if(colliders.begin(), colliders.end(),
+                                     [&proxy](const SimplifiedCollider& simplCol)
+                                     {
+                                         return simplCol.ColRef == proxy.ColRef;
+                                     });
+
+        if (it != colliders.end())
+        {
+            // The order of the colliders in a node doesn't matter, so swap with the last one to avoid shifting.
+            *it = colliders.back();
+            colliders.pop_back();
+        }
+
+        proxy.Node = nullptr;
+    }
+
+    void QuadTree::markMoved(const std::size_t proxyIndex) noexcept
+    {
+        auto& proxy = _proxies[proxyIndex];
+
+        if (proxy.Moved) return;
+
+        proxy.Moved = true;
+        _movedProxies.push_back(proxyIndex);
+    }
+
+    bool QuadTree::isProxyStale(const ColliderRef colliderRef) const noexcept
+    {
+        if (colliderRef.Index >= _proxies.size()) return true;
+
+        const auto& proxy = _proxies[colliderRef.Index];
+
+        return !proxy.Enabled || proxy.Moved || !(proxy.ColRef == colliderRef);
+    }
+
+    void QuadTree::UpdateProxy(const Math::RectangleF simplifiedShape, const ColliderRef colliderRef) noexcept
+    {
+        if (colliderRef.Index >= _proxies.size())
+        {
+            _proxies.resize(colliderRef.Index + 1);
+        }
+
+        auto& proxy = _proxies[colliderRef.Index];
+        proxy.Updated = true;
+
+        // The collider stays in its node as long as its simplified shape is inside its fat rectangle.
+        if (proxy.Enabled && proxy.ColRef == colliderRef && proxy.FatRectangle.Contains(simplifiedShape))
+        {
+            return;
+        }
+
+        if (proxy.Enabled)
+        {
+            removeFromNode(proxy);
+        }
+
+        const Math::Vec2F margin(_fatMargin, _fatMargin);
+
+        proxy.ColRef = colliderRef;
+        proxy.FatRectangle = Math::RectangleF(simplifiedShape.MinBound() - margin,
+                                              simplifiedShape.MaxBound() + margin);
+        proxy.Enabled = true;
+
+        markMoved(colliderRef.Index);
+
+        // The nodes only contain the colliders that are inside their boundary if the root node contains all
+        // of them, otherwise the quad-tree must be rebuilt with a bigger root node.
+        if (!_needsRebuild && _nodes[0].Boundary.Contains(proxy.FatRectangle))
+        {
+            insertInNode(_nodes[0], proxy.FatRectangle, colliderRef, 0, _nodeIndex);
+        }
+        else
+        {
+            _needsRebuild = true;
+        }
+    }
+
+    void QuadTree::RemoveProxy(const ColliderRef colliderRef) noexcept
+    {
+        if (colliderRef.Index >= _proxies.size()) return;
+
+        auto& proxy = _proxies[colliderRef.Index];
+
+        if (!proxy.Enabled || !(proxy.ColRef == colliderRef)) return;
+
+        removeFromNode(proxy);
+        proxy.Enabled = false;
+
+        _hasRemovedProxies = true;
+    }
+
+    void QuadTree::UpdatePossiblePairs() noexcept
+    {
+    #ifdef TRACY_ENABLE
+            ZoneScoped;
+            ZoneValue(_movedProxies.size());
+    #endif
+
+        _pairTestCount = 0;
+
+        if (_needsRebuild)
+        {
+            rebuild();
+        }
+        else if (!_movedProxies.empty() || _hasRemovedProxies)
+        {
+            // Remove the pairs whose colliders have moved or have been removed.
+            _possiblePairs.erase(std::remove_if(_possiblePairs.begin(), _possiblePairs.end(),
+                                                [this](const ColliderPair& pair)
+                                                {
+                                                    return isProxyStale(pair.ColliderA) ||
+                                                           isProxyStale(pair.ColliderB);
+                                                }),
+                                 _possiblePairs.end());
+
+            for (const auto proxyIndex : _movedProxies)
             {
-                insertInNode(*intersectNode, simplifiedShape, colliderRef, depth + 1);
+                const auto& proxy = _proxies[proxyIndex];
+
+                if (!proxy.Enabled) continue;
+
+                queryNodePossiblePairs(_nodes[0], proxy);
             }
-            else
+        }
+
+        for (const auto proxyIndex : _movedProxies)
+        {
+            _proxies[proxyIndex].Moved = false;
+        }
+
+        _movedProxies.clear();
+        _hasRemovedProxies = false;
+    }
+
+    void QuadTree::queryNodePossiblePairs(const QuadNode& node, const QuadProxy& proxy) noexcept
+    {
+        for (const auto& simplCol : node.Colliders)
+        {
+            if (simplCol.ColRef == proxy.ColRef) continue;
+
+            _pairTestCount++;
+
+            if (!Math::Intersect(proxy.FatRectangle, simplCol.Rectangle)) continue;
+
+            // If both colliders have moved, the pair is only added by the collider with the lowest index.
+            const auto& otherProxy = _proxies[simplCol.ColRef.Index];
+
+            if (otherProxy.Moved && otherProxy.ColRef.Index < proxy.ColRef.Index) continue;
+
+            _possiblePairs.push_back(ColliderPair{ proxy.ColRef, simplCol.ColRef });
+        }
+
+        if (node.Children[0] != nullptr)
+        {
+            // The loose boundary of a child is its boundary when the quad-tree is tight.
+            for (const auto& child : node.Children)
             {
-                SimplifiedCollider simplifiedCollider = { colliderRef, simplifiedShape };
-                node.Colliders.push_back(simplifiedCollider);
+                if (Math::Intersect(child->LooseBoundary, proxy.FatRectangle))
+                {
+                    queryNodePossiblePairs(*child, proxy);
+                }
             }
         }
     }
 
+    void QuadTree::rebuild() noexcept
+    {
+    #ifdef TRACY_ENABLE
+            ZoneScoped;
+    #endif
+
+        for (auto& node : _nodes)
+        {
+            node.Colliders.clear();
+
+            std::fill(node.Children.begin(), node.Children.end(), nullptr);
+        }
+
+        _nodeIndex = 1;
+        _possiblePairs.clear();
+
+        Math::Vec2F minBound(std::numeric_limits<float>::max(), std::numeric_limits<float>::max());
+        Math::Vec2F maxBound(std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest());
+
+        for (auto& proxy : _proxies)
+        {
+            proxy.Node = nullptr;
+
+            if (!proxy.Enabled) continue;
+
+            const auto fatMinBound = proxy.FatRectangle.MinBound();
+            const auto fatMaxBound = proxy.FatRectangle.MaxBound();
+
+            minBound = Math::Vec2F(std::min(minBound.X, fatMinBound.X), std::min(minBound.Y, fatMinBound.Y));
+            maxBound = Math::Vec2F(std::max(maxBound.X, fatMaxBound.X), std::max(maxBound.Y, fatMaxBound.Y));
+        }
+
+        // No enabled proxy, keep the tree empty until the next rebuild.
+        if (minBound.X > maxBound.X)
+        {
+            _nodes[0].Boundary = Math::RectangleF(Math::Vec2F::Zero(), Math::Vec2F::Zero());
+            _needsRebuild = true;
+            return;
+        }
+
+        const auto rootMargin = (maxBound - minBound) * _rootMarginFactor + Math::Vec2F(_fatMargin, _fatMargin);
+        _nodes[0].Boundary = Math::RectangleF(minBound - rootMargin, maxBound + rootMargin);
+
+        for (const auto& proxy : _proxies)
+        {
+            if (!proxy.Enabled) continue;
+
+            insertInNode(_nodes[0], proxy.FatRectangle, proxy.ColRef, 0, _nodeIndex);
+        }
+
+        CalculatePossiblePairs();
+
+        _needsRebuild = false;
+    }
+
     void QuadTree::CalculatePossiblePairs() noexcept
     {
     #ifdef TRACY_ENABLE
             ZoneScoped;
     #endif
 
-        calculateNodePossiblePairs(_nodes[0]);
+        _pairTestCount = 0;
+
+        if (IsLoose())
+        {
+            calculateLooseNodePossiblePairs(_nodes[0], _possiblePairs, _pairTestCount);
+        }
+        else
+        {
+            calculateNodePossiblePairs(_nodes[0], _possiblePairs, _pairTestCount);
+        }
     }
 
-    void QuadTree::calculateNodePossiblePairs(const QuadNode& node) noexcept
+    void QuadTree::buildInParallel(const AllocVector<SimplifiedCollider>& colliders) noexcept
+    {
+    #ifdef TRACY_ENABLE
+            ZoneScoped;
+            ZoneValue(colliders.size());
+    #endif
+
+        auto& rootNode = _nodes[0];
+        subdivide(rootNode, _nodeIndex);
+
+        // Bin the colliders in the child of the root node they are in, the ones on several children stay
+        // in the root node as in a sequential insertion.
+        for (auto& quadrantColliders : _quadrantColliders)
+        {
+            quadrantColliders.clear();
+        }
+
+        for (const auto& simplCol : colliders)
+        {
+            const auto* quadrant = childToInsertIn(rootNode, simplCol.Rectangle);
+
+            if (quadrant != nullptr)
+            {
+                const auto quadrantIdx = std::find(rootNode.Children.begin(), rootNode.Children.end(), quadrant) -
+                                         rootNode.Children.begin();
+
+                _quadrantColliders[quadrantIdx].push_back(simplCol);
+            }
+            else
+            {
+                addToNode(rootNode, simplCol);
+            }
+        }
+
+        // A child of the root node has at most QuadCount(_maxDepth - 1) - 1 descendants.
+        const int subtreeNodeCount = QuadCount(_maxDepth - 1) - 1;
+        const int firstSubtreeNodeIndex = _nodeIndex;
+
+        for (auto& subtreePairs : _subtreePairs)
+        {
+            subtreePairs.clear();
+        }
+
+        _subtreePairTestCounts.fill(0);
+
+        const bool isLoose = IsLoose();
+
+        _jobSystem->ParallelFor(QuadNode::BoundaryDivisionCount, [&](const std::size_t jobIdx)
+        {
+            auto& child = *rootNode.Children[jobIdx];
+            auto& subtreePairs = _subtreePairs[jobIdx];
+            auto& pairTestCount = _subtreePairTestCounts[jobIdx];
+            int nodeIndex = firstSubtreeNodeIndex + static_cast<int>(jobIdx) * subtreeNodeCount;
+
+            for (const auto& simplCol : _quadrantColliders[jobIdx])
+            {
+                insertInNode(child, simplCol.Rectangle, simplCol.ColRef, 1, nodeIndex);
+            }
+
+            // The loose boundaries of the subtrees overlap, so their pairs are found once all of them are built.
+            if (isLoose) return;
+
+            calculateNodePossiblePairs(child, subtreePairs, pairTestCount);
+
+            // The root node colliders are only read, so each subtree compares them with its own colliders.
+            for (const auto& rootSimplCol : rootNode.Colliders)
+            {
+                calculateChildrenNodePossiblePairs(child, rootSimplCol, subtreePairs, pairTestCount);
+            }
+        });
+
+        _nodeIndex = firstSubtreeNodeIndex + QuadNode::BoundaryDivisionCount * subtreeNodeCount;
+
+        auto& rootPairs = _subtreePairs[QuadNode::BoundaryDivisionCount];
+        auto& rootPairTestCount = _subtreePairTestCounts[QuadNode::BoundaryDivisionCount];
+
+        if (isLoose)
+        {
+            // The built quad-tree is only read, so each subtree queries it with its own colliders.
+            _jobSystem->ParallelFor(QuadNode::BoundaryDivisionCount, [&](const std::size_t jobIdx)
+            {
+                calculateLooseNodePossiblePairs(*rootNode.Children[jobIdx], _subtreePairs[jobIdx],
+                                                _subtreePairTestCounts[jobIdx]);
+            });
+
+            for (const auto& rootSimplCol : rootNode.Colliders)
+            {
+                queryLooseNodePossiblePairs(rootNode, rootSimplCol, rootPairs, rootPairTestCount);
+            }
+        }
+        else
+        {
+            // The pairs between the colliders of the root node.
+            for (std::size_t i = 0; i < rootNode.Colliders.size(); i++)
+            {
+                for (std::size_t j = i + 1; j < rootNode.Colliders.size(); j++)
+                {
+                    rootPairTestCount++;
+
+                    if (Math::Intersect(rootNode.Colliders[i].Rectangle, rootNode.Colliders[j].Rectangle))
+                    {
+                        rootPairs.push_back(ColliderPair{ rootNode.Colliders[i].ColRef,
+                                                          rootNode.Colliders[j].ColRef });
+                    }
+                }
+            }
+        }
+
+        _pairTestCount = 0;
+
+        for (const auto subtreePairTestCount : _subtreePairTestCounts)
+        {
+            _pairTestCount += subtreePairTestCount;
+        }
+
+        _possiblePairs.insert(_possiblePairs.end(),
+                              _subtreePairs[QuadNode::BoundaryDivisionCount].begin(),
+                              _subtreePairs[QuadNode::BoundaryDivisionCount].end());
+
+        for (std::size_t i = 0; i < QuadNode::BoundaryDivisionCount; i++)
+        {
+            _possiblePairs.insert(_possiblePairs.end(), _subtreePairs[i].begin(), _subtreePairs[i].end());
+        }
+    }
+
+    void QuadTree::calculateNodePossiblePairs(const QuadNode& node,
+                                              AllocVector<ColliderPair>& possiblePairs,
+                                              std::size_t& pairTestCount) noexcept
     {
     #ifdef TRACY_ENABLE
             ZoneScoped;
@@ -175,9 +665,11 @@ namespace PhysicsEngine
             {
                 auto& simplColB = node.Colliders[j];
 
+                pairTestCount++;
+
                 if (Math::Intersect(simplColA.Rectangle, simplColB.Rectangle))
                 {
-                    _possiblePairs.push_back(ColliderPair{ simplColA.ColRef, simplColB.ColRef });
+                    possiblePairs.push_back(ColliderPair{ simplColA.ColRef, simplColB.ColRef });
                 }
             }
 
@@ -187,7 +679,7 @@ namespace PhysicsEngine
             {
                 for (const auto& childNode : node.Children)
                 {
-                    calculateChildrenNodePossiblePairs(*childNode, simplColA);
+                    calculateChildrenNodePossiblePairs(*childNode, simplColA, possiblePairs, pairTestCount);
                 }
             }
         }
@@ -197,12 +689,15 @@ namespace PhysicsEngine
         {
             for (const auto& child : node.Children)
             {
-                calculateNodePossiblePairs(*child);
+                calculateNodePossiblePairs(*child, possiblePairs, pairTestCount);
             }
         }
     }
 
-    void QuadTree::calculateChildrenNodePossiblePairs(const QuadNode& node, SimplifiedCollider simplCol) noexcept
+    void QuadTree::calculateChildrenNodePossiblePairs(const QuadNode& node,
+                                                      SimplifiedCollider simplCol,
+                                                      AllocVector<ColliderPair>& possiblePairs,
+                                                      std::size_t& pairTestCount) noexcept
     {
     #ifdef TRACY_ENABLE
             ZoneScoped;
@@ -211,9 +706,11 @@ namespace PhysicsEngine
         // For each colliders in the current node, compare it with the simplified collider from its parent node.
         for (const auto& nodeSimplCol : node.Colliders)
         {
+            pairTestCount++;
+
             if (Math::Intersect(simplCol.Rectangle, nodeSimplCol.Rectangle))
             {
-                _possiblePairs.push_back(ColliderPair{ simplCol.ColRef, nodeSimplCol.ColRef });
+                possiblePairs.push_back(ColliderPair{ simplCol.ColRef, nodeSimplCol.ColRef });
             }
         }
 
@@ -222,7 +719,60 @@ namespace PhysicsEngine
         {
             for (const auto& child : node.Children)
             {
-                calculateChildrenNodePossiblePairs(*child, simplCol);
+                calculateChildrenNodePossiblePairs(*child, simplCol, possiblePairs, pairTestCount);
+            }
+        }
+    }
+
+    void QuadTree::calculateLooseNodePossiblePairs(const QuadNode& node,
+                                                   AllocVector<ColliderPair>& possiblePairs,
+                                                   std::size_t& pairTestCount) const noexcept
+    {
+    #ifdef TRACY_ENABLE
+            ZoneScoped;
+    #endif
+
+        for (const auto& simplCol : node.Colliders)
+        {
+            queryLooseNodePossiblePairs(_nodes[0], simplCol, possiblePairs, pairTestCount);
+        }
+
+        if (node.Children[0] != nullptr)
+        {
+            for (const auto& child : node.Children)
+            {
+                calculateLooseNodePossiblePairs(*child, possiblePairs, pairTestCount);
+            }
+        }
+    }
+
+    void QuadTree::queryLooseNodePossiblePairs(const QuadNode& node,
+                                               const SimplifiedCollider simplCol,
+                                               AllocVector<ColliderPair>& possiblePairs,
+                                               std::size_t& pairTestCount) const noexcept
+    {
+        for (const auto& nodeSimplCol : node.Colliders)
+        {
+            // The other collider finds the pair too when it queries the quad-tree.
+            if (!(simplCol.ColRef < nodeSimplCol.ColRef)) continue;
+
+            pairTestCount++;
+
+            if (Math::Intersect(simplCol.Rectangle, nodeSimplCol.Rectangle))
+            {
+                possiblePairs.push_back(ColliderPair{ simplCol.ColRef, nodeSimplCol.ColRef });
+            }
+        }
+
+        if (node.Children[0] != nullptr)
+        {
+            // The colliders of a child and of its children are inside its loose boundary.
+            for (const auto& child : node.Children)
+            {
+                if (Math::Intersect(child->LooseBoundary, simplCol.Rectangle))
+                {
+                    queryLooseNodePossiblePairs(*child, simplCol, possiblePairs, pairTestCount);
+                }
             }
         }
     }
@@ -243,6 +793,12 @@ namespace PhysicsEngine
         _nodeIndex = 1;
 
         _possiblePairs.clear();
+        _pairTestCount = 0;
+
+        _proxies.clear();
+        _movedProxies.clear();
+        _needsRebuild = true;
+        _hasRemovedProxies = false;
     }
 
     void QuadTree::Deinit() noexcept
@@ -252,9 +808,17 @@ namespace PhysicsEngine
 #endif // TRACY_ENABLE
 
         _nodes.clear();
+        _quadrantColliders.clear();
+        _subtreePairs.clear();
 
         _nodeIndex = 1;
 
         _possiblePairs.clear();
+        _pairTestCount = 0;
+
+        _proxies.clear();
+        _movedProxies.clear();
+        _needsRebuild = true;
+        _hasRemovedProxies = false;
     }
 }
\ No newline at end of file
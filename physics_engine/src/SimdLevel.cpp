@@ -0,0 +1,48 @@
+#include "SimdLevel.h"
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif // _MSC_VER
+
+namespace PhysicsEngine
+{
+    SimdLevel BestSimdLevel() noexcept
+    {
+    #if defined(__SSE__) && defined(_MSC_VER)
+        int cpuInfo[4];
+
+        __cpuid(cpuInfo, 0);
+        const int highestFunctionId = cpuInfo[0];
+
+        __cpuid(cpuInfo, 1);
+        const bool osUsesXsave = (cpuInfo[2] & (1 << 27)) != 0;
+        const bool cpuHasAvx = (cpuInfo[2] & (1 << 28)) != 0;
+
+        // The OS must save the AVX registers on context switches.
+        const bool osSupportsAvx = osUsesXsave && cpuHasAvx && (_xgetbv(0) & 0x6) == 0x6;
+
+        if (osSupportsAvx && highestFunctionId >= 7)
+        {
+            __cpuidex(cpuInfo, 7, 0);
+
+            if ((cpuInfo[1] & (1 << 5)) != 0)
+            {
+                return SimdLevel::Avx2;
+            }
+        }
+
+        return SimdLevel::Sse;
+    #elif defined(__SSE__)
+        __builtin_cpu_init();
+
+        if (__builtin_cpu_supports("avx2"))
+        {
+            return SimdLevel::Avx2;
+        }
+
+        return SimdLevel::Sse;
+    #else
+        return SimdLevel::Scalar;
+    #endif
+    }
+}
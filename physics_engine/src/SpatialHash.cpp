@@ -0,0 +1,249 @@
+#include "SpatialHash.h"
+
+#include <algorithm>
+#include <cmath>
+
+#ifdef TRACY_ENABLE
+#include <Tracy.hpp>
+#endif // TRACY_ENABLE
+
+namespace PhysicsEngine
+{
+    /**
+     * @brief HashCell gives the hash of the cell coordinates given in parameter.
+     */
+    [[nodiscard]] static std::size_t HashCell(const int x, const int y) noexcept
+    {
+        return static_cast<std::size_t>(static_cast<std::uint32_t>(x) * 73856093u ^
+                                        static_cast<std::uint32_t>(y) * 19349663u);
+    }
+
+    void SpatialHash::Init() noexcept
+    {
+    #ifdef TRACY_ENABLE
+            ZoneScoped;
+    #endif // TRACY_ENABLE
+
+        if (_cells.size() < _preallocatedCellCount)
+        {
+            _cells.resize(_preallocatedCellCount);
+        }
+
+        _usedCells.reserve(_preallocatedCellCount / 2);
+    }
+
+    int SpatialHash::cellCoordinate(const float value) const noexcept
+    {
+        return static_cast<int>(std::floor(value / _cellSize));
+    }
+
+    std::size_t SpatialHash::findCell(const int x, const int y) noexcept
+    {
+        auto mask = _cells.size() - 1;
+        auto slot = HashCell(x, y) & mask;
+
+        // Linear probing until the cell or a slot unused by the current step is found.
+        while (!_cells.empty() && _cells[slot].Stamp == _stamp)
+        {
+            if (_cells[slot].X == x && _cells[slot].Y == y) return slot;
+
+            slot = (slot + 1) & mask;
+        }
+
+        // Keep the load factor of the table under 0.5 so that the probe sequences stay short.
+        if ((_usedCells.size() + 1) * 2 > _cells.size())
+        {
+            grow();
+
+            mask = _cells.size() - 1;
+            slot = HashCell(x, y) & mask;
+
+            while (_cells[slot].Stamp == _stamp)
+            {
+                slot = (slot + 1) & mask;
+            }
+        }
+
+        auto& cell = _cells[slot];
+        cell.X = x;
+        cell.Y = y;
+        cell.Stamp = _stamp;
+        cell.Count = 0;
+        cell.Offset = 0;
+
+        _usedCells.push_back(slot);
+
+        return slot;
+    }
+
+    void SpatialHash::grow() noexcept
+    {
+    #ifdef TRACY_ENABLE
+            ZoneScoped;
+    #endif // TRACY_ENABLE
+
+        AllocVector<SpatialHashCell> oldCells{ StandardAllocator<SpatialHashCell> {_heapAllocator} };
+        oldCells.swap(_cells);
+
+        _cells.resize(std::max(oldCells.size() * 2, _preallocatedCellCount));
+
+        const auto mask = _cells.size() - 1;
+
+        for (auto& usedCell : _usedCells)
+        {
+            const auto& oldCell = oldCells[usedCell];
+            auto slot = HashCell(oldCell.X, oldCell.Y) & mask;
+
+            while (_cells[slot].Stamp == _stamp)
+            {
+                slot = (slot + 1) & mask;
+            }
+
+            _cells[slot] = oldCell;
+            usedCell = slot;
+        }
+    }
+
+    void SpatialHash::Update(const AllocVector<SimplifiedCollider>& colliders) noexcept
+    {
+    #ifdef TRACY_ENABLE
+            ZoneScoped;
+            ZoneValue(colliders.size());
+    #endif // TRACY_ENABLE
+
+        _possiblePairs.clear();
+        _usedCells.clear();
+
+        // A new stamp makes all the slots of the previous step unused.
+        _stamp++;
+
+        if (_stamp == 0)
+        {
+            for (auto& cell : _cells)
+            {
+                cell.Stamp = 0;
+            }
+
+            _stamp = 1;
+        }
+
+        // Count the number of colliders in each cell.
+        std::size_t entryCount = 0;
+
+        for (const auto& simplCol : colliders)
+        {
+            const int minX = cellCoordinate(simplCol.Rectangle.MinBound().X);
+            const int minY = cellCoordinate(simplCol.Rectangle.MinBound().Y);
+            const int maxX = cellCoordinate(simplCol.Rectangle.MaxBound().X);
+            const int maxY = cellCoordinate(simplCol.Rectangle.MaxBound().Y);
+
+            for (int y = minY; y <= maxY; y++)
+            {
+                for (int x = minX; x <= maxX; x++)
+                {
+                    _cells[findCell(x, y)].Count++;
+                    entryCount++;
+                }
+            }
+        }
+
+        // Give to each cell its range in the entries.
+        std::size_t offset = 0;
+
+        for (const auto usedCell : _usedCells)
+        {
+            auto& cell = _cells[usedCell];
+            cell.Offset = offset;
+            offset += cell.Count;
+            cell.Count = 0;
+        }
+
+        _entries.resize(entryCount);
+
+        for (std::size_t i = 0; i < colliders.size(); i++)
+        {
+            const auto& rectangle = colliders[i].Rectangle;
+
+            const int minX = cellCoordinate(rectangle.MinBound().X);
+            const int minY = cellCoordinate(rectangle.MinBound().Y);
+            const int maxX = cellCoordinate(rectangle.MaxBound().X);
+            const int maxY = cellCoordinate(rectangle.MaxBound().Y);
+
+            for (int y = minY; y <= maxY; y++)
+            {
+                for (int x = minX; x <= maxX; x++)
+                {
+                    auto& cell = _cells[findCell(x, y)];
+                    _entries[cell.Offset + cell.Count] = i;
+                    cell.Count++;
+                }
+            }
+        }
+
+    #ifdef TRACY_ENABLE
+            ZoneNamedN(CalculatePossiblePairs, "CalculatePossiblePairs", true);
+            ZoneValue(_usedCells.size());
+    #endif // TRACY_ENABLE
+
+        for (const auto usedCell : _usedCells)
+        {
+            const auto& cell = _cells[usedCell];
+
+            for (std::size_t i = 0; i < cell.Count; i++)
+            {
+                const auto& simplColA = colliders[_entries[cell.Offset + i]];
+                const auto minA = simplColA.Rectangle.MinBound();
+
+                for (std::size_t j = i + 1; j < cell.Count; j++)
+                {
+                    const auto& simplColB = colliders[_entries[cell.Offset + j]];
+
+                    if (!Math::Intersect(simplColA.Rectangle, simplColB.Rectangle)) continue;
+
+                    // Only the cell containing the minimum corner of the intersection adds the pair.
+                    const auto minB = simplColB.Rectangle.MinBound();
+
+                    if (cellCoordinate(std::max(minA.X, minB.X)) != cell.X ||
+                        cellCoordinate(std::max(minA.Y, minB.Y)) != cell.Y)
+                    {
+                        continue;
+                    }
+
+                    _possiblePairs.push_back(ColliderPair{ simplColA.ColRef, simplColB.ColRef });
+                }
+            }
+        }
+    }
+
+    void SpatialHash::Clear() noexcept
+    {
+    #ifdef TRACY_ENABLE
+            ZoneScoped;
+    #endif // TRACY_ENABLE
+
+        for (auto& cell : _cells)
+        {
+            cell.Stamp = 0;
+        }
+
+        _stamp = 0;
+
+        _usedCells.clear();
+        _entries.clear();
+        _possiblePairs.clear();
+    }
+
+    void SpatialHash::Deinit() noexcept
+    {
+    #ifdef TRACY_ENABLE
+            ZoneScoped;
+    #endif // TRACY_ENABLE
+
+        _cells.clear();
+        _usedCells.clear();
+        _entries.clear();
+        _possiblePairs.clear();
+
+        _stamp = 0;
+    }
+}
@@ -0,0 +1,211 @@
+#include "SweepAndPrune.h"
+
+#include <algorithm>
+
+#ifdef TRACY_ENABLE
+#include <Tracy.hpp>
+#endif // TRACY_ENABLE
+
+namespace PhysicsEngine
+{
+    /**
+     * @brief IsBefore checks if the endpoint A must be sorted before the endpoint B. At equal values, the minimum
+     * endpoints come first so that the colliders that touch each other overlap.
+     */
+    [[nodiscard]] static bool IsBefore(const SapEndpoint& endpointA, const SapEndpoint& endpointB) noexcept
+    {
+        return endpointA.Value < endpointB.Value ||
+               (endpointA.Value == endpointB.Value && endpointA.IsMin && !endpointB.IsMin);
+    }
+
+    void SweepAndPrune::Init() noexcept
+    {
+    #ifdef TRACY_ENABLE
+            ZoneScoped;
+    #endif // TRACY_ENABLE
+
+        _proxies.reserve(_preallocatedProxyCount);
+        _endpointsX.reserve(2 * _preallocatedProxyCount);
+        _endpointsY.reserve(2 * _preallocatedProxyCount);
+        _activeProxies.reserve(_preallocatedProxyCount);
+    }
+
+    void SweepAndPrune::Update(const AllocVector<SimplifiedCollider>& colliders) noexcept
+    {
+    #ifdef TRACY_ENABLE
+            ZoneScoped;
+            ZoneValue(colliders.size());
+    #endif // TRACY_ENABLE
+
+        for (const auto& simplCol : colliders)
+        {
+            const auto index = simplCol.ColRef.Index;
+
+            if (index >= _proxies.size())
+            {
+                _proxies.resize(index + 1);
+            }
+
+            auto& proxy = _proxies[index];
+
+            // A new proxy adds its endpoints at the end of the axes, the insertion sort moves them at their place.
+            if (!proxy.Enabled)
+            {
+                _endpointsX.push_back({ 0.f, index, true });
+                _endpointsX.push_back({ 0.f, index, false });
+                _endpointsY.push_back({ 0.f, index, true });
+                _endpointsY.push_back({ 0.f, index, false });
+
+                proxy.Enabled = true;
+            }
+
+            proxy.ColRef = simplCol.ColRef;
+            proxy.Rectangle = simplCol.Rectangle;
+            proxy.Updated = true;
+        }
+
+        // The colliders that were not given anymore have been disabled or destroyed.
+        bool hasRemovedProxies = false;
+
+        for (auto& proxy : _proxies)
+        {
+            if (proxy.Enabled && !proxy.Updated)
+            {
+                proxy.Enabled = false;
+                hasRemovedProxies = true;
+            }
+
+            proxy.Updated = false;
+        }
+
+        if (hasRemovedProxies)
+        {
+            const auto isRemoved = [this](const SapEndpoint& endpoint)
+            {
+                return !_proxies[endpoint.ProxyIndex].Enabled;
+            };
+
+            _endpointsX.erase(std::remove_if(_endpointsX.begin(), _endpointsX.end(), isRemoved), _endpointsX.end());
+            _endpointsY.erase(std::remove_if(_endpointsY.begin(), _endpointsY.end(), isRemoved), _endpointsY.end());
+        }
+
+        // Sweep the axis on which the centers of the colliders are the most spread to get the fewest overlaps.
+        Math::Vec2F sum = Math::Vec2F::Zero();
+        Math::Vec2F squareSum = Math::Vec2F::Zero();
+
+        for (const auto& simplCol : colliders)
+        {
+            const auto center = simplCol.Rectangle.Center();
+
+            sum += center;
+            squareSum += Math::Vec2F(center.X * center.X, center.Y * center.Y);
+        }
+
+        const auto count = static_cast<float>(colliders.size());
+        const float varianceX = squareSum.X * count - sum.X * sum.X;
+        const float varianceY = squareSum.Y * count - sum.Y * sum.Y;
+
+        _sweepAxis = varianceX >= varianceY ? 0 : 1;
+
+        // Only the swept axis is sorted, the other one keeps its order of the last step it was swept so it is
+        // still almost sorted if the colliders become more spread on it.
+        auto& endpoints = _sweepAxis == 0 ? _endpointsX : _endpointsY;
+
+        updateEndpoints(endpoints, _sweepAxis);
+        sweep(endpoints);
+    }
+
+    void SweepAndPrune::updateEndpoints(AllocVector<SapEndpoint>& endpoints, const int axis) noexcept
+    {
+    #ifdef TRACY_ENABLE
+            ZoneScoped;
+    #endif // TRACY_ENABLE
+
+        for (auto& endpoint : endpoints)
+        {
+            const auto& rectangle = _proxies[endpoint.ProxyIndex].Rectangle;
+            const auto bound = endpoint.IsMin ? rectangle.MinBound() : rectangle.MaxBound();
+
+            endpoint.Value = axis == 0 ? bound.X : bound.Y;
+        }
+
+        // The endpoints are almost sorted from the previous step, so the insertion sort is close to linear.
+        for (std::size_t i = 1; i < endpoints.size(); i++)
+        {
+            const auto endpoint = endpoints[i];
+            std::size_t j = i;
+
+            while (j > 0 && IsBefore(endpoint, endpoints[j - 1]))
+            {
+                endpoints[j] = endpoints[j - 1];
+                j--;
+            }
+
+            endpoints[j] = endpoint;
+        }
+    }
+
+    void SweepAndPrune::sweep(const AllocVector<SapEndpoint>& endpoints) noexcept
+    {
+    #ifdef TRACY_ENABLE
+            ZoneScoped;
+    #endif // TRACY_ENABLE
+
+        _possiblePairs.clear();
+        _activeProxies.clear();
+
+        for (const auto& endpoint : endpoints)
+        {
+            auto& proxy = _proxies[endpoint.ProxyIndex];
+
+            if (endpoint.IsMin)
+            {
+                // The proxy overlaps all the active proxies on the sweep axis, check the other axis.
+                for (const auto activeIndex : _activeProxies)
+                {
+                    const auto& activeProxy = _proxies[activeIndex];
+
+                    if (Math::Intersect(activeProxy.Rectangle, proxy.Rectangle))
+                    {
+                        _possiblePairs.push_back(ColliderPair{ activeProxy.ColRef, proxy.ColRef });
+                    }
+                }
+
+                proxy.ActiveIndex = _activeProxies.size();
+                _activeProxies.push_back(endpoint.ProxyIndex);
+            }
+            else
+            {
+                // Swap the proxy with the last active one to remove it.
+                const auto lastIndex = _activeProxies.back();
+
+                _activeProxies[proxy.ActiveIndex] = lastIndex;
+                _proxies[lastIndex].ActiveIndex = proxy.ActiveIndex;
+                _activeProxies.pop_back();
+            }
+        }
+    }
+
+    void SweepAndPrune::Clear() noexcept
+    {
+    #ifdef TRACY_ENABLE
+            ZoneScoped;
+    #endif // TRACY_ENABLE
+
+        _proxies.clear();
+        _endpointsX.clear();
+        _endpointsY.clear();
+        _activeProxies.clear();
+        _possiblePairs.clear();
+        _sweepAxis = 0;
+    }
+
+    void SweepAndPrune::Deinit() noexcept
+    {
+    #ifdef TRACY_ENABLE
+            ZoneScoped;
+    #endif // TRACY_ENABLE
+
+        Clear();
+    }
+}
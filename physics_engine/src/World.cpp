@@ -9,7 +9,9 @@
 #include <TracyC.h>
 #endif // TRACY_ENABLE
 
+#include <cmath>
 #include <iostream>
+#include <limits>
 
 namespace PhysicsEngine
 {
@@ -29,7 +31,25 @@ namespace PhysicsEngine
         _colliders.resize(preallocatedBodyCount, Collider());
         _collidersGenIndices.resize(preallocatedBodyCount, 0);
 
-        _quadTree.Init();
+        // The free indices are stacked in reverse order so that the lowest ones are given first.
+        _freeBodyIndices.clear();
+        _freeColliderIndices.clear();
+
+        for (std::size_t i = _bodies.size(); i > 0; i--)
+        {
+            if (!_bodies[i - 1].IsValid()) _freeBodyIndices.push_back(i - 1);
+        }
+
+        for (std::size_t i = _colliders.size(); i > 0; i--)
+        {
+            if (!_colliders[i - 1].Enabled()) _freeColliderIndices.push_back(i - 1);
+        }
+
+        _simdLevel = BestSimdLevel();
+
+        _simplifiedColliders.reserve(preallocatedBodyCount);
+
+        _broadPhase->Init();
     }
 
     void World::Update(const float deltaTime) noexcept
@@ -42,6 +62,8 @@ namespace PhysicsEngine
             ZoneNamedN(CalculateBodiesAcceleration, "CalculateBodiesAcceleration", true);
             ZoneValue(_bodies.size());
     #endif
+        if (_contactListener) beginContinuousMotions();
+
         for (auto& body : _bodies)
         {
             if (!body.IsValid()) continue;
@@ -50,6 +72,9 @@ namespace PhysicsEngine
             {
                 case BodyType::Dynamic:
                 {
+                    // The sleeping bodies are not integrated.
+                    if (!body.IsAwake()) break;
+
                     body.ApplyForce(_gravity);
 
                     // a = F / m
@@ -83,153 +108,502 @@ namespace PhysicsEngine
             }
         }
 
+        updateColliderProxies();
+
         if (_contactListener)
         {
             resolveBroadPhase();
+            resolveContinuousCollisions();
             resolveNarrowPhase();
         }
+
+        buildIslands();
+
+        // The islands don't share any dynamic body, so they are solved in parallel.
+        if (_contactListener)
+        {
+            _contactConstraintSolver.Solve(_bodies, deltaTime, _islandGraph, _jobSystem, _simdLevel);
+            finishContinuousMotions(deltaTime);
+
+            // The bodies only fall asleep when their contacts have been solved.
+            if (_isSleepingEnabled) updateSleep(deltaTime);
+        }
     }
 
-    void World::resolveBroadPhase() noexcept
+    int World::Step(const float frameTime) noexcept
     {
     #ifdef TRACY_ENABLE
             ZoneScoped;
     #endif
 
+        _accumulator += frameTime;
+
+        if (_accumulator < _fixedDeltaTime) return 0;
+
+        _frameForces.resize(_bodies.size());
+
+        for (std::size_t i = 0; i < _bodies.size(); i++)
+        {
+            _frameForces[i] = _bodies[i].Forces();
+        }
+
+        int subStepCount = 0;
+
+        while (_accumulator >= _fixedDeltaTime && subStepCount < _maxSubStepCount)
+        {
+            _previousPositions.resize(_bodies.size());
+
+            for (std::size_t i = 0; i < _bodies.size(); i++)
+            {
+                _previousPositions[i] = PreviousPosition{ _bodies[i].Position(), _bodiesGenIndices[i] };
+
+                // The integration resets the forces, so the ones of the frame are applied to each fixed step.
+                if (subStepCount > 0 && i < _frameForces.size() && _frameForces[i] != Math::Vec2F::Zero())
+                {
+                    _bodies[i].ApplyForce(_frameForces[i]);
+                }
+            }
+
+            Update(_fixedDeltaTime);
+
+            _accumulator -= _fixedDeltaTime;
+            subStepCount++;
+        }
+
+        // The time that could not be simulated is dropped, except the part of a fixed step left to interpolate.
+        if (_accumulator >= _fixedDeltaTime) _accumulator = std::fmod(_accumulator, _fixedDeltaTime);
+
+        return subStepCount;
+    }
+
+    Math::Vec2F World::InterpolatedPosition(const BodyRef bodyRef) const
+    {
+        if (_bodiesGenIndices[bodyRef.Index] != bodyRef.GenerationIdx)
+        {
+            throw std::runtime_error("Null body reference exception");
+        }
+
+        const auto position = _bodies[bodyRef.Index].Position();
+
+        if (bodyRef.Index >= _previousPositions.size()) return position;
+
+        const auto& previous = _previousPositions[bodyRef.Index];
+
+        if (previous.GenerationIdx != bodyRef.GenerationIdx) return position;
+
+        return previous.Position + (position - previous.Position) * InterpolationFactor();
+    }
+
+    void World::SetBroadPhaseType(const BroadPhaseType broadPhaseType) noexcept
+    {
+        if (_broadPhaseType == broadPhaseType) return;
+
+        _broadPhase->Deinit();
+
+        switch (broadPhaseType)
+        {
+            case BroadPhaseType::QuadTree:
+                _broadPhase = &_quadTree;
+                break;
+            case BroadPhaseType::AabbTree:
+                _broadPhase = &_aabbTree;
+                break;
+            case BroadPhaseType::SweepAndPrune:
+                _broadPhase = &_sweepAndPrune;
+                break;
+            case BroadPhaseType::SpatialHash:
+                _broadPhase = &_spatialHash;
+                break;
+            case BroadPhaseType::LinearQuadTree:
+                _broadPhase = &_linearQuadTree;
+                break;
+        }
+
+        _broadPhaseType = broadPhaseType;
+        _broadPhase->Init();
+    }
+
+    void World::resolveBroadPhase() noexcept
+    {
     #ifdef TRACY_ENABLE
-            ZoneNamedN(SetRoodNodeBoundary, "SetRootNodeBoundary", true);
+            ZoneScoped;
             ZoneValue(_colliders.size());
     #endif
 
-        _quadTree.Clear();
+        _simplifiedColliders.clear();
+        _movingAabbs.clear();
+        _sleepingColliders.clear();
+        _restingPairs.clear();
 
-        // Sets the minimum and maximum collision zone limits of the world rectangle to floating maximum and
-        // lowest values.
-        Math::Vec2F worldMinBound(std::numeric_limits<float>::max(), std::numeric_limits<float>::max());
-        Math::Vec2F worldMaxBound(std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest());
+        for (auto& motion : _continuousMotions)
+        {
+            motion.Translation = _bodies[motion.BodyIndex].Position() - motion.StartPosition;
+        }
 
-        // Adjust the size of the collision zone in the world rectangle to the most distant bodies.
-        for (const auto& collider : _colliders)
+        const bool isRebuilt = isBroadPhaseRebuilt();
+
+        for (auto& proxy : _colliderProxies)
         {
-            if (!collider.Enabled()) continue;
+            proxy.IsOutOfBroadPhase = false;
+
+            if (!proxy.Enabled) continue;
 
-            const auto colCenter = GetBody(collider.GetBodyRef()).Position();
+            const auto& body = _bodies[proxy.BodyIndex];
 
-            if (worldMinBound.X > colCenter.X)
+            // A broad phase kept between the steps doesn't move the sleeping colliders, the other ones would
+            // insert them again each step.
+            if (isRebuilt && body.GetBodyType() == BodyType::Dynamic && !body.IsAwake())
             {
-                worldMinBound.X = colCenter.X;
+                _sleepingColliders.push_back(proxy.ColRef.Index);
+                continue;
             }
 
-            if (worldMaxBound.X < colCenter.X)
+            const auto* motion = _continuousMotions.empty() ? nullptr : findContinuousMotion(proxy.BodyIndex);
+            auto aabb = proxy.Aabb;
+
+            if (motion != nullptr)
             {
-                worldMaxBound.X = colCenter.X;
+                // The broad phase gets the bounds of the whole move, the proxy keeps the bounds at the end of it.
+                const auto startAabb = proxy.Aabb + -motion->Translation;
+                aabb = Math::RectangleF(
+                    Math::Vec2F(std::min(startAabb.MinBound().X, proxy.Aabb.MinBound().X),
+                                std::min(startAabb.MinBound().Y, proxy.Aabb.MinBound().Y)),
+                    Math::Vec2F(std::max(startAabb.MaxBound().X, proxy.Aabb.MaxBound().X),
+                                std::max(startAabb.MaxBound().Y, proxy.Aabb.MaxBound().Y)));
             }
 
-            if (worldMinBound.Y > colCenter.Y)
+            _simplifiedColliders.push_back({ proxy.ColRef, aabb });
+
+            if (isRebuilt && body.GetBodyType() != BodyType::Static) _movingAabbs.push_back(aabb);
+        }
+
+        if (!_sleepingColliders.empty()) addTouchedSleepingColliders();
+
+        _broadPhase->Update(_simplifiedColliders);
+    }
+
+    bool World::isBroadPhaseRebuilt() const noexcept
+    {
+        switch (_broadPhaseType)
+        {
+            case BroadPhaseType::QuadTree:
+                return !_quadTree.IsPersistent();
+            case BroadPhaseType::SpatialHash:
+            case BroadPhaseType::LinearQuadTree:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    void World::addTouchedSleepingColliders() noexcept
+    {
+    #ifdef TRACY_ENABLE
+            ZoneScoped;
+            ZoneValue(_sleepingColliders.size());
+    #endif
+
+        std::sort(_movingAabbs.begin(), _movingAabbs.end(),
+                  [](const Math::RectangleF& aabbA, const Math::RectangleF& aabbB)
+                  {
+                      return aabbA.MinBound().X < aabbB.MinBound().X;
+                  });
+
+        float maxMovingWidth = 0.f;
+
+        for (const auto& aabb : _movingAabbs)
+        {
+            maxMovingWidth = std::max(maxMovingWidth, aabb.MaxBound().X - aabb.MinBound().X);
+        }
+
+        for (const auto colIdx : _sleepingColliders)
+        {
+            auto& proxy = _colliderProxies[colIdx];
+            const auto minX = proxy.Aabb.MinBound().X, maxX = proxy.Aabb.MaxBound().X;
+
+            // The moving bounds that overlap the sleeping ones on x start between their min x minus the widest
+            // moving bounds and their max x.
+            auto it = std::lower_bound(_movingAabbs.begin(), _movingAabbs.end(), minX - maxMovingWidth,
+                                       [](const Math::RectangleF& aabb, const float x)
+                                       {
+                                           return aabb.MinBound().X < x;
+                                       });
+
+            bool isTouched = false;
+
+            for (; it != _movingAabbs.end() && it->MinBound().X <= maxX; ++it)
             {
-                worldMinBound.Y = colCenter.Y;
+                if (Math::Intersect(*it, proxy.Aabb))
+                {
+                    isTouched = true;
+                    break;
+                }
             }
 
-            if (worldMaxBound.Y < colCenter.Y)
+            if (isTouched)
             {
-                worldMaxBound.Y = colCenter.Y;
+                _simplifiedColliders.push_back({ proxy.ColRef, proxy.Aabb });
+            }
+            else
+            {
+                proxy.IsOutOfBroadPhase = true;
             }
         }
 
-        // Set the first rectangle of the quad-tree to calculated collision area rectangle.
-        _quadTree.SetRootNodeBoundary(Math::RectangleF(worldMinBound, worldMaxBound));
+        // The pairs of the colliders left out can't have moved, they keep their state of the previous step.
+        const auto isValid = [this](const ColliderRef colRef)
+        {
+            const auto& proxy = _colliderProxies[colRef.Index];
+
+            return proxy.Enabled && proxy.ColRef == colRef;
+        };
 
+        for (const auto& pair : _colliderPairs)
+        {
+            if (!isValid(pair.ColliderA) || !isValid(pair.ColliderB)) continue;
+
+            if (!_colliderProxies[pair.ColliderA.Index].IsOutOfBroadPhase &&
+                !_colliderProxies[pair.ColliderB.Index].IsOutOfBroadPhase)
+            {
+                continue;
+            }
+
+            if (isPairAsleep(pair)) _restingPairs.push_back(pair);
+        }
+    }
+
+    void World::beginContinuousMotions() noexcept
+    {
+        _continuousMotions.clear();
+
+        for (std::size_t i = 0; i < _bodies.size(); i++)
+        {
+            const auto& body = _bodies[i];
+
+            if (!body.IsValid() || !body.IsContinuous() || !body.IsAwake()) continue;
+            if (body.GetBodyType() != BodyType::Dynamic) continue;
+
+            _continuousMotions.push_back(ContinuousMotion{ i, body.Position() });
+        }
+    }
+
+    ContinuousMotion* World::findContinuousMotion(const std::size_t bodyIdx) noexcept
+    {
+        const auto it = std::lower_bound(_continuousMotions.begin(), _continuousMotions.end(), bodyIdx,
+                                         [](const ContinuousMotion& motion, const std::size_t idx)
+                                         {
+                                             return motion.BodyIndex < idx;
+                                         });
+
+        if (it == _continuousMotions.end() || it->BodyIndex != bodyIdx) return nullptr;
+
+        return &*it;
+    }
+
+    void World::resolveContinuousCollisions() noexcept
+    {
     #ifdef TRACY_ENABLE
-            ZoneNamedN(InsertCollidersInQuadTree, "InsertCollidersInQuadTree", true);
+            ZoneScoped;
+            ZoneValue(_continuousMotions.size());
+    #endif
+
+        if (_continuousMotions.empty()) return;
+
+        for (const auto& pair : _broadPhase->PossiblePairs())
+        {
+            auto colIdxMoving = pair.ColliderA.Index, colIdxStatic = pair.ColliderB.Index;
+
+            if (_bodies[_colliderProxies[colIdxStatic].BodyIndex].GetBodyType() != BodyType::Static)
+            {
+                std::swap(colIdxMoving, colIdxStatic);
+            }
+
+            const auto& movingProxy = _colliderProxies[colIdxMoving];
+            const auto& staticProxy = _colliderProxies[colIdxStatic];
+
+            if (_bodies[staticProxy.BodyIndex].GetBodyType() != BodyType::Static) continue;
+            if (_colliders[colIdxMoving].IsTrigger() || _colliders[colIdxStatic].IsTrigger()) continue;
+
+            auto* motion = findContinuousMotion(movingProxy.BodyIndex);
+
+            if (motion == nullptr || motion->Translation == Math::Vec2F::Zero()) continue;
+
+            // The moving shape is cast from where it was before the integration.
+            auto startShape = shapeInstanceOf(colIdxMoving);
+            startShape.Position = startShape.Position - motion->Translation;
+            startShape.VerticesOffset = startShape.VerticesOffset - motion->Translation;
+
+            const auto hit = CalculateTimeOfImpact(movingProxy.Type, startShape, motion->Translation,
+                                                   staticProxy.Type, shapeInstanceOf(colIdxStatic));
+
+            // The shapes that already touch at the start are handled by the contact solver.
+            if (!hit.Hit || hit.Time <= 0.f) continue;
+
+            motion->Time = std::min(motion->Time, hit.Time);
+        }
+
+        bool isAnyBodyMovedBack = false;
+
+        for (auto& motion : _continuousMotions)
+        {
+            if (motion.Time >= 1.f) continue;
+
+            // The body is moved slightly past the time of impact so that the narrow phase finds the contact.
+            const auto distance = motion.Translation.Length();
+            motion.Time = std::min(1.f, motion.Time + ContactConstraintSolver::LinearSlop / distance);
+
+            auto& body = _bodies[motion.BodyIndex];
+            body.SetPosition(motion.StartPosition + motion.Translation * motion.Time);
+            motion.VelocityBeforeSolve = body.Velocity();
+
+            isAnyBodyMovedBack = true;
+        }
+
+        if (!isAnyBodyMovedBack) return;
+
+        // Only the proxies of the bodies moved back have changed, they are translated instead of recalculated.
+        for (auto& proxy : _colliderProxies)
+        {
+            if (!proxy.Enabled) continue;
+
+            const auto delta = _bodies[proxy.BodyIndex].Position() - proxy.BodyPosition;
+
+            if (delta == Math::Vec2F::Zero()) continue;
+
+            proxy.BodyPosition = proxy.BodyPosition + delta;
+            proxy.Aabb = proxy.Aabb + delta;
+
+            for (int i = 0; i < proxy.Vertices.Count; i++)
+            {
+                auto& vertex = _polygonVertices[proxy.Vertices.Offset + i];
+                vertex = vertex + delta;
+            }
+        }
+    }
+
+    void World::finishContinuousMotions(const float deltaTime) noexcept
+    {
+    #ifdef TRACY_ENABLE
+            ZoneScoped;
+            ZoneValue(_continuousMotions.size());
+    #endif
+
+        for (const auto& motion : _continuousMotions)
+        {
+            if (motion.Time >= 1.f) continue;
+
+            auto& body = _bodies[motion.BodyIndex];
+            const auto velocity = body.Velocity();
+
+            // The solver already moved the body by the change of its velocity over the whole step, which is
+            // replaced by its new velocity over the rest of the step.
+            const auto remainingMove = velocity * ((1.f - motion.Time) * deltaTime)
+                                       - (velocity - motion.VelocityBeforeSolve) * deltaTime;
+
+            body.SetPosition(body.Position() + remainingMove);
+        }
+    }
+
+    void World::updateColliderProxies() noexcept
+    {
+    #ifdef TRACY_ENABLE
+            ZoneScoped;
             ZoneValue(_colliders.size());
     #endif
 
+        _polygonVertices.clear();
+        _colliderProxies.resize(_colliders.size());
+
         for (std::size_t i = 0; i < _colliders.size(); i++)
         {
-            ColliderRef colliderRef = {i, _collidersGenIndices[i]};
-            const auto& collider = GetCollider(colliderRef);
+            auto& collider = _colliders[i];
+            auto& proxy = _colliderProxies[i];
+
+            proxy.Enabled = collider.Enabled();
 
-            if (!collider.Enabled()) continue;
+            if (!proxy.Enabled) continue;
 
-            const auto colShape = collider.Shape();
+            // The body is only checked here, the other steps use its index.
+            const auto bodyRef = collider.GetBodyRef();
+            auto& body = GetBody(bodyRef);
 
-            switch (static_cast<Math::ShapeType>(colShape.index()))
+            // A sleeping body whose shape changed may touch new colliders.
+            if (collider.IsShapeChanged())
             {
-                case Math::ShapeType::Circle:
-                {
-                #ifdef TRACY_ENABLE
-                       ZoneNamedN(InsertCircle, "InsertCircle", true);
-                #endif
-                    const auto circle = std::get<Math::CircleF>(colShape);
-                    const auto radius = circle.Radius();
-                    const auto simplifiedCircle = Math::RectangleF::FromCenter(
-                            GetBody(collider.GetBodyRef()).Position(),
-                            Math::Vec2F(radius, radius));
-
-                    _quadTree.Insert(simplifiedCircle, colliderRef);
-                    break;
-                } // Case circle.
+                body.SetAwake(true);
+                collider.SetShapeChanged(false);
+            }
 
-                case Math::ShapeType::Rectangle:
-                {
-                #ifdef TRACY_ENABLE
-                       ZoneNamedN(InsertRectangle, "InsertRectangle", true);
-                #endif
+            proxy.ColRef = ColliderRef{i, _collidersGenIndices[i]};
+            proxy.BodyIndex = bodyRef.Index;
+            proxy.BodyPosition = body.Position();
+            proxy.Type = static_cast<Math::ShapeType>(collider.Shape().index());
+            proxy.Aabb = calculateSimplifiedShape(collider, proxy.BodyPosition, proxy.Vertices);
+        }
+    }
 
-                    const auto rect = std::get<Math::RectangleF>(colShape) +
-                            GetBody(collider.GetBodyRef()).Position();
+    Math::RectangleF World::calculateSimplifiedShape(const Collider& collider,
+                                                     const Math::Vec2F position,
+                                                     VertexSpan& vertices) noexcept
+    {
+    #ifdef TRACY_ENABLE
+            ZoneScoped;
+    #endif
 
-                    _quadTree.Insert(rect, colliderRef);
-                    break;
-                } // Case rectangle.
+        const auto& colShape = collider.Shape();
 
-                case Math::ShapeType::Polygon:
-                {
-                #ifdef TRACY_ENABLE
-                    ZoneNamedN(InsertPolygon, "InsertPolygon", true);
-                #endif
+        switch (static_cast<Math::ShapeType>(colShape.index()))
+        {
+            case Math::ShapeType::Circle:
+            {
+            #ifdef TRACY_ENABLE
+                   ZoneNamedN(SimplifyCircle, "SimplifyCircle", true);
+            #endif
+                const auto circle = std::get<Math::CircleF>(colShape);
+                const auto radius = circle.Radius();
+                const auto simplifiedCircle = Math::RectangleF::FromCenter(
+                        position + circle.Center(),
+                        Math::Vec2F(radius, radius));
+
+                return simplifiedCircle;
+            } // Case circle.
 
-                    Math::Vec2F minVertex(std::numeric_limits<float>::max(), 
-                                          std::numeric_limits<float>::max());
+            case Math::ShapeType::Rectangle:
+            {
+            #ifdef TRACY_ENABLE
+                   ZoneNamedN(SimplifyRectangle, "SimplifyRectangle", true);
+            #endif
 
-                    Math::Vec2F maxVertex(std::numeric_limits<float>::lowest(),
-                                          std::numeric_limits<float>::lowest());
+                const auto rect = std::get<Math::RectangleF>(colShape) + position;
 
-                    const auto poly = std::get<Math::PolygonF>(colShape) +
-                            GetBody(collider.GetBodyRef()).Position();
+                return rect;
+            } // Case rectangle.
 
-                    for (const auto& vertex : poly.Vertices())
-                    {
-                        if (minVertex.X > vertex.X)
-                        {
-                            minVertex.X = vertex.X;
-                        }
+            case Math::ShapeType::Polygon:
+            {
+            #ifdef TRACY_ENABLE
+                ZoneNamedN(SimplifyPolygon, "SimplifyPolygon", true);
+            #endif
 
-                        if (maxVertex.X < vertex.X)
-                        {
-                            maxVertex.X = vertex.X;
-                        }
+                const auto& polygon = std::get<Math::PolygonF>(colShape);
+                const auto& localVertices = polygon.Vertices();
 
-                        if (minVertex.Y > vertex.Y)
-                        {
-                            minVertex.Y = vertex.Y;
-                        }
+                // The world-space vertices are stored in the vertex pool for the narrow phase.
+                vertices.Offset = _polygonVertices.size();
+                vertices.Count = static_cast<int>(localVertices.size());
 
-                        if (maxVertex.Y < vertex.Y)
-                        {
-                            maxVertex.Y = vertex.Y;
-                        }
-                    } // For range vertex.
+                for (const auto& localVertex : localVertices)
+                {
+                    _polygonVertices.push_back(localVertex + position);
+                }
 
-                    Math::RectangleF simplifiedPoly(minVertex, maxVertex);
+                const auto simplifiedPoly = polygon.Bounds() + position;
 
-                    _quadTree.Insert(simplifiedPoly, colliderRef);
-                    break;
-                } // Case polygon.
-            } // Switch collider shape index.
-        } // For int i < colliders.size().
+                return simplifiedPoly;
+            } // Case polygon.
+        } // Switch collider shape index.
 
-        _quadTree.CalculatePossiblePairs();
+        return Math::RectangleF(Math::Vec2F::Zero(), Math::Vec2F::Zero());
     }
 
     void World::resolveNarrowPhase() noexcept
@@ -238,83 +612,182 @@ namespace PhysicsEngine
                 ZoneScoped;
         #endif
 
-        const auto& possiblePairs = _quadTree.PossiblePairs();
+        const auto& possiblePairs = _broadPhase->PossiblePairs();
 
         #ifdef TRACY_ENABLE
                 ZoneValue(possiblePairs.size());
         #endif
 
-        AllocVector<ColliderPair> newPairs{ StandardAllocator<ColliderPair>{_heapAllocator} };
-        newPairs.reserve(possiblePairs.size());
+        auto& newPairs = _newColliderPairs;
+        newPairs.clear();
+        newPairs.reserve(possiblePairs.size() + _restingPairs.size());
+
+        auto& newSimplexCaches = _newSimplexCaches;
+        newSimplexCaches.clear();
+        newSimplexCaches.reserve(possiblePairs.size());
+
+        const auto chunkCount = (possiblePairs.size() + _narrowPhaseChunkSize - 1) / _narrowPhaseChunkSize;
 
-        for (const auto& possiblePair : possiblePairs)
+        const bool isBatched = _narrowPhaseMode == NarrowPhaseMode::Batched;
+
+        if (_jobSystem == nullptr || _jobSystem->WorkerCount() == 0 || chunkCount < 2)
         {
-            auto& colliderA = GetCollider(possiblePair.ColliderA);
-            auto& colliderB = GetCollider(possiblePair.ColliderB);
+            if (isBatched)
+            {
+                if (_narrowPhaseBatches.empty()) _narrowPhaseBatches.emplace_back(_heapAllocator);
 
-            if (detectOverlap(colliderA, colliderB))
+                _narrowPhaseBatches[0].Reserve(possiblePairs.size());
+                detectOverlapsBatched(possiblePairs, 0, possiblePairs.size(), _narrowPhaseBatches[0], newPairs,
+                                      newSimplexCaches);
+            }
+            else
             {
-                newPairs.push_back(possiblePair);
+                detectOverlaps(possiblePairs, 0, possiblePairs.size(), newPairs, newSimplexCaches);
             }
         }
-
-        for (const auto& newPair : newPairs)
+        else
         {
-            Collider& colliderA = GetCollider(newPair.ColliderA);
-            Collider& colliderB = GetCollider(newPair.ColliderB);
+            // The chunk outputs are allocated here so that the jobs never allocate.
+            while (_chunkPairs.size() < chunkCount)
+            {
+                _chunkPairs.emplace_back(StandardAllocator<ColliderPair>{_heapAllocator});
+            }
 
-            const auto it = std::find(_colliderPairs.begin(), _colliderPairs.end(), newPair);
+            while (_chunkSimplexCaches.size() < chunkCount)
+            {
+                _chunkSimplexCaches.emplace_back(StandardAllocator<PairSimplexCache>{_heapAllocator});
+            }
 
-            // If there was no collision in the previous frame -> OnTriggerEnter.
-            if (it == _colliderPairs.end())
+            for (std::size_t i = 0; i < chunkCount; i++)
             {
-                if (colliderA.IsTrigger() || colliderB.IsTrigger())
+                _chunkPairs[i].clear();
+                _chunkPairs[i].reserve(_narrowPhaseChunkSize);
+                _chunkSimplexCaches[i].clear();
+                _chunkSimplexCaches[i].reserve(_narrowPhaseChunkSize);
+            }
+
+            if (isBatched)
+            {
+                while (_narrowPhaseBatches.size() < chunkCount)
                 {
-                    _contactListener->OnTriggerEnter(newPair.ColliderA, newPair.ColliderB);
+                    _narrowPhaseBatches.emplace_back(_heapAllocator);
                 }
 
-                else
+                for (std::size_t i = 0; i < chunkCount; i++)
                 {
-                    ContactSolver contactSolver;
-                    contactSolver.InitContactActors(GetBody(colliderA.GetBodyRef()),
-                                                    GetBody(colliderB.GetBodyRef()),
-                                                    colliderA,
-                                                    colliderB);
-
-                    contactSolver.ResolveContact();
-                    _contactListener->OnCollisionEnter(newPair.ColliderA, newPair.ColliderB);
+                    _narrowPhaseBatches[i].Reserve(_narrowPhaseChunkSize);
                 }
             }
-            // If there was a collision in the previous frame and there is always a collision -> OnTriggerStay.
-            else
+
+            _jobSystem->ParallelFor(chunkCount, [this, &possiblePairs, isBatched](const std::size_t chunkIdx)
             {
-                if (colliderA.IsTrigger() || colliderB.IsTrigger())
+                const auto begin = chunkIdx * _narrowPhaseChunkSize;
+                const auto end = std::min(begin + _narrowPhaseChunkSize, possiblePairs.size());
+
+                if (isBatched)
                 {
-                    _contactListener->OnTriggerStay(newPair.ColliderA, newPair.ColliderB);
+                    detectOverlapsBatched(possiblePairs, begin, end, _narrowPhaseBatches[chunkIdx],
+                                          _chunkPairs[chunkIdx], _chunkSimplexCaches[chunkIdx]);
                 }
                 else
                 {
-                    ContactSolver contactSolver;
-                    contactSolver.InitContactActors(GetBody(colliderA.GetBodyRef()),
-                                                    GetBody(colliderB.GetBodyRef()),
-                                                    colliderA,
-                                                    colliderB);
+                    detectOverlaps(possiblePairs, begin, end, _chunkPairs[chunkIdx], _chunkSimplexCaches[chunkIdx]);
+                }
+            });
+
+            for (std::size_t i = 0; i < chunkCount; i++)
+            {
+                newPairs.insert(newPairs.end(), _chunkPairs[i].begin(), _chunkPairs[i].end());
+                newSimplexCaches.insert(newSimplexCaches.end(), _chunkSimplexCaches[i].begin(),
+                                        _chunkSimplexCaches[i].end());
+            }
+        }
+
+        newPairs.insert(newPairs.end(), _restingPairs.begin(), _restingPairs.end());
+
+        // The simplex caches are sorted by key to be found with a binary search in the next step.
+        std::sort(newSimplexCaches.begin(), newSimplexCaches.end(),
+                  [](const PairSimplexCache& cacheA, const PairSimplexCache& cacheB)
+                  {
+                      return cacheA.Key < cacheB.Key;
+                  });
+
+        _simplexCaches.swap(newSimplexCaches);
+
+        // Both lists are sorted by key so that the new and previous pairs are matched with a linear merge.
+        const auto isKeyLower = [](const ColliderPair& pairA, const ColliderPair& pairB)
+        {
+            return pairA.Key() < pairB.Key();
+        };
+
+        std::sort(newPairs.begin(), newPairs.end(), isKeyLower);
 
-                    contactSolver.ResolveContact();
+        std::size_t previousPairIdx = 0;
+
+        _contactConstraintSolver.BeginStep(newPairs.size());
+
+        for (const auto& newPair : newPairs)
+        {
+            const Collider& colliderA = _colliders[newPair.ColliderA.Index];
+            const Collider& colliderB = _colliders[newPair.ColliderB.Index];
+
+            while (previousPairIdx < _colliderPairs.size() && isKeyLower(_colliderPairs[previousPairIdx], newPair))
+            {
+                previousPairIdx++;
+            }
+
+            // The keys only contain the indices, the pair must also have the same generations to be the same.
+            const bool wasColliding = previousPairIdx < _colliderPairs.size() &&
+                                      _colliderPairs[previousPairIdx] == newPair;
+
+            const bool isTrigger = colliderA.IsTrigger() || colliderB.IsTrigger();
+
+            // The contacts are added in the key order of the new pairs and solved together after the narrow phase.
+            // A sleeping body touched by an awake one is woken up.
+            if (!isTrigger && !isPairAsleep(newPair))
+            {
+                _bodies[_colliderProxies[newPair.ColliderA.Index].BodyIndex].SetAwake(true);
+                _bodies[_colliderProxies[newPair.ColliderB.Index].BodyIndex].SetAwake(true);
+
+                addContact(newPair);
+            }
+
+            // If there was no collision in the previous frame -> OnTriggerEnter.
+            if (!wasColliding)
+            {
+                if (isTrigger)
+                {
+                    _contactListener->OnTriggerEnter(newPair.ColliderA, newPair.ColliderB);
                 }
+                else
+                {
+                    _contactListener->OnCollisionEnter(newPair.ColliderA, newPair.ColliderB);
+                }
+            }
+            // If there was a collision in the previous frame and there is always a collision -> OnTriggerStay.
+            else if (isTrigger)
+            {
+                _contactListener->OnTriggerStay(newPair.ColliderA, newPair.ColliderB);
             }
         }
 
+        std::size_t newPairIdx = 0;
+
         for (auto& colliderPair : _colliderPairs)
         {
-            Collider& colliderA = GetCollider(colliderPair.ColliderA);
-            Collider& colliderB = GetCollider(colliderPair.ColliderB);
+            while (newPairIdx < newPairs.size() && isKeyLower(newPairs[newPairIdx], colliderPair))
+            {
+                newPairIdx++;
+            }
 
-            const auto it = std::find(newPairs.begin(), newPairs.end(), colliderPair);
+            const bool isColliding = newPairIdx < newPairs.size() && newPairs[newPairIdx] == colliderPair;
 
             // If there is no collision in this frame -> OnTriggerExit.
-            if (it == newPairs.end())
+            if (!isColliding)
             {
+                Collider& colliderA = GetCollider(colliderPair.ColliderA);
+                Collider& colliderB = GetCollider(colliderPair.ColliderB);
+
                 if (colliderA.IsTrigger() || colliderB.IsTrigger())
                 {
                     _contactListener->OnTriggerExit(colliderPair.ColliderA,
@@ -322,216 +795,271 @@ namespace PhysicsEngine
                 }
                 else
                 {
-                    ContactSolver contactSolver;
-                    contactSolver.InitContactActors(GetBody(colliderA.GetBodyRef()),
-                                                    GetBody(colliderB.GetBodyRef()),
-                                                    colliderA,
-                                                    colliderB);
+                    // A sleeping body that lost a contact may have lost its support.
+                    _bodies[_colliderProxies[colliderPair.ColliderA.Index].BodyIndex].SetAwake(true);
+                    _bodies[_colliderProxies[colliderPair.ColliderB.Index].BodyIndex].SetAwake(true);
 
-                    contactSolver.ResolveContact();
                     _contactListener->OnCollisionExit(colliderPair.ColliderA,
                                                       colliderPair.ColliderB);
                 }
             }
         }
 
-        _colliderPairs = newPairs;
+        _colliderPairs.swap(newPairs);
     }
 
-    bool World::detectOverlap(const Collider& colA, const Collider& colB) noexcept
+    void World::buildIslands() noexcept
     {
     #ifdef TRACY_ENABLE
             ZoneScoped;
     #endif
-        auto& bodyA = GetBody(colA.GetBodyRef());
-        auto& bodyB = GetBody(colB.GetBodyRef());
 
-        const auto colShapeA = colA.Shape();
-        const auto colShapeB = colB.Shape();
+        _islandGraph.Reset(_bodies.size());
+
+        for (const auto& pair : _colliderPairs)
+        {
+            if (_colliders[pair.ColliderA.Index].IsTrigger() || _colliders[pair.ColliderB.Index].IsTrigger()) continue;
+
+            const auto bodyIdxA = _colliderProxies[pair.ColliderA.Index].BodyIndex;
+            const auto bodyIdxB = _colliderProxies[pair.ColliderB.Index].BodyIndex;
+
+            // The bodies that are not dynamic don't carry the contacts, so they don't link the islands.
+            if (_bodies[bodyIdxA].GetBodyType() != BodyType::Dynamic ||
+                _bodies[bodyIdxB].GetBodyType() != BodyType::Dynamic)
+            {
+                continue;
+            }
+
+            _islandGraph.Link(bodyIdxA, bodyIdxB);
+        }
 
-        bool doCollidersIntersect = false;
+        _islandGraph.Build(_bodies);
+    }
 
-        switch (static_cast<Math::ShapeType>(colShapeA.index()))
+    void World::updateSleep(const float deltaTime) noexcept
+    {
+    #ifdef TRACY_ENABLE
+            ZoneScoped;
+    #endif
+
+        for (const auto& island : _islandGraph.Islands())
         {
-            case Math::ShapeType::Circle:
+            bool hasAwakeBody = false, hasSleepingBody = false;
+            float minSleepTime = std::numeric_limits<float>::max();
+
+            for (std::size_t i = 0; i < island.BodyCount; i++)
             {
-                const auto circleA = std::get<Math::CircleF>(colShapeA) + bodyA.Position();
+                auto& body = _bodies[_islandGraph.IslandBody(island, i)];
 
-                switch (static_cast<Math::ShapeType>(colShapeB.index()))
+                if (!body.IsAwake())
                 {
-                    case Math::ShapeType::Circle:
-                    {
-                    #ifdef TRACY_ENABLE
-                        std::string txt = "Circle-Circle";
-                        ZoneText(txt.c_str(), txt.size());
-                    #endif
-
-                        const auto circleB = std::get<Math::CircleF>(colShapeB) + bodyB.Position();
-
-                        doCollidersIntersect = Math::Intersect(circleA, circleB);
-
-                        break;
-                    } // Case circle B.
-                    
-                    case Math::ShapeType::Rectangle:
-                    {
-                    #ifdef TRACY_ENABLE
-                            std::string txt = "Circle-Rectangle";
-                            ZoneText(txt.c_str(), txt.size());
-                    #endif
-                        const auto rectB = std::get<Math::RectangleF>(colShapeB) +
-                                bodyB.Position();
-
-                        doCollidersIntersect = Math::Intersect(circleA, rectB);
-
-                        break;
-                    } // Case rectangle B.
-
-                    case Math::ShapeType::Polygon:
-                    {
-                    #ifdef TRACY_ENABLE
-                        std::string txt = "Circle-Polygon";
-                        ZoneText(txt.c_str(), txt.size());
-                    #endif
-                        const auto polygonB = std::get<Math::PolygonF>(colShapeB) +
-                                bodyB.Position();
-
-                        doCollidersIntersect = Math::Intersect(circleA, polygonB);
-                        break;
-                    } // Case polygon B.
-
-                    case Math::ShapeType::None:
-                        break;
-                    default:
-                        break;
-                } // Switch shape collider B.
+                    hasSleepingBody = true;
+                    continue;
+                }
 
-                break;
-            } // Case circle A.
+                hasAwakeBody = true;
 
-            case Math::ShapeType::Rectangle:
+                const bool isSlow = body.Velocity().SquareLength() <= SleepVelocity * SleepVelocity;
+                body.SetSleepTime(isSlow ? body.SleepTime() + deltaTime : 0.f);
+
+                minSleepTime = std::min(minSleepTime, body.SleepTime());
+            }
+
+            // The bodies of an island sleep and wake together.
+            const bool wakeUp = hasAwakeBody && hasSleepingBody;
+            const bool fallAsleep = hasAwakeBody && !hasSleepingBody && minSleepTime >= TimeToSleep;
+
+            if (!wakeUp && !fallAsleep) continue;
+
+            for (std::size_t i = 0; i < island.BodyCount; i++)
             {
-                const auto rectA = std::get<Math::RectangleF>(colShapeA) + bodyA.Position();
+                _bodies[_islandGraph.IslandBody(island, i)].SetAwake(wakeUp);
+            }
+        }
+    }
 
-                switch (static_cast<Math::ShapeType>(colShapeB.index()))
-                {
-                    case Math::ShapeType::Circle:
-                    {
-                    #ifdef TRACY_ENABLE
-                            std::string txt = "Rectangle-Cricle";
-                            ZoneText(txt.c_str(), txt.size());
-                    #endif
+    bool World::isPairAsleep(const ColliderPair& pair) const noexcept
+    {
+        const auto& bodyA = _bodies[_colliderProxies[pair.ColliderA.Index].BodyIndex];
+        const auto& bodyB = _bodies[_colliderProxies[pair.ColliderB.Index].BodyIndex];
 
-                        const auto circleB = std::get<Math::CircleF>(colShapeB) +
-                                             bodyB.Position();
+        const auto isSleeping = [](const Body& body)
+        {
+            return body.GetBodyType() == BodyType::Dynamic && !body.IsAwake();
+        };
 
-                        doCollidersIntersect = Math::Intersect(rectA, circleB);
+        const auto isResting = [&isSleeping](const Body& body)
+        {
+            return body.GetBodyType() == BodyType::Static || isSleeping(body);
+        };
 
-                        break;
-                    } // Case circle B.
+        return (isSleeping(bodyA) || isSleeping(bodyB)) && isResting(bodyA) && isResting(bodyB);
+    }
 
-                    case Math::ShapeType::Rectangle:
-                    {
-                    #ifdef TRACY_ENABLE
-                            std::string txt = "Rectangle-Rectangle";
-                            ZoneText(txt.c_str(), txt.size());
-                    #endif
+    bool World::wasColliding(const ColliderPair& pair) const noexcept
+    {
+        const auto it = std::lower_bound(_colliderPairs.begin(), _colliderPairs.end(), pair.Key(),
+                                         [](const ColliderPair& colliderPair, const std::uint64_t key)
+                                         {
+                                             return colliderPair.Key() < key;
+                                         });
+
+        // The keys only contain the indices, the pair must also have the same generations to be the same.
+        return it != _colliderPairs.end() && *it == pair;
+    }
+
+    void World::SetSleepingEnabled(const bool isSleepingEnabled) noexcept
+    {
+        _isSleepingEnabled = isSleepingEnabled;
+
+        if (isSleepingEnabled) return;
 
-                        const auto rectB = std::get<Math::RectangleF>(colShapeB) +
-                                bodyB.Position();
+        for (auto& body : _bodies)
+        {
+            body.SetAwake(true);
+        }
+    }
 
-                        doCollidersIntersect = Math::Intersect(rectA, rectB);
+    void World::addContact(const ColliderPair& pair) noexcept
+    {
+        const auto colIdxA = pair.ColliderA.Index, colIdxB = pair.ColliderB.Index;
+        const auto& proxyA = _colliderProxies[colIdxA];
+        const auto& proxyB = _colliderProxies[colIdxB];
 
-                        break;
-                    } // Case rectangle B.
+        // Two colliders of the same body can't push it.
+        if (proxyA.BodyIndex == proxyB.BodyIndex) return;
 
-                    case Math::ShapeType::Polygon:
-                    {
-                    #ifdef TRACY_ENABLE
-                            std::string txt = "Rectangle-Polygon";
-                            ZoneText(txt.c_str(), txt.size());
-                    #endif
+        const auto manifold = CalculateManifold(proxyA.Type, shapeInstanceOf(colIdxA),
+                                                proxyB.Type, shapeInstanceOf(colIdxB));
 
-                        const auto polygonB = std::get<Math::PolygonF>(colShapeB) +
-                                              bodyB.Position();
+        const auto restitution = ContactConstraintSolver::CombinedRestitution(_bodies[proxyA.BodyIndex],
+                                                                              _bodies[proxyB.BodyIndex],
+                                                                              _colliders[colIdxA],
+                                                                              _colliders[colIdxB]);
 
-                        doCollidersIntersect = Math::Intersect(rectA, polygonB);
-                        break;
-                    } // Case polygon B.
+        _contactConstraintSolver.AddContact(pair, proxyA.BodyIndex, proxyB.BodyIndex, restitution, manifold);
+    }
 
-                    case Math::ShapeType::None:
-                        break;
-                    default:
-                        break;
-                } // Switch shape collider B.
+    void World::detectOverlaps(const AllocVector<ColliderPair>& possiblePairs,
+                               const std::size_t begin,
+                               const std::size_t end,
+                               AllocVector<ColliderPair>& overlappingPairs,
+                               AllocVector<PairSimplexCache>& simplexCaches) noexcept
+    {
+    #ifdef TRACY_ENABLE
+            ZoneScoped;
+            ZoneValue(end - begin);
+    #endif
 
-                break;
-            } // Case rectangle A.
+        for (std::size_t i = begin; i < end; i++)
+        {
+            const auto& possiblePair = possiblePairs[i];
 
-            case Math::ShapeType::Polygon:
+            // The pairs that can't have moved keep their state of the previous step.
+            if (isPairAsleep(possiblePair))
+            {
+                if (wasColliding(possiblePair)) overlappingPairs.push_back(possiblePair);
+
+                continue;
+            }
+
+            if (detectOverlap(possiblePair, simplexCaches))
             {
-                const auto polygonA = std::get<Math::PolygonF>(colShapeA) +
-                                      bodyA.Position();
+                overlappingPairs.push_back(possiblePair);
+            }
+        }
+    }
+
+    void World::detectOverlapsBatched(const AllocVector<ColliderPair>& possiblePairs,
+                                      const std::size_t begin,
+                                      const std::size_t end,
+                                      NarrowPhaseBatch& batch,
+                                      AllocVector<ColliderPair>& overlappingPairs,
+                                      AllocVector<PairSimplexCache>& simplexCaches) noexcept
+    {
+    #ifdef TRACY_ENABLE
+            ZoneScoped;
+            ZoneValue(end - begin);
+    #endif
+
+        batch.Clear();
+
+        for (std::size_t i = begin; i < end; i++)
+        {
+            const auto& possiblePair = possiblePairs[i];
+            const auto colIdxA = possiblePair.ColliderA.Index, colIdxB = possiblePair.ColliderB.Index;
+            const auto typeA = _colliderProxies[colIdxA].Type, typeB = _colliderProxies[colIdxB].Type;
+
+            // The pairs that can't have moved keep their state of the previous step.
+            if (isPairAsleep(possiblePair))
+            {
+                if (wasColliding(possiblePair)) overlappingPairs.push_back(possiblePair);
+
+                continue;
+            }
+
+            if (typeA == Math::ShapeType::Circle && typeB == Math::ShapeType::Circle)
+            {
+                const auto shapeA = shapeInstanceOf(colIdxA), shapeB = shapeInstanceOf(colIdxB);
+
+                batch.AddCircles(possiblePair,
+                                 ToWorldShape<Math::CircleF>(shapeA),
+                                 ToWorldShape<Math::CircleF>(shapeB));
+            }
+            else if (typeA == Math::ShapeType::Rectangle && typeB == Math::ShapeType::Rectangle)
+            {
+                // The simplified shape of a rectangle is the rectangle itself.
+                batch.AddRectangles(possiblePair, _colliderProxies[colIdxA].Aabb, _colliderProxies[colIdxB].Aabb);
+            }
+            else if (typeA != Math::ShapeType::None && typeB != Math::ShapeType::None)
+            {
+                batch.AddPair(typeA, typeB, possiblePair);
+            }
+        }
 
-                switch (static_cast<Math::ShapeType>(colShapeB.index()))
+        batch.Run(_simdLevel, overlappingPairs);
+
+        // The other pairs are tested bucket by bucket, so each bucket always calls the same kernel.
+        for (std::size_t bucketIdx = 0; bucketIdx < OverlapTable.size(); bucketIdx++)
+        {
+            for (const auto& pair : batch.PairBucket(bucketIdx))
+            {
+                if (detectOverlap(pair, simplexCaches))
                 {
-                    case Math::ShapeType::Circle:
-                    {
-                    #ifdef TRACY_ENABLE
-                            std::string txt = "Polygon-Circle";
-                            ZoneText(txt.c_str(), txt.size());
-                    #endif
-
-                        const auto circleB = std::get<Math::CircleF>(colShapeB) + bodyB.Position();
-
-                        doCollidersIntersect = Math::Intersect(polygonA, circleB);
-                        break;
-                    } // Case circle B.
-
-                    case Math::ShapeType::Rectangle:
-                    {
-                    #ifdef TRACY_ENABLE
-                            std::string txt = "Polygon-Rectangle";
-                            ZoneText(txt.c_str(), txt.size());
-                    #endif
-
-                        const auto rectB = std::get<Math::RectangleF>(colShapeB) +
-                                           bodyB.Position();
-
-                        doCollidersIntersect = Math::Intersect(polygonA, rectB);
-                        break;
-                    } // Case rectangle B.
-
-                    case Math::ShapeType::Polygon:
-                    {
-                    #ifdef TRACY_ENABLE
-                            std::string txt = "Polygon-Polygon";
-                            ZoneText(txt.c_str(), txt.size());
-                    #endif
-
-                        const auto polygonB = std::get<Math::PolygonF>(colShapeB) +
-                                              bodyB.Position();
-
-                        doCollidersIntersect = Math::Intersect(polygonA, polygonB);
-                        break;
-                    } // Case polygon B.
-
-                    case Math::ShapeType::None:
-                        break;
-                    default:
-                        break;
-                } // Switch shape collider B.
+                    overlappingPairs.push_back(pair);
+                }
+            }
+        }
+    }
 
-                break;
-            } // Case Polygon A.
+    bool World::detectOverlap(const ColliderPair& pair, AllocVector<PairSimplexCache>& simplexCaches) const noexcept
+    {
+        // The possible pairs come from the proxies of this step, so the references are valid.
+        const auto colIdxA = pair.ColliderA.Index, colIdxB = pair.ColliderB.Index;
+        const auto typeA = _colliderProxies[colIdxA].Type, typeB = _colliderProxies[colIdxB].Type;
 
-            case Math::ShapeType::None:
-                break;
-            default:
-                break;
-        } // Switch shape collider A.
+        if (typeA != Math::ShapeType::Polygon && typeB != Math::ShapeType::Polygon)
+        {
+            return DetectOverlap(typeA, shapeInstanceOf(colIdxA), typeB, shapeInstanceOf(colIdxB));
+        }
 
-        return doCollidersIntersect;
+        // The simplex caches of the previous step are only read, so this can run on several threads.
+        PairSimplexCache pairCache{ pair.Key(), SimplexCache{} };
+
+        const auto it = std::lower_bound(_simplexCaches.begin(), _simplexCaches.end(), pairCache.Key,
+                                         [](const PairSimplexCache& cache, const std::uint64_t key)
+                                         {
+                                             return cache.Key < key;
+                                         });
+
+        if (it != _simplexCaches.end() && it->Key == pairCache.Key) pairCache.Cache = it->Cache;
+
+        const bool overlap = DetectOverlap(typeA, shapeInstanceOf(colIdxA), typeB, shapeInstanceOf(colIdxB),
+                                           &pairCache.Cache);
+
+        if (pairCache.Cache.Count > 0) simplexCaches.push_back(pairCache);
+
+        return overlap;
     }
 
     void World::Deinit() noexcept
@@ -542,49 +1070,103 @@ namespace PhysicsEngine
 
         _bodies.clear();
         _bodiesGenIndices.clear();
+        _continuousMotions.clear();
+        _previousPositions.clear();
+        _frameForces.clear();
+        _accumulator = 0.f;
+
+        _freeBodyIndices.clear();
 
         _colliders.clear();
         _collidersGenIndices.clear();
+        _freeColliderIndices.clear();
         _colliderPairs.clear();
+        _newColliderPairs.clear();
+        _chunkPairs.clear();
+        _narrowPhaseBatches.clear();
+        _simplexCaches.clear();
+        _newSimplexCaches.clear();
+        _chunkSimplexCaches.clear();
+        _contactConstraintSolver.Clear();
+        _islandGraph.Clear();
 
         _contactListener = nullptr;
+        _jobSystem = nullptr;
+        _quadTree.SetJobSystem(nullptr);
+        _linearQuadTree.SetJobSystem(nullptr);
+
+        _simplifiedColliders.clear();
+        _movingAabbs.clear();
+        _sleepingColliders.clear();
+        _restingPairs.clear();
+        _polygonVertices.clear();
+        _colliderProxies.clear();
+
+        _broadPhase->Deinit();
+    }
+
+    void World::reserveFreeBodies(const std::size_t count) noexcept
+    {
+        if (_freeBodyIndices.size() >= count) return;
+
+        const std::size_t previousSize = _bodies.size();
+        const auto missingCount = count - _freeBodyIndices.size();
+        const auto newSize = std::max(static_cast<std::size_t>(static_cast<float>(previousSize) * _bodyAllocResizeFactor),
+                                      previousSize + missingCount);
+
+        _bodies.resize(newSize, Body());
+        _bodiesGenIndices.resize(newSize, 0);
 
-        _quadTree.Deinit();
+        // The new indices go under the current free ones, so that the destroyed bodies are reused first.
+        _freeBodyIndices.insert(_freeBodyIndices.begin(), newSize - previousSize, 0);
+
+        for (std::size_t i = 0; i < newSize - previousSize; i++)
+        {
+            _freeBodyIndices[i] = newSize - 1 - i;
+        }
     }
 
     [[nodiscard]] BodyRef World::CreateBody() noexcept
     {
-        auto it = std::find_if(_bodies.begin(), _bodies.end(),[](const Body& body)
-        {
-            return !body.IsValid();
-        });
+        reserveFreeBodies(1);
 
-        if (it != _bodies.end())
-        {
-            // Found an invalid body.
-            std::size_t index = std::distance(_bodies.begin(), it);
+        const auto index = _freeBodyIndices.back();
+        _freeBodyIndices.pop_back();
 
-            _bodies[index].SetMass(1.f);
+        _bodies[index].SetMass(1.f);
 
-            return BodyRef{index, _bodiesGenIndices[index]};
-        }
+        return BodyRef{index, _bodiesGenIndices[index]};
+    }
 
-        // No body with negative mass found.
-        std::size_t previousSize = _bodies.size();
-        auto newSize = static_cast<std::size_t>(static_cast<float>(previousSize) * _bodyAllocResizeFactor);
+    void World::CreateBodies(const std::size_t count, AllocVector<BodyRef>& bodyRefs) noexcept
+    {
+    #ifdef TRACY_ENABLE
+            ZoneScoped;
+            ZoneValue(count);
+    #endif
 
-        _bodies.resize(newSize, Body());
-        _bodiesGenIndices.resize(newSize, 0);
+        reserveFreeBodies(count);
+        bodyRefs.reserve(bodyRefs.size() + count);
 
-        _bodies[previousSize].SetMass(1.f);
+        for (std::size_t i = 0; i < count; i++)
+        {
+            const auto index = _freeBodyIndices.back();
+            _freeBodyIndices.pop_back();
+
+            _bodies[index].SetMass(1.f);
 
-        return {previousSize, _bodiesGenIndices[previousSize] };
+            bodyRefs.push_back(BodyRef{index, _bodiesGenIndices[index]});
+        }
     }
 
     void World::DestroyBody(BodyRef bodyRef) noexcept
     {
+        // A body already destroyed must not be given twice by the free list.
+        if (_bodiesGenIndices[bodyRef.Index] != bodyRef.GenerationIdx) return;
+
         _bodies[bodyRef.Index] = Body();
         _bodiesGenIndices[bodyRef.Index]++;
+        _freeBodyIndices.push_back(bodyRef.Index);
     }
 
     Body& World::GetBody(BodyRef bodyRef)
@@ -607,34 +1189,46 @@ namespace PhysicsEngine
         return _colliders[colliderRef.Index];
     }
 
-    ColliderRef World::CreateCollider(BodyRef bodyRef) noexcept
+    const ColliderProxy& World::GetColliderProxy(ColliderRef colliderRef) const
     {
-        std::size_t colliderIdx = -1;
-
-        auto it = std::find_if(
-                _colliders.begin(),
-                _colliders.end(),
-                [](const Collider& collider)
+        // The proxy doesn't exist until the first update after the creation of the collider.
+        if (colliderRef.Index >= _colliderProxies.size() || !_colliderProxies[colliderRef.Index].Enabled ||
+            !(_colliderProxies[colliderRef.Index].ColRef == colliderRef) ||
+            _collidersGenIndices[colliderRef.Index] != colliderRef.GenerationIdx)
         {
-            return !collider.Enabled();
-        });
+            throw std::runtime_error("Null collider proxy reference exception");
+        }
+
+        return _colliderProxies[colliderRef.Index];
+    }
+
+    void World::reserveFreeColliders(const std::size_t count) noexcept
+    {
+        if (_freeColliderIndices.size() >= count) return;
+
+        const std::size_t previousSize = _colliders.size();
+        const auto missingCount = count - _freeColliderIndices.size();
+        const auto newSize = std::max(static_cast<std::size_t>(static_cast<float>(previousSize) * _bodyAllocResizeFactor),
+                                      previousSize + missingCount);
 
-        if (it != _colliders.end())
+        _colliders.resize(newSize, Collider());
+        _collidersGenIndices.resize(newSize, 0);
+
+        // The new indices go under the current free ones, so that the destroyed colliders are reused first.
+        _freeColliderIndices.insert(_freeColliderIndices.begin(), newSize - previousSize, 0);
+
+        for (std::size_t i = 0; i < newSize - previousSize; i++)
         {
-            // Found an invalid collider.
-            colliderIdx = std::distance(_colliders.begin(), it);
+            _freeColliderIndices[i] = newSize - 1 - i;
         }
-        else
-        {
-            // No collider with none shape found.
-            std::size_t previousSize = _colliders.size();
-            auto newSize = static_cast<std::size_t>(static_cast<float>(previousSize) * _bodyAllocResizeFactor);
+    }
 
-            _colliders.resize(newSize, Collider());
-            _collidersGenIndices.resize(newSize, 0);
+    ColliderRef World::CreateCollider(BodyRef bodyRef) noexcept
+    {
+        reserveFreeColliders(1);
 
-            colliderIdx = previousSize;
-        }
+        const auto colliderIdx = _freeColliderIndices.back();
+        _freeColliderIndices.pop_back();
 
         auto& collider = _colliders[colliderIdx];
 
@@ -646,9 +1240,46 @@ namespace PhysicsEngine
         return colRef;
     }
 
+    void World::CreateColliders(const AllocVector<BodyRef>& bodyRefs, AllocVector<ColliderRef>& colliderRefs) noexcept
+    {
+    #ifdef TRACY_ENABLE
+            ZoneScoped;
+            ZoneValue(bodyRefs.size());
+    #endif
+
+        reserveFreeColliders(bodyRefs.size());
+        colliderRefs.reserve(colliderRefs.size() + bodyRefs.size());
+
+        for (const auto& bodyRef : bodyRefs)
+        {
+            const auto colliderIdx = _freeColliderIndices.back();
+            _freeColliderIndices.pop_back();
+
+            auto& collider = _colliders[colliderIdx];
+
+            collider.SetEnabled(true);
+            collider.SetBodyRef(bodyRef);
+
+            colliderRefs.push_back(ColliderRef{colliderIdx, _collidersGenIndices[colliderIdx]});
+        }
+    }
+
     void World::DestroyCollider(ColliderRef colRef) noexcept
     {
+        // A collider already destroyed must not be given twice by the free list.
+        if (_collidersGenIndices[colRef.Index] != colRef.GenerationIdx) return;
+
+        // The bodies that were touching the collider may have lost their support.
+        for (const auto& pair : _colliderPairs)
+        {
+            if (!(pair.ColliderA == colRef) && !(pair.ColliderB == colRef)) continue;
+
+            _bodies[_colliderProxies[pair.ColliderA.Index].BodyIndex].SetAwake(true);
+            _bodies[_colliderProxies[pair.ColliderB.Index].BodyIndex].SetAwake(true);
+        }
+
         _colliders[colRef.Index] = Collider();
         _collidersGenIndices[colRef.Index]++;
+        _freeColliderIndices.push_back(colRef.Index);
     }
-}
\ No newline at end of file
+}
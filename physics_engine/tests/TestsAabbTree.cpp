@@ -0,0 +1,232 @@
+#include "AabbTree.h"
+
+#include "gtest/gtest.h"
+#include "Random.h"
+
+#include <algorithm>
+#include <vector>
+
+using namespace PhysicsEngine;
+using namespace Math;
+
+static HeapAllocator TestHeapAllocator;
+
+struct AabbTreeColliderNumberFixture : public ::testing::TestWithParam<int> {};
+
+INSTANTIATE_TEST_SUITE_P(AabbTree, AabbTreeColliderNumberFixture, testing::Values(0, 1, 2, 10, 100, 321, 2000));
+
+TEST(AabbTree, DefaultConstructor)
+{
+    AabbTree aabbTree;
+
+    EXPECT_EQ(aabbTree.Root(), AabbNode::Null);
+    EXPECT_EQ(aabbTree.Height(), 0);
+    EXPECT_EQ(aabbTree.PossiblePairs().size(), 0);
+}
+
+/**
+ * @brief CheckNode checks the links, heights and rectangles of the node and its children and gives
+ * the number of leaves under the node.
+ */
+int CheckNode(const AabbTree& aabbTree, const int nodeIndex)
+{
+    const auto& nodes = aabbTree.Nodes();
+    const auto& node = nodes[nodeIndex];
+
+    if (node.IsLeaf())
+    {
+        EXPECT_EQ(node.Height, 0);
+        return 1;
+    }
+
+    const auto& child1 = nodes[node.Child1];
+    const auto& child2 = nodes[node.Child2];
+
+    EXPECT_EQ(child1.Parent, nodeIndex);
+    EXPECT_EQ(child2.Parent, nodeIndex);
+    EXPECT_EQ(node.Height, 1 + std::max(child1.Height, child2.Height));
+    EXPECT_TRUE(node.Aabb.Contains(child1.Aabb));
+    EXPECT_TRUE(node.Aabb.Contains(child2.Aabb));
+
+    return CheckNode(aabbTree, node.Child1) + CheckNode(aabbTree, node.Child2);
+}
+
+std::vector<ColliderPair> SortedPairs(const AllocVector<ColliderPair>& pairs)
+{
+    std::vector<ColliderPair> sortedPairs;
+
+    // Order the colliders inside each pair and the pairs themselves to compare the lists.
+    for (const auto& pair : pairs)
+    {
+        if (pair.ColliderB.Index < pair.ColliderA.Index)
+        {
+            sortedPairs.push_back(ColliderPair{ pair.ColliderB, pair.ColliderA });
+        }
+        else
+        {
+            sortedPairs.push_back(pair);
+        }
+    }
+
+    std::sort(sortedPairs.begin(), sortedPairs.end());
+
+    return sortedPairs;
+}
+
+TEST_P(AabbTreeColliderNumberFixture, Update)
+{
+    AabbTree aabbTree;
+    aabbTree.Init();
+
+    // Without margin, the fat rectangles are the simplified shapes, so the possible pairs must be the exact
+    // pairs of intersecting rectangles.
+    aabbTree.SetFatMargin(0.f);
+
+    const std::size_t colNbr = GetParam();
+
+    std::vector<RectangleF> rectangles;
+    std::vector<bool> enabled(colNbr, true);
+
+    for (std::size_t i = 0; i < colNbr; i++)
+    {
+        Vec2F rndPos(Random::Range(-10.f, 10.f), Random::Range(-5.f, 5.f));
+        Vec2F rndHalfSize(Random::Range(0.05f, 0.5f), Random::Range(0.05f, 0.5f));
+        rectangles.push_back(RectangleF::FromCenter(rndPos, rndHalfSize));
+    }
+
+    AllocVector<SimplifiedCollider> simplifiedColliders{ StandardAllocator<SimplifiedCollider>{TestHeapAllocator} };
+
+    for (int step = 0; step < 5; step++)
+    {
+        simplifiedColliders.clear();
+
+        for (std::size_t i = 0; i < colNbr; i++)
+        {
+            // Only a part of the colliders move each step.
+            if (step > 0 && i % 3 == static_cast<std::size_t>(step % 3))
+            {
+                rectangles[i] = rectangles[i] + Vec2F(Random::Range(-1.f, 1.f), Random::Range(-1.f, 1.f));
+            }
+
+            // Some colliders are removed and added back.
+            if (step > 0 && i % 7 == static_cast<std::size_t>(step))
+            {
+                enabled[i] = !enabled[i];
+            }
+
+            if (enabled[i])
+            {
+                simplifiedColliders.push_back({ ColliderRef{i, 0}, rectangles[i] });
+            }
+        }
+
+        aabbTree.Update(simplifiedColliders);
+
+        if (aabbTree.Root() != AabbNode::Null)
+        {
+            EXPECT_EQ(aabbTree.Nodes()[aabbTree.Root()].Parent, AabbNode::Null);
+            EXPECT_EQ(CheckNode(aabbTree, aabbTree.Root()), simplifiedColliders.size());
+        }
+        else
+        {
+            EXPECT_EQ(simplifiedColliders.size(), 0);
+        }
+
+        std::vector<ColliderPair> expectedPairs;
+
+        for (std::size_t i = 0; i < simplifiedColliders.size(); i++)
+        {
+            for (std::size_t j = i + 1; j < simplifiedColliders.size(); j++)
+            {
+                if (Intersect(simplifiedColliders[i].Rectangle, simplifiedColliders[j].Rectangle))
+                {
+                    expectedPairs.push_back(ColliderPair{ simplifiedColliders[i].ColRef,
+                                                          simplifiedColliders[j].ColRef });
+                }
+            }
+        }
+
+        std::sort(expectedPairs.begin(), expectedPairs.end());
+        const auto possiblePairs = SortedPairs(aabbTree.PossiblePairs());
+
+        ASSERT_EQ(possiblePairs.size(), expectedPairs.size());
+
+        for (std::size_t i = 0; i < expectedPairs.size(); i++)
+        {
+            EXPECT_EQ(possiblePairs[i].ColliderA, expectedPairs[i].ColliderA);
+            EXPECT_EQ(possiblePairs[i].ColliderB, expectedPairs[i].ColliderB);
+        }
+    }
+}
+
+TEST(AabbTree, BalancedWithSortedInsertion)
+{
+    AabbTree aabbTree;
+    aabbTree.Init();
+
+    AllocVector<SimplifiedCollider> simplifiedColliders{ StandardAllocator<SimplifiedCollider>{TestHeapAllocator} };
+
+    // Colliders inserted along a line degrade an unbalanced tree into a list.
+    constexpr std::size_t colNbr = 1024;
+
+    for (std::size_t i = 0; i < colNbr; i++)
+    {
+        const auto position = Vec2F(static_cast<float>(i), 0.f);
+        simplifiedColliders.push_back({ ColliderRef{i, 0}, RectangleF::FromCenter(position, Vec2F(0.25f, 0.25f)) });
+    }
+
+    aabbTree.Update(simplifiedColliders);
+
+    EXPECT_EQ(CheckNode(aabbTree, aabbTree.Root()), colNbr);
+    EXPECT_LE(aabbTree.Height(), 20);
+    EXPECT_EQ(aabbTree.PossiblePairs().size(), 0);
+}
+
+TEST(AabbTree, UpdateInsideFatRectangle)
+{
+    AabbTree aabbTree;
+    aabbTree.Init();
+    aabbTree.SetFatMargin(0.5f);
+
+    const ColliderRef colRefA{0, 0};
+    const ColliderRef colRefB{1, 0};
+
+    AllocVector<SimplifiedCollider> simplifiedColliders{ StandardAllocator<SimplifiedCollider>{TestHeapAllocator} };
+    simplifiedColliders.push_back({ colRefA, RectangleF(Vec2F(0.f, 0.f), Vec2F(1.f, 1.f)) });
+    simplifiedColliders.push_back({ colRefB, RectangleF(Vec2F(5.f, 5.f), Vec2F(6.f, 6.f)) });
+
+    aabbTree.Update(simplifiedColliders);
+
+    EXPECT_EQ(aabbTree.PossiblePairs().size(), 0);
+
+    // The collider B moves but stays inside its fat rectangle, so its leaf doesn't change.
+    const auto leafB = aabbTree.Nodes()[aabbTree.Root()].Child2;
+    const auto fatRectangleB = aabbTree.Nodes()[leafB].Aabb;
+
+    simplifiedColliders[1].Rectangle = RectangleF(Vec2F(4.6f, 4.6f), Vec2F(5.6f, 5.6f));
+    aabbTree.Update(simplifiedColliders);
+
+    EXPECT_EQ(aabbTree.Nodes()[leafB].Aabb.MinBound(), fatRectangleB.MinBound());
+    EXPECT_EQ(aabbTree.Nodes()[leafB].Aabb.MaxBound(), fatRectangleB.MaxBound());
+    EXPECT_EQ(aabbTree.PossiblePairs().size(), 0);
+
+    // The collider B leaves its fat rectangle and its new fat rectangle touches the one of A.
+    simplifiedColliders[1].Rectangle = RectangleF(Vec2F(1.8f, 1.8f), Vec2F(2.8f, 2.8f));
+    aabbTree.Update(simplifiedColliders);
+
+    ASSERT_EQ(aabbTree.PossiblePairs().size(), 1);
+    EXPECT_EQ(aabbTree.PossiblePairs()[0], (ColliderPair{colRefA, colRefB}));
+
+    // The collider A is destroyed and its index is reused by another collider.
+    simplifiedColliders.erase(simplifiedColliders.begin());
+    aabbTree.Update(simplifiedColliders);
+
+    EXPECT_EQ(aabbTree.PossiblePairs().size(), 0);
+
+    const ColliderRef newColRefA{0, 1};
+    simplifiedColliders.push_back({ newColRefA, RectangleF(Vec2F(2.f, 2.f), Vec2F(3.f, 3.f)) });
+    aabbTree.Update(simplifiedColliders);
+
+    ASSERT_EQ(aabbTree.PossiblePairs().size(), 1);
+    EXPECT_EQ(aabbTree.PossiblePairs()[0], (ColliderPair{newColRefA, colRefB}));
+}
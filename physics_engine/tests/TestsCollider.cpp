@@ -204,10 +204,49 @@ TEST_P(ColliderPairFixture, HashOperator)
 
     std::size_t h = colliderHash(colPair);
 
-    const std::size_t hash1 = std::hash<int>{}(static_cast<int>(colPair.ColliderA.Index));
-    const std::size_t hash2 = std::hash<int>{}(static_cast<int>(colPair.ColliderB.Index));
-
-    const auto hashExpected = hash1 + hash2;
+    const std::size_t hashExpected = std::hash<std::uint64_t>{}(colPair.Key());
 
     EXPECT_EQ(h, hashExpected);
-}
\ No newline at end of file
+
+    // The hash doesn't depend on the order of the colliders, as the equality.
+    EXPECT_EQ(colliderHash(ColliderPair{ colPair.ColliderB, colPair.ColliderA }), h);
+}
+TEST_P(PairOfColliderPairFixture, Key)
+{
+    auto [colPair1, colPair2] = GetParam();
+
+    const ColliderPair swappedPair1{ colPair1.ColliderB, colPair1.ColliderA };
+
+    EXPECT_EQ(colPair1.Key(), swappedPair1.Key());
+
+    const bool haveSameIndices =
+            colPair1.ColliderA.Index == colPair2.ColliderA.Index && colPair1.ColliderB.Index == colPair2.ColliderB.Index
+            || colPair1.ColliderA.Index == colPair2.ColliderB.Index && colPair1.ColliderB.Index == colPair2.ColliderA.Index;
+
+    EXPECT_EQ(colPair1.Key() == colPair2.Key(), haveSameIndices);
+}
+
+TEST(ColliderPair, IsCompact)
+{
+    // The pairs are filled each step by the broad phase and the narrow phase, so they are kept small.
+    EXPECT_EQ(sizeof(ColliderPair), 2 * sizeof(std::uint64_t));
+
+    const ColliderRef colRef{ 3, 7 };
+
+    EXPECT_EQ(colRef.Handle(), std::uint64_t{3} << 32 | 7);
+    EXPECT_LT(colRef, (ColliderRef{ 3, 8 }));
+    EXPECT_LT(colRef, (ColliderRef{ 4, 0 }));
+}
+
+TEST(Collider, ShapeIsNotCopied)
+{
+    Collider collider;
+    collider.SetShape(PolygonF({ Vec2F(0.f, 0.f), Vec2F(1.f, 0.f), Vec2F(0.f, 1.f) }));
+
+    const auto& polygon = std::get<PolygonF>(collider.Shape());
+
+    // The shape and the vertices are given by reference, so they are always the ones stored in the collider.
+    EXPECT_EQ(&collider.Shape(), &collider.Shape());
+    EXPECT_EQ(polygon.Vertices().data(), std::get<PolygonF>(collider.Shape()).Vertices().data());
+    EXPECT_EQ(polygon.VerticesCount(), 3);
+}
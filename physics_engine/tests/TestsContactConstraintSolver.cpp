@@ -0,0 +1,289 @@
+#include "ContactConstraintSolver.h"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <vector>
+
+using namespace PhysicsEngine;
+using namespace Math;
+
+static HeapAllocator TestHeapAllocator;
+
+static ContactManifold ManifoldOf(const Vec2F normal, const Vec2F point, const float penetration)
+{
+    return ContactManifold{ normal, {point}, 1, penetration };
+}
+
+TEST(ContactConstraintSolver, ElasticBounce)
+{
+    AllocVector<Body> bodies{ StandardAllocator<Body>{TestHeapAllocator} };
+    bodies.emplace_back(Vec2F::Zero(), Vec2F(2.f, 0.f), 1.f);
+    bodies.emplace_back(Vec2F(0.9f, 0.f), Vec2F(-2.f, 0.f), 1.f);
+
+    ContactConstraintSolver solver{ TestHeapAllocator };
+    solver.BeginStep(1);
+
+    const ColliderPair pair{ ColliderRef{0, 0}, ColliderRef{1, 0} };
+    solver.AddContact(pair, 0, 1, 1.f, ManifoldOf(Vec2F(-1.f, 0.f), Vec2F(0.45f, 0.f), 0.1f));
+    solver.Solve(bodies, 0.1f);
+
+    // The bodies have the same mass, so they exchange their velocities.
+    EXPECT_NEAR(bodies[0].Velocity().X, -2.f, 0.0001f);
+    EXPECT_NEAR(bodies[1].Velocity().X, 2.f, 0.0001f);
+
+    // Both bodies are moved apart by the same distance.
+    EXPECT_LT(bodies[0].Position().X, 0.f);
+    EXPECT_NEAR(bodies[0].Position().X, 0.9f - bodies[1].Position().X, 0.0001f);
+}
+
+TEST(ContactConstraintSolver, RestingContact)
+{
+    AllocVector<Body> bodies{ StandardAllocator<Body>{TestHeapAllocator} };
+    bodies.emplace_back(Vec2F(0.f, 0.95f), Vec2F(0.f, -0.5f), 1.f);
+    bodies.emplace_back(Vec2F::Zero(), Vec2F::Zero(), 1.f);
+    bodies[1].SetBodyType(BodyType::Static);
+
+    ContactConstraintSolver solver{ TestHeapAllocator };
+    solver.BeginStep(1);
+
+    const ColliderPair pair{ ColliderRef{0, 0}, ColliderRef{1, 0} };
+    solver.AddContact(pair, 0, 1, 1.f, ManifoldOf(Vec2F(0.f, 1.f), Vec2F(0.f, 0.5f), 0.05f));
+    solver.Solve(bodies, 0.1f);
+
+    // The approach velocity is under the restitution threshold, so the body stops instead of bouncing and is
+    // moved back where it would be if it had been integrated without velocity.
+    EXPECT_NEAR(bodies[0].Velocity().Y, 0.f, 0.0001f);
+    EXPECT_NEAR(bodies[0].Position().Y, 1.f, 0.0001f);
+
+    EXPECT_EQ(bodies[1].Position(), Vec2F::Zero());
+    EXPECT_EQ(bodies[1].Velocity(), Vec2F::Zero());
+}
+
+TEST(ContactConstraintSolver, WarmStart)
+{
+    AllocVector<Body> bodies{ StandardAllocator<Body>{TestHeapAllocator} };
+    bodies.emplace_back(Vec2F(0.f, 0.95f), Vec2F(0.f, -0.5f), 1.f);
+    bodies.emplace_back(Vec2F::Zero(), Vec2F::Zero(), 1.f);
+    bodies[1].SetBodyType(BodyType::Static);
+
+    ContactConstraintSolver solver{ TestHeapAllocator };
+    solver.BeginStep(1);
+
+    const ColliderPair pair{ ColliderRef{0, 0}, ColliderRef{1, 0} };
+    const auto manifold = ManifoldOf(Vec2F(0.f, 1.f), Vec2F(0.f, 0.5f), 0.05f);
+
+    solver.AddContact(pair, 0, 1, 0.f, manifold);
+    solver.Solve(bodies, 0.1f);
+
+    const auto impulse = solver.Constraints()[0].Points[0].NormalImpulse;
+    EXPECT_NEAR(impulse, 0.5f, 0.0001f);
+
+    // The same pair starts from the impulse of the previous step, given in any order of the colliders.
+    solver.BeginStep(1);
+    solver.AddContact(ColliderPair{ pair.ColliderB, pair.ColliderA }, 1, 0, 0.f,
+                      ManifoldOf(Vec2F(0.f, -1.f), Vec2F(0.f, 0.5f), 0.05f));
+
+    EXPECT_FLOAT_EQ(solver.Constraints()[0].Points[0].NormalImpulse, impulse);
+
+    // A pair whose normal turned or whose collider was replaced starts from scratch.
+    solver.BeginStep(1);
+    solver.AddContact(pair, 0, 1, 0.f, ManifoldOf(Vec2F(1.f, 0.f), Vec2F(0.f, 0.5f), 0.05f));
+
+    EXPECT_FLOAT_EQ(solver.Constraints()[0].Points[0].NormalImpulse, 0.f);
+
+    solver.BeginStep(1);
+    solver.AddContact(pair, 0, 1, 0.f, manifold);
+    bodies[0].SetVelocity(Vec2F(0.f, -0.5f));
+    solver.Solve(bodies, 0.1f);
+    EXPECT_GT(solver.Constraints()[0].Points[0].NormalImpulse, 0.f);
+
+    solver.BeginStep(1);
+    solver.AddContact(ColliderPair{ ColliderRef{0, 1}, ColliderRef{1, 0} }, 0, 1, 0.f, manifold);
+
+    EXPECT_FLOAT_EQ(solver.Constraints()[0].Points[0].NormalImpulse, 0.f);
+
+    solver.Clear();
+
+    EXPECT_TRUE(solver.Constraints().empty());
+}
+
+TEST(ContactConstraintSolver, IslandsGiveSameResults)
+{
+    // A static ground with a stack of three boxes on it and a box alone, the boxes falling into each other.
+    AllocVector<Body> bodies{ StandardAllocator<Body>{TestHeapAllocator} };
+    bodies.emplace_back(Vec2F::Zero(), Vec2F::Zero(), 1.f);
+    bodies[0].SetBodyType(BodyType::Static);
+
+    for (int i = 1; i < 4; i++)
+    {
+        bodies.emplace_back(Vec2F(0.f, static_cast<float>(i) - 0.1f), Vec2F(0.f, -2.f * static_cast<float>(i)), 1.f);
+    }
+
+    bodies.emplace_back(Vec2F(5.f, 0.9f), Vec2F(0.f, -3.f), 2.f);
+
+    const auto addContacts = [](ContactConstraintSolver& solver)
+    {
+        const auto manifold = ManifoldOf(Vec2F(0.f, 1.f), Vec2F::Zero(), 0.1f);
+
+        solver.BeginStep(4);
+        solver.AddContact(ColliderPair{ ColliderRef{1, 0}, ColliderRef{0, 0} }, 1, 0, 0.5f, manifold);
+        solver.AddContact(ColliderPair{ ColliderRef{4, 0}, ColliderRef{0, 0} }, 4, 0, 0.5f, manifold);
+        solver.AddContact(ColliderPair{ ColliderRef{2, 0}, ColliderRef{1, 0} }, 2, 1, 0.5f, manifold);
+        solver.AddContact(ColliderPair{ ColliderRef{3, 0}, ColliderRef{2, 0} }, 3, 2, 0.5f, manifold);
+    };
+
+    IslandGraph islandGraph{ TestHeapAllocator };
+    islandGraph.Reset(bodies.size());
+    islandGraph.Link(1, 2);
+    islandGraph.Link(2, 3);
+    islandGraph.Build(bodies);
+
+    auto islandBodies = bodies;
+    ContactConstraintSolver islandSolver{ TestHeapAllocator };
+    addContacts(islandSolver);
+    islandSolver.Solve(islandBodies, 0.1f, islandGraph, nullptr);
+
+    // The largest island first, the two small islands are batched in the same task.
+    ASSERT_EQ(islandSolver.SolverIslands().size(), 2);
+    EXPECT_EQ(islandSolver.SolverIslands()[0].ConstraintCount, 3);
+    EXPECT_EQ(islandSolver.SolverIslands()[1].ConstraintCount, 1);
+    ASSERT_EQ(islandSolver.SolverTasks().size(), 1);
+    EXPECT_EQ(islandSolver.SolverTasks()[0].IslandCount, 2);
+
+    auto allBodies = bodies;
+    ContactConstraintSolver allSolver{ TestHeapAllocator };
+    addContacts(allSolver);
+    allSolver.Solve(allBodies, 0.1f);
+
+    for (std::size_t i = 0; i < bodies.size(); i++)
+    {
+        EXPECT_EQ(islandBodies[i].Position(), allBodies[i].Position());
+        EXPECT_EQ(islandBodies[i].Velocity(), allBodies[i].Velocity());
+    }
+
+    EXPECT_EQ(islandBodies[0].Position(), Vec2F::Zero());
+}
+
+TEST(ContactConstraintSolver, GraphColoring)
+{
+    // A pyramid of boxes on a static ground, each box resting on the two boxes under it.
+    constexpr int baseCount = 12;
+
+    AllocVector<Body> bodies{ StandardAllocator<Body>{TestHeapAllocator} };
+    bodies.emplace_back(Vec2F::Zero(), Vec2F::Zero(), 1.f);
+    bodies[0].SetBodyType(BodyType::Static);
+
+    AllocVector<std::array<std::size_t, 2>> contacts{ StandardAllocator<std::array<std::size_t, 2>>{TestHeapAllocator} };
+
+    std::size_t rowBegin = 0;
+
+    for (int row = 0; row < baseCount; row++)
+    {
+        const auto rowCount = static_cast<std::size_t>(baseCount - row);
+        const auto newRowBegin = bodies.size();
+
+        for (std::size_t i = 0; i < rowCount; i++)
+        {
+            bodies.emplace_back(Vec2F(static_cast<float>(i) + 0.5f * static_cast<float>(row), static_cast<float>(row)),
+                                Vec2F(0.f, -1.f - 0.1f * static_cast<float>(i)), 1.f + static_cast<float>(i % 3));
+
+            if (row == 0)
+            {
+                contacts.push_back({ bodies.size() - 1, 0 });
+            }
+            else
+            {
+                contacts.push_back({ bodies.size() - 1, rowBegin + i });
+                contacts.push_back({ bodies.size() - 1, rowBegin + i + 1 });
+            }
+        }
+
+        rowBegin = newRowBegin;
+    }
+
+    // The contacts are added in the key order of their pairs.
+    std::sort(contacts.begin(), contacts.end(), [](const auto& contactA, const auto& contactB)
+    {
+        return std::minmax(contactA[0], contactA[1]) < std::minmax(contactB[0], contactB[1]);
+    });
+
+    IslandGraph islandGraph{ TestHeapAllocator };
+    islandGraph.Reset(bodies.size());
+
+    for (const auto& contact : contacts)
+    {
+        if (contact[1] != 0) islandGraph.Link(contact[0], contact[1]);
+    }
+
+    islandGraph.Build(bodies);
+
+    const auto addContacts = [&contacts](ContactConstraintSolver& solver)
+    {
+        solver.BeginStep(contacts.size());
+
+        for (const auto& contact : contacts)
+        {
+            const ColliderPair pair{ ColliderRef{contact[0], 0}, ColliderRef{contact[1], 0} };
+            const ContactManifold manifold{ Vec2F(0.f, 1.f), {Vec2F::Zero(), Vec2F(0.5f, 0.f)}, 2, 0.05f };
+
+            solver.AddContact(pair, contact[0], contact[1], 0.2f, manifold);
+        }
+    };
+
+    JobSystem jobSystem;
+    jobSystem.Init(3);
+
+    std::array<AllocVector<Body>, 3> solvedBodies{ bodies, bodies, bodies };
+    const std::array<JobSystem*, 3> jobSystems{ nullptr, &jobSystem, &jobSystem };
+    const std::array<SimdLevel, 3> kernels{ SimdLevel::Scalar, SimdLevel::Scalar,
+                                                    SimdLevel::Sse };
+
+    for (std::size_t run = 0; run < solvedBodies.size(); run++)
+    {
+        ContactConstraintSolver solver{ TestHeapAllocator };
+        solver.SetMode(ContactSolverMode::GraphColored);
+        solver.SetGraphColoringConstraintCount(64);
+        addContacts(solver);
+        solver.Solve(solvedBodies[run], 0.1f, islandGraph, jobSystems[run], kernels[run]);
+
+        ASSERT_EQ(solver.ColoredIslandCount(), 1);
+        ASSERT_GT(solver.SolverColors().size(), 1);
+
+        // The constraints of a color don't share any dynamic body.
+        for (const auto& color : solver.SolverColors())
+        {
+            EXPECT_FALSE(color.IsShared);
+
+            std::vector<bool> isBodyUsed(bodies.size(), false);
+
+            for (std::size_t i = color.ConstraintBegin; i < color.ConstraintBegin + color.ConstraintCount; i++)
+            {
+                const auto& constraint = solver.Constraints()[solver.SolveOrder()[i]];
+
+                for (const auto bodyIdx : { constraint.BodyIndexA, constraint.BodyIndexB })
+                {
+                    if (bodyIdx == 0) continue;
+
+                    EXPECT_FALSE(isBodyUsed[bodyIdx]);
+                    isBodyUsed[bodyIdx] = true;
+                }
+            }
+        }
+
+        // The bodies falling on the ground are mostly stopped, the iterations converge over several steps.
+        EXPECT_GT(solvedBodies[run][1].Velocity().Y, -0.1f);
+    }
+
+    // The chunks of a color are independent, so the threads don't change the results.
+    for (std::size_t i = 0; i < bodies.size(); i++)
+    {
+        EXPECT_EQ(solvedBodies[0][i].Position(), solvedBodies[1][i].Position());
+        EXPECT_EQ(solvedBodies[0][i].Velocity(), solvedBodies[1][i].Velocity());
+
+        EXPECT_NEAR(solvedBodies[0][i].Velocity().X, solvedBodies[2][i].Velocity().X, 0.0001f);
+        EXPECT_NEAR(solvedBodies[0][i].Velocity().Y, solvedBodies[2][i].Velocity().Y, 0.0001f);
+    }
+
+    jobSystem.Deinit();
+}
@@ -265,9 +265,23 @@ void CalculateTestContactProperties(Body& body1,
 	}
 }
 
-void CalculateTestPostColVel(const ContactSolver& testedContactSolver, ContactSolver& expectedContactSolver)
+void CopyTestedActors(const ContactSolver& testedContactSolver,
+	Body& expectedBodyA,
+	Body& expectedBodyB,
+	ContactSolver& expectedContactSolver)
+{
+	expectedBodyA = *testedContactSolver.BodyA;
+	expectedBodyB = *testedContactSolver.BodyB;
+
+	expectedContactSolver.BodyA = &expectedBodyA;
+	expectedContactSolver.BodyB = &expectedBodyB;
+	expectedContactSolver.ColliderA = testedContactSolver.ColliderA;
+	expectedContactSolver.ColliderB = testedContactSolver.ColliderB;
+}
+
+void CalculateTestPostColVel(ContactSolver& expectedContactSolver)
 {
-	const auto separatingVelocity = testedContactSolver.CalculateSeparatingVelocity();
+	const auto separatingVelocity = expectedContactSolver.CalculateSeparatingVelocity();
 
 	// If the seperating velocity is positive, we don't need to calculate the delta velocity.
 	if (separatingVelocity > 0)
@@ -306,7 +320,7 @@ void CalculateTestPostColVel(const ContactSolver& testedContactSolver, ContactSo
 	}
 }
 
-void CalculateTestPostColPos(const ContactSolver& testedContactSolver, ContactSolver& expectedContactSolver)
+void CalculateTestPostColPos(ContactSolver& expectedContactSolver)
 {
 	auto* body1 = expectedContactSolver.BodyA;
 	auto* body2 = expectedContactSolver.BodyB;
@@ -380,7 +394,7 @@ TEST_P(PairOfCollidingBodies, CalculateSeparatingVelocity)
 	auto& collider1 = world.GetCollider(colRef1);
 
 	const auto bodyRef2 = world.CreateBody();
-	auto& body2 = world.GetBody(bodyRef1);
+	auto& body2 = world.GetBody(bodyRef2);
 	const auto colRef2 = world.CreateCollider(bodyRef2);
 	auto& collider2 = world.GetCollider(colRef2);
 
@@ -412,7 +426,7 @@ TEST_P(PairOfCollidingBodies, CalculatePostCollisionVelocity)
 	auto& collider1 = world.GetCollider(colRef1);
 
 	const auto bodyRef2 = world.CreateBody();
-	auto& body2 = world.GetBody(bodyRef1);
+	auto& body2 = world.GetBody(bodyRef2);
 	const auto colRef2 = world.CreateCollider(bodyRef2);
 	auto& collider2 = world.GetCollider(colRef2);
 
@@ -423,12 +437,18 @@ TEST_P(PairOfCollidingBodies, CalculatePostCollisionVelocity)
 		testedContactSolver, expectedContactSolver);
 
 	testedContactSolver.CalculateContactProperties();
-	CalculateTestContactProperties(body1, body2, collider1, collider2, expectedContactSolver);
 
-	CalculateTestPostColVel(testedContactSolver, expectedContactSolver);
+	// The expected values are computed on copies of the bodies, in the order of the actors of the tested solver.
+	Body expectedBodyA, expectedBodyB;
+	CopyTestedActors(testedContactSolver, expectedBodyA, expectedBodyB, expectedContactSolver);
+	CalculateTestContactProperties(expectedBodyA, expectedBodyB,
+		*expectedContactSolver.ColliderA, *expectedContactSolver.ColliderB, expectedContactSolver);
 
-	EXPECT_EQ(testedContactSolver.BodyA->Velocity(), body1.Velocity());
-	EXPECT_EQ(testedContactSolver.BodyB->Velocity(), body2.Velocity());
+	CalculateTestPostColVel(expectedContactSolver);
+	testedContactSolver.ResolvePostCollisionVelocity();
+
+	EXPECT_EQ(testedContactSolver.BodyA->Velocity(), expectedBodyA.Velocity());
+	EXPECT_EQ(testedContactSolver.BodyB->Velocity(), expectedBodyB.Velocity());
 }
 
 TEST_P(PairOfCollidingBodies, CalculatePostCollisionPosition)
@@ -444,7 +464,7 @@ TEST_P(PairOfCollidingBodies, CalculatePostCollisionPosition)
 	auto& collider1 = world.GetCollider(colRef1);
 
 	const auto bodyRef2 = world.CreateBody();
-	auto& body2 = world.GetBody(bodyRef1);
+	auto& body2 = world.GetBody(bodyRef2);
 	const auto colRef2 = world.CreateCollider(bodyRef2);
 	auto& collider2 = world.GetCollider(colRef2);
 
@@ -455,12 +475,18 @@ TEST_P(PairOfCollidingBodies, CalculatePostCollisionPosition)
 		testedContactSolver, expectedContactSolver);
 
 	testedContactSolver.CalculateContactProperties();
-	CalculateTestContactProperties(body1, body2, collider1, collider2, expectedContactSolver);
 
-	CalculateTestPostColPos(testedContactSolver, expectedContactSolver);
+	// The expected values are computed on copies of the bodies, in the order of the actors of the tested solver.
+	Body expectedBodyA, expectedBodyB;
+	CopyTestedActors(testedContactSolver, expectedBodyA, expectedBodyB, expectedContactSolver);
+	CalculateTestContactProperties(expectedBodyA, expectedBodyB,
+		*expectedContactSolver.ColliderA, *expectedContactSolver.ColliderB, expectedContactSolver);
+
+	CalculateTestPostColPos(expectedContactSolver);
+	testedContactSolver.ResolvePostCollisionPosition();
 
-	EXPECT_EQ(testedContactSolver.BodyA->Position(), body1.Position());
-	EXPECT_EQ(testedContactSolver.BodyB->Position(), body2.Position());
+	EXPECT_EQ(testedContactSolver.BodyA->Position(), expectedBodyA.Position());
+	EXPECT_EQ(testedContactSolver.BodyB->Position(), expectedBodyB.Position());
 }
 
 TEST_P(PairOfCollidingBodies, ResolveContact)
@@ -476,7 +502,7 @@ TEST_P(PairOfCollidingBodies, ResolveContact)
 	auto& collider1 = world.GetCollider(colRef1);
 
 	const auto bodyRef2 = world.CreateBody();
-	auto& body2 = world.GetBody(bodyRef1);
+	auto& body2 = world.GetBody(bodyRef2);
 	const auto colRef2 = world.CreateCollider(bodyRef2);
 	auto& collider2 = world.GetCollider(colRef2);
 
@@ -486,27 +512,37 @@ TEST_P(PairOfCollidingBodies, ResolveContact)
 	SetBodyAndColliderValues(cb1, cb2, body1, body2, collider1, collider2,
 		testedContactSolver, expectedContactSolver);
 
+	// The expected values are computed on copies of the bodies before the tested solver moves them, the actors
+	// being ordered by shape type as the tested solver does.
+	if (collider2.Shape().index() < collider1.Shape().index())
+	{
+		std::swap(testedContactSolver.BodyA, testedContactSolver.BodyB);
+		std::swap(testedContactSolver.ColliderA, testedContactSolver.ColliderB);
+	}
 
-	testedContactSolver.ResolveContact();
-
-	CalculateTestContactProperties(body1, body2, collider1, collider2, expectedContactSolver);
+	Body expectedBodyA, expectedBodyB;
+	CopyTestedActors(testedContactSolver, expectedBodyA, expectedBodyB, expectedContactSolver);
+	CalculateTestContactProperties(expectedBodyA, expectedBodyB,
+		*expectedContactSolver.ColliderA, *expectedContactSolver.ColliderB, expectedContactSolver);
 
-	if (body1.GetBodyType() == BodyType::Static)
+	if (expectedBodyA.GetBodyType() == BodyType::Static)
 	{
-		std::swap(body1, body2);
+		std::swap(expectedContactSolver.BodyA, expectedContactSolver.BodyB);
 		expectedContactSolver.Normal = -expectedContactSolver.Normal;
 	}
 
-	CalculateTestPostColVel(testedContactSolver, expectedContactSolver);
-	CalculateTestPostColPos(testedContactSolver, expectedContactSolver);
+	CalculateTestPostColVel(expectedContactSolver);
+	CalculateTestPostColPos(expectedContactSolver);
+
+	testedContactSolver.ResolveContact();
 
 	EXPECT_EQ(testedContactSolver.Normal, expectedContactSolver.Normal);
 	EXPECT_EQ(testedContactSolver.Point, expectedContactSolver.Point);
 	EXPECT_EQ(testedContactSolver.Penetration, expectedContactSolver.Penetration);
 
-	EXPECT_EQ(testedContactSolver.BodyA->Velocity(), body1.Velocity());
-	EXPECT_EQ(testedContactSolver.BodyB->Velocity(), body2.Velocity());
+	EXPECT_EQ(testedContactSolver.BodyA->Velocity(), expectedContactSolver.BodyA->Velocity());
+	EXPECT_EQ(testedContactSolver.BodyB->Velocity(), expectedContactSolver.BodyB->Velocity());
 
-	EXPECT_EQ(testedContactSolver.BodyA->Position(), body1.Position());
-	EXPECT_EQ(testedContactSolver.BodyB->Position(), body2.Position());
+	EXPECT_EQ(testedContactSolver.BodyA->Position(), expectedContactSolver.BodyA->Position());
+	EXPECT_EQ(testedContactSolver.BodyB->Position(), expectedContactSolver.BodyB->Position());
 }
\ No newline at end of file
@@ -0,0 +1,177 @@
+#include "Gjk.h"
+
+#include "gtest/gtest.h"
+
+using namespace Math;
+using namespace PhysicsEngine;
+
+static const PolygonF Triangle({Vec2F::Zero(), Vec2F(2.f, 0.f), Vec2F(0.f, 2.f)});
+static const PolygonF Hexagon({Vec2F(1.f, 0.f), Vec2F(0.5f, 0.9f), Vec2F(-0.5f, 0.9f),
+                               Vec2F(-1.f, 0.f), Vec2F(-0.5f, -0.9f), Vec2F(0.5f, -0.9f)});
+
+struct GjkFixture : public ::testing::TestWithParam<Vec2F> {};
+
+// The offsets avoid the touching positions, where the result of GJK depends on the rounding.
+INSTANTIATE_TEST_SUITE_P(Gjk, GjkFixture, testing::Values(
+        Vec2F(0.3f, 0.4f),
+        Vec2F(1.1f, 1.3f),
+        Vec2F(2.7f, 0.1f),
+        Vec2F(-1.3f, 0.6f),
+        Vec2F(-0.2f, -1.1f),
+        Vec2F(3.5f, 3.5f),
+        Vec2F(-4.f, 1.f)
+));
+
+TEST_P(GjkFixture, PolygonPolygonMatchesIntersect)
+{
+    const auto offset = GetParam();
+    const PolygonF movedHexagon = Hexagon + offset;
+
+    const TranslatedPolygon triangle{PolygonSpanF(Triangle), Vec2F::Zero()};
+    const TranslatedPolygon hexagon{PolygonSpanF(Hexagon), offset};
+
+    Simplex simplex;
+
+    EXPECT_EQ(GjkOverlap(triangle, hexagon, simplex), Intersect(Triangle, movedHexagon));
+    EXPECT_EQ(GjkOverlap(hexagon, triangle, simplex), Intersect(Triangle, movedHexagon));
+}
+
+TEST_P(GjkFixture, PolygonCircleMatchesIntersect)
+{
+    const auto offset = GetParam();
+    const TranslatedPolygon triangle{PolygonSpanF(Triangle), Vec2F::Zero()};
+    const CircleF circle(offset, 0.5f);
+
+    Simplex simplex;
+
+    EXPECT_EQ(GjkOverlap(triangle, circle, simplex), Intersect(PolygonSpanF(Triangle), circle));
+}
+
+TEST_P(GjkFixture, PolygonRectangleMatchesIntersect)
+{
+    const auto offset = GetParam();
+    const TranslatedPolygon triangle{PolygonSpanF(Triangle), Vec2F::Zero()};
+    const RectangleF rectangle(offset, offset + Vec2F(0.5f, 0.25f));
+
+    Simplex simplex;
+
+    EXPECT_EQ(GjkOverlap(triangle, rectangle, simplex), Intersect(PolygonSpanF(Triangle), rectangle));
+}
+
+TEST_P(GjkFixture, WarmStartGivesSameResult)
+{
+    const auto offset = GetParam();
+    const TranslatedPolygon triangle{PolygonSpanF(Triangle), Vec2F::Zero()};
+
+    SimplexCache cache;
+    Simplex simplex;
+
+    // The cache is filled by the first test and used by the next ones, at the new positions of the shapes.
+    EXPECT_EQ(GjkOverlap(triangle, TranslatedPolygon{PolygonSpanF(Hexagon), offset}, simplex, &cache),
+              Intersect(Triangle, Hexagon + offset));
+    EXPECT_GT(cache.Count, 0);
+
+    for (const auto step : {Vec2F(0.1f, 0.f), Vec2F(0.f, 0.35f), Vec2F(-2.5f, -0.15f)})
+    {
+        const auto newOffset = offset + step;
+
+        EXPECT_EQ(GjkOverlap(triangle, TranslatedPolygon{PolygonSpanF(Hexagon), newOffset}, simplex, &cache),
+                  Intersect(Triangle, Hexagon + newOffset));
+    }
+}
+
+TEST(Gjk, EpaRectangles)
+{
+    const RectangleF rectA(Vec2F::Zero(), Vec2F(2.f, 2.f));
+    const RectangleF rectB(Vec2F(1.5f, 0.5f), Vec2F(3.f, 1.5f));
+
+    Simplex simplex;
+    ASSERT_TRUE(GjkOverlap(rectA, rectB, simplex));
+
+    const auto penetration = Epa(rectA, rectB, simplex);
+
+    // B goes 0.5 inside the right side of A.
+    EXPECT_NEAR(penetration.Normal.X, 1.f, 0.001f);
+    EXPECT_NEAR(penetration.Normal.Y, 0.f, 0.001f);
+    EXPECT_NEAR(penetration.Depth, 0.5f, 0.001f);
+}
+
+TEST(Gjk, EpaCircles)
+{
+    const CircleF circleA(Vec2F::Zero(), 1.f);
+    const CircleF circleB(Vec2F(0.f, -1.5f), 1.f);
+
+    Simplex simplex;
+    ASSERT_TRUE(GjkOverlap(circleA, circleB, simplex));
+
+    const auto penetration = Epa(circleA, circleB, simplex);
+
+    EXPECT_NEAR(penetration.Normal.X, 0.f, 0.01f);
+    EXPECT_NEAR(penetration.Normal.Y, -1.f, 0.01f);
+    EXPECT_NEAR(penetration.Depth, 0.5f, 0.01f);
+}
+
+TEST(Gjk, PolygonWithSameCenter)
+{
+    const TranslatedPolygon triangle{PolygonSpanF(Triangle), Vec2F::Zero()};
+    const TranslatedPolygon sameTriangle{PolygonSpanF(Triangle), Vec2F::Zero()};
+
+    Simplex simplex;
+    ASSERT_TRUE(GjkOverlap(triangle, sameTriangle, simplex));
+
+    const auto penetration = Epa(triangle, sameTriangle, simplex);
+
+    EXPECT_GT(penetration.Depth, 0.f);
+    EXPECT_NEAR(penetration.Normal.Length(), 1.f, 0.001f);
+}
+
+TEST(Gjk, ShapeCastCircleRectangle)
+{
+    // The circle must keep its radius even when the search direction of the cast gets very short.
+    const CircleF circle(Vec2F(-5.f, 0.f), 0.1f);
+    const RectangleF wall(Vec2F(0.f, -1.f), Vec2F(0.2f, 1.f));
+
+    // The circle touches the wall after 4.9 of its 10 of translation.
+    const auto hit = ShapeCast(circle, wall, Vec2F(10.f, 0.f));
+
+    ASSERT_TRUE(hit.Hit);
+    EXPECT_NEAR(hit.Time, 0.49f, 0.001f);
+    EXPECT_LE(hit.Time, 0.49f);
+    EXPECT_NEAR(hit.Normal.X, -1.f, 0.001f);
+    EXPECT_NEAR(hit.Normal.Y, 0.f, 0.001f);
+}
+
+TEST(Gjk, ShapeCastPolygonRectangle)
+{
+    const TranslatedPolygon triangle{PolygonSpanF(Triangle), Vec2F(0.f, 5.f)};
+    const RectangleF ground(Vec2F(-5.f, -1.f), Vec2F(5.f, 0.f));
+
+    const auto hit = ShapeCast(triangle, ground, Vec2F(0.f, -20.f));
+
+    ASSERT_TRUE(hit.Hit);
+    EXPECT_NEAR(hit.Time, 0.25f, 0.001f);
+    EXPECT_NEAR(hit.Normal.Y, 1.f, 0.001f);
+}
+
+TEST(Gjk, ShapeCastMisses)
+{
+    const CircleF circle(Vec2F(-5.f, 0.f), 0.5f);
+    const RectangleF wall(Vec2F(0.f, -1.f), Vec2F(0.2f, 1.f));
+
+    EXPECT_FALSE(ShapeCast(circle, wall, Vec2F(0.f, 10.f)).Hit);
+    EXPECT_FALSE(ShapeCast(circle, wall, Vec2F(-10.f, 0.f)).Hit);
+
+    // The translation stops before the wall.
+    EXPECT_FALSE(ShapeCast(circle, wall, Vec2F(4.f, 0.f)).Hit);
+}
+
+TEST(Gjk, ShapeCastAlreadyTouching)
+{
+    const CircleF circle(Vec2F(0.1f, 0.f), 0.5f);
+    const RectangleF wall(Vec2F(0.f, -1.f), Vec2F(0.2f, 1.f));
+
+    const auto hit = ShapeCast(circle, wall, Vec2F(10.f, 0.f));
+
+    ASSERT_TRUE(hit.Hit);
+    EXPECT_EQ(hit.Time, 0.f);
+}
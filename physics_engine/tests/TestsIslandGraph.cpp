@@ -0,0 +1,69 @@
+#include "IslandGraph.h"
+
+#include "gtest/gtest.h"
+
+using namespace PhysicsEngine;
+using namespace Math;
+
+static HeapAllocator TestHeapAllocator;
+
+TEST(IslandGraph, BuildsIslandsOfLinkedBodies)
+{
+    AllocVector<Body> bodies{ StandardAllocator<Body>{TestHeapAllocator} };
+
+    for (int i = 0; i < 6; i++)
+    {
+        bodies.emplace_back(Vec2F::Zero(), Vec2F::Zero(), 1.f);
+    }
+
+    bodies[2].SetBodyType(BodyType::Static);
+
+    IslandGraph graph{ TestHeapAllocator };
+    graph.Reset(bodies.size());
+
+    // The links are given in any order and any direction.
+    graph.Link(5, 3);
+    graph.Link(3, 0);
+    graph.Link(1, 4);
+
+    graph.Build(bodies);
+
+    ASSERT_EQ(graph.Islands().size(), 2);
+
+    // The islands are in the order of their lowest body and their bodies in increasing order.
+    const auto& first = graph.Islands()[0];
+    ASSERT_EQ(first.BodyCount, 3);
+    EXPECT_EQ(graph.IslandBody(first, 0), 0);
+    EXPECT_EQ(graph.IslandBody(first, 1), 3);
+    EXPECT_EQ(graph.IslandBody(first, 2), 5);
+
+    const auto& second = graph.Islands()[1];
+    ASSERT_EQ(second.BodyCount, 2);
+    EXPECT_EQ(graph.IslandBody(second, 0), 1);
+    EXPECT_EQ(graph.IslandBody(second, 1), 4);
+
+    EXPECT_EQ(graph.IslandOf(5), 0);
+    EXPECT_EQ(graph.IslandOf(4), 1);
+    EXPECT_EQ(graph.IslandOf(2), IslandGraph::NoIsland);
+}
+
+TEST(IslandGraph, LonelyBodiesHaveTheirOwnIsland)
+{
+    AllocVector<Body> bodies{ StandardAllocator<Body>{TestHeapAllocator} };
+    bodies.emplace_back(Vec2F::Zero(), Vec2F::Zero(), 1.f);
+    bodies.emplace_back(Vec2F::Zero(), Vec2F::Zero(), 1.f);
+    bodies.emplace_back();
+
+    IslandGraph graph{ TestHeapAllocator };
+    graph.Reset(bodies.size());
+    graph.Build(bodies);
+
+    // The invalid body is in no island.
+    ASSERT_EQ(graph.Islands().size(), 2);
+    EXPECT_EQ(graph.IslandOf(2), IslandGraph::NoIsland);
+
+    graph.Clear();
+
+    EXPECT_TRUE(graph.Islands().empty());
+    EXPECT_EQ(graph.IslandOf(0), IslandGraph::NoIsland);
+}
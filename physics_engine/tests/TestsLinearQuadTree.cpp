@@ -0,0 +1,185 @@
+#include "LinearQuadTree.h"
+
+#include "gtest/gtest.h"
+#include "Random.h"
+
+#include <algorithm>
+#include <vector>
+
+using namespace PhysicsEngine;
+using namespace Math;
+
+static HeapAllocator TestHeapAllocator;
+
+struct LinearQuadTreeColliderNumberFixture : public ::testing::TestWithParam<int> {};
+
+INSTANTIATE_TEST_SUITE_P(LinearQuadTree, LinearQuadTreeColliderNumberFixture,
+                         testing::Values(0, 1, 2, 10, 100, 321, 2000, 5000));
+
+/**
+ * @brief NormalizePairs orders the colliders inside each pair and the pairs themselves to compare the lists.
+ */
+static std::vector<ColliderPair> NormalizePairs(const AllocVector<ColliderPair>& possiblePairs) noexcept
+{
+    std::vector<ColliderPair> pairs;
+
+    for (const auto& pair : possiblePairs)
+    {
+        pairs.push_back(pair.ColliderB.Index < pair.ColliderA.Index ?
+                        ColliderPair{ pair.ColliderB, pair.ColliderA } : pair);
+    }
+
+    std::sort(pairs.begin(), pairs.end());
+
+    return pairs;
+}
+
+TEST(LinearQuadTree, MortonCode)
+{
+    EXPECT_EQ(MortonCode(0, 0), 0u);
+    EXPECT_EQ(MortonCode(1, 0), 1u);
+    EXPECT_EQ(MortonCode(0, 1), 2u);
+    EXPECT_EQ(MortonCode(1, 1), 3u);
+    EXPECT_EQ(MortonCode(2, 0), 4u);
+    EXPECT_EQ(MortonCode(0xffff, 0xffff), 0xffffffffu);
+
+    // The four cells of a node have consecutive codes.
+    EXPECT_EQ(MortonCode(6, 4) >> 2, MortonCode(7, 5) >> 2);
+}
+
+TEST(LinearQuadTree, DefaultConstructor)
+{
+    LinearQuadTree linearQuadTree;
+
+    EXPECT_EQ(linearQuadTree.PossiblePairs().size(), 0);
+    EXPECT_EQ(linearQuadTree.NodeCount(), 0);
+}
+
+TEST_P(LinearQuadTreeColliderNumberFixture, Update)
+{
+    LinearQuadTree linearQuadTree;
+    linearQuadTree.Init();
+
+    const std::size_t colNbr = GetParam();
+
+    AllocVector<SimplifiedCollider> simplifiedColliders{ StandardAllocator<SimplifiedCollider>{TestHeapAllocator} };
+
+    for (std::size_t i = 0; i < colNbr; i++)
+    {
+        Vec2F rndPos(Random::Range(-20.f, 20.f), Random::Range(-20.f, 20.f));
+
+        // Some colliders are big enough to straddle the nodes of the first levels.
+        const float maxHalfSize = i % 10 == 0 ? 3.f : 0.25f;
+        Vec2F rndHalfSize(Random::Range(0.05f, maxHalfSize), Random::Range(0.05f, maxHalfSize));
+
+        simplifiedColliders.push_back({ ColliderRef{i, 0}, RectangleF::FromCenter(rndPos, rndHalfSize) });
+    }
+
+    for (int step = 0; step < 3; step++)
+    {
+        for (auto& simplCol : simplifiedColliders)
+        {
+            simplCol.Rectangle = simplCol.Rectangle + Vec2F(Random::Range(-1.f, 1.f), Random::Range(-1.f, 1.f));
+        }
+
+        linearQuadTree.Update(simplifiedColliders);
+
+        const auto& entries = linearQuadTree.Entries();
+
+        ASSERT_EQ(entries.size(), colNbr);
+        EXPECT_TRUE(std::is_sorted(entries.begin(), entries.end(),
+                                   [](const MortonEntry& entryA, const MortonEntry& entryB)
+                                   {
+                                       return entryA.Key < entryB.Key;
+                                   }));
+
+        AllocVector<ColliderPair> expectedPairs{ StandardAllocator<ColliderPair>{TestHeapAllocator} };
+
+        for (std::size_t i = 0; i < simplifiedColliders.size(); i++)
+        {
+            for (std::size_t j = i + 1; j < simplifiedColliders.size(); j++)
+            {
+                if (Intersect(simplifiedColliders[i].Rectangle, simplifiedColliders[j].Rectangle))
+                {
+                    expectedPairs.push_back(ColliderPair{ simplifiedColliders[i].ColRef,
+                                                          simplifiedColliders[j].ColRef });
+                }
+            }
+        }
+
+        const auto possiblePairs = NormalizePairs(linearQuadTree.PossiblePairs());
+        const auto sortedExpectedPairs = NormalizePairs(expectedPairs);
+
+        ASSERT_EQ(possiblePairs.size(), sortedExpectedPairs.size());
+
+        for (std::size_t i = 0; i < sortedExpectedPairs.size(); i++)
+        {
+            EXPECT_EQ(possiblePairs[i].ColliderA, sortedExpectedPairs[i].ColliderA);
+            EXPECT_EQ(possiblePairs[i].ColliderB, sortedExpectedPairs[i].ColliderB);
+        }
+    }
+}
+
+TEST(LinearQuadTree, StraddlingColliderStaysInRoot)
+{
+    LinearQuadTree linearQuadTree;
+    linearQuadTree.Init();
+
+    AllocVector<SimplifiedCollider> simplifiedColliders{ StandardAllocator<SimplifiedCollider>{TestHeapAllocator} };
+    simplifiedColliders.push_back({ ColliderRef{0, 0}, RectangleF(Vec2F(0.f, 0.f), Vec2F(1.f, 1.f)) });
+    simplifiedColliders.push_back({ ColliderRef{1, 0}, RectangleF(Vec2F(7.f, 7.f), Vec2F(8.f, 8.f)) });
+    simplifiedColliders.push_back({ ColliderRef{2, 0}, RectangleF(Vec2F(3.f, 3.f), Vec2F(5.f, 5.f)) });
+
+    linearQuadTree.Update(simplifiedColliders);
+
+    // The collider across the center of the root is in the root, which is the first node.
+    ASSERT_EQ(linearQuadTree.NodeCount(), 3);
+    EXPECT_EQ(linearQuadTree.Entries()[0].ColliderIdx, 2);
+    EXPECT_EQ(linearQuadTree.Entries()[0].Key, 0);
+    EXPECT_EQ(linearQuadTree.PossiblePairs().size(), 0);
+}
+
+TEST_P(LinearQuadTreeColliderNumberFixture, ParallelUpdate)
+{
+    JobSystem jobSystem;
+    jobSystem.Init(3);
+
+    LinearQuadTree sequentialQuadTree;
+    sequentialQuadTree.Init();
+
+    LinearQuadTree parallelQuadTree;
+    parallelQuadTree.Init();
+    parallelQuadTree.SetJobSystem(&jobSystem);
+
+    const std::size_t colNbr = GetParam();
+
+    AllocVector<SimplifiedCollider> colliders{ StandardAllocator<SimplifiedCollider>{TestHeapAllocator} };
+
+    for (std::size_t i = 0; i < colNbr; i++)
+    {
+        Math::Vec2F rndPos(Math::Random::Range(1.f, 30.f), Math::Random::Range(-1.f, -30.f));
+        colliders.push_back({ ColliderRef{i, 0}, RectangleF::FromCenter(rndPos, Vec2F(0.15f, 0.15f)) });
+    }
+
+    sequentialQuadTree.Update(colliders);
+    parallelQuadTree.Update(colliders);
+
+    // The radix sort is stable, so the parallel sort gives the same entries and pairs in the same order.
+    ASSERT_EQ(sequentialQuadTree.Entries().size(), parallelQuadTree.Entries().size());
+
+    for (std::size_t i = 0; i < sequentialQuadTree.Entries().size(); i++)
+    {
+        EXPECT_EQ(sequentialQuadTree.Entries()[i].Key, parallelQuadTree.Entries()[i].Key);
+        EXPECT_EQ(sequentialQuadTree.Entries()[i].ColliderIdx, parallelQuadTree.Entries()[i].ColliderIdx);
+    }
+
+    ASSERT_EQ(sequentialQuadTree.PossiblePairs().size(), parallelQuadTree.PossiblePairs().size());
+
+    for (std::size_t i = 0; i < sequentialQuadTree.PossiblePairs().size(); i++)
+    {
+        EXPECT_EQ(sequentialQuadTree.PossiblePairs()[i].ColliderA, parallelQuadTree.PossiblePairs()[i].ColliderA);
+        EXPECT_EQ(sequentialQuadTree.PossiblePairs()[i].ColliderB, parallelQuadTree.PossiblePairs()[i].ColliderB);
+    }
+
+    jobSystem.Deinit();
+}
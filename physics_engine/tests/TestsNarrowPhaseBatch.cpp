@@ -0,0 +1,102 @@
+#include "NarrowPhaseBatch.h"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+
+using namespace PhysicsEngine;
+using namespace Math;
+
+static HeapAllocator TestHeapAllocator;
+
+struct KernelFixture : public ::testing::TestWithParam<SimdLevel> {};
+
+INSTANTIATE_TEST_SUITE_P(NarrowPhaseBatch, KernelFixture, testing::Values(
+        SimdLevel::Scalar,
+        SimdLevel::Sse,
+        SimdLevel::Avx2
+));
+
+TEST_P(KernelFixture, RunMatchesIntersect)
+{
+    const auto kernel = GetParam();
+
+    if (kernel == SimdLevel::Avx2 && BestSimdLevel() != SimdLevel::Avx2)
+    {
+        GTEST_SKIP() << "The CPU does not support AVX2.";
+    }
+
+    NarrowPhaseBatch batch{ TestHeapAllocator };
+
+    // An odd number of pairs to test the scalar tail of the SIMD kernels.
+    constexpr std::size_t pairCount = 37;
+    batch.Reserve(pairCount);
+
+    AllocVector<ColliderPair> expectedPairs{ StandardAllocator<ColliderPair>{TestHeapAllocator} };
+
+    for (std::size_t i = 0; i < pairCount; i++)
+    {
+        const auto f = static_cast<float>(i);
+        const auto idx = static_cast<int>(i);
+
+        const CircleF circleA(Vec2F(f * 0.5f, 1.f), 0.5f + f * 0.05f);
+        const CircleF circleB(Vec2F(f * 0.75f, 1.f + f * 0.1f), 0.75f);
+        const ColliderPair circlePair{ ColliderRef{ i, 0 }, ColliderRef{ i + pairCount, 0 } };
+
+        const RectangleF rectA(Vec2F(f, 0.f), Vec2F(f + 1.f, 1.f));
+        const RectangleF rectB(Vec2F(f * 1.1f + (idx % 3 == 0 ? 1.f : 0.5f), 0.5f), Vec2F(f * 1.1f + 2.f, 2.f));
+        const ColliderPair rectPair{ ColliderRef{ i + 2 * pairCount, 0 }, ColliderRef{ i + 3 * pairCount, 0 } };
+
+        batch.AddCircles(circlePair, circleA, circleB);
+        batch.AddRectangles(rectPair, rectA, rectB);
+
+        if (Intersect(circleA, circleB)) expectedPairs.push_back(circlePair);
+        if (Intersect(rectA, rectB)) expectedPairs.push_back(rectPair);
+    }
+
+    EXPECT_EQ(batch.CircleCount(), pairCount);
+    EXPECT_EQ(batch.RectangleCount(), pairCount);
+
+    AllocVector<ColliderPair> overlappingPairs{ StandardAllocator<ColliderPair>{TestHeapAllocator} };
+    batch.Run(kernel, overlappingPairs);
+
+    const auto isLower = [](const ColliderPair& pairA, const ColliderPair& pairB)
+    {
+        return pairA.Key() < pairB.Key();
+    };
+
+    std::sort(overlappingPairs.begin(), overlappingPairs.end(), isLower);
+    std::sort(expectedPairs.begin(), expectedPairs.end(), isLower);
+
+    EXPECT_GT(expectedPairs.size(), 0);
+    ASSERT_EQ(overlappingPairs.size(), expectedPairs.size());
+
+    for (std::size_t i = 0; i < expectedPairs.size(); i++)
+    {
+        EXPECT_EQ(overlappingPairs[i].ColliderA, expectedPairs[i].ColliderA);
+        EXPECT_EQ(overlappingPairs[i].ColliderB, expectedPairs[i].ColliderB);
+    }
+}
+
+TEST(NarrowPhaseBatch, AddPairAndClear)
+{
+    NarrowPhaseBatch batch{ TestHeapAllocator };
+    batch.Reserve(4);
+
+    const ColliderPair pair{ ColliderRef{ 0, 0 }, ColliderRef{ 1, 0 } };
+    batch.AddPair(ShapeType::Rectangle, ShapeType::Circle, pair);
+    batch.AddCircles(pair, CircleF(Vec2F::Zero(), 1.f), CircleF(Vec2F::Zero(), 1.f));
+
+    const auto bucketIdx = static_cast<std::size_t>(ShapeType::Rectangle) * WorldShapeTypeCount +
+                           static_cast<std::size_t>(ShapeType::Circle);
+
+    ASSERT_EQ(batch.PairBucket(bucketIdx).size(), 1);
+    EXPECT_EQ(batch.PairBucket(bucketIdx)[0].ColliderA, pair.ColliderA);
+    EXPECT_EQ(batch.CircleCount(), 1);
+
+    batch.Clear();
+
+    EXPECT_EQ(batch.PairBucket(bucketIdx).size(), 0);
+    EXPECT_EQ(batch.CircleCount(), 0);
+    EXPECT_EQ(batch.RectangleCount(), 0);
+}
@@ -4,6 +4,8 @@
 #include "gtest/gtest.h"
 #include "Random.h"
 
+#include <algorithm>
+
 using namespace PhysicsEngine;
 using namespace Math;
 
@@ -21,6 +23,8 @@ TEST(QuadNode, DefaultConstructor)
 
     EXPECT_EQ(node.Boundary.MinBound(), Vec2F::Zero());
     EXPECT_EQ(node.Boundary.MaxBound(), Vec2F::Zero());
+    EXPECT_EQ(node.LooseBoundary.MinBound(), Vec2F::Zero());
+    EXPECT_EQ(node.LooseBoundary.MaxBound(), Vec2F::Zero());
 
     for (const auto& child : node.Children)
     {
@@ -400,4 +404,384 @@ TEST_P(ColliderNumberFixture, CalculatePossiblePairs)
     {
         EXPECT_EQ(quadPossiblePairs[i], possiblePairs[i]);
     }
-}
\ No newline at end of file
+}
+std::vector<ColliderPair> CalculatePairsBruteForce(const std::vector<RectangleF>& rectangles,
+                                                   const std::vector<bool>& enabled) noexcept
+{
+    std::vector<ColliderPair> possiblePairs;
+
+    for (std::size_t i = 0; i < rectangles.size(); i++)
+    {
+        if (!enabled[i]) continue;
+
+        for (std::size_t j = i + 1; j < rectangles.size(); j++)
+        {
+            if (!enabled[j]) continue;
+
+            if (Math::Intersect(rectangles[i], rectangles[j]))
+            {
+                possiblePairs.push_back(ColliderPair{ ColliderRef{i, 0}, ColliderRef{j, 0} });
+            }
+        }
+    }
+
+    return possiblePairs;
+}
+
+TEST_P(ColliderNumberFixture, UpdatePossiblePairs)
+{
+    QuadTree quadTree;
+    quadTree.Init();
+
+    // Without margin, the fat rectangles are the simplified shapes, so the possible pairs must be the exact
+    // pairs of intersecting rectangles.
+    quadTree.SetFatMargin(0.f);
+
+    const std::size_t colNbr = GetParam();
+
+    std::vector<RectangleF> rectangles;
+    std::vector<bool> enabled(colNbr, true);
+
+    for (std::size_t i = 0; i < colNbr; i++)
+    {
+        Math::Vec2F rndPos(Math::Random::Range(1.f, 7.f), Math::Random::Range(-1.f, -5.f));
+        rectangles.push_back(RectangleF::FromCenter(rndPos, Vec2F(0.15f, 0.15f)));
+    }
+
+    for (int step = 0; step < 5; step++)
+    {
+        for (std::size_t i = 0; i < colNbr; i++)
+        {
+            // Only a part of the colliders move each step, and some go far away to force a rebuild.
+            if (step > 0 && i % 3 == static_cast<std::size_t>(step % 3))
+            {
+                const auto range = step == 3 ? 10.f : 0.2f;
+                rectangles[i] = rectangles[i] + Vec2F(Math::Random::Range(-range, range),
+                                                      Math::Random::Range(-range, range));
+            }
+
+            // Some colliders are removed and added back.
+            if (step > 0 && i % 7 == static_cast<std::size_t>(step))
+            {
+                enabled[i] = !enabled[i];
+            }
+
+            if (enabled[i])
+            {
+                quadTree.UpdateProxy(rectangles[i], ColliderRef{i, 0});
+            }
+            else
+            {
+                quadTree.RemoveProxy(ColliderRef{i, 0});
+            }
+        }
+
+        quadTree.UpdatePossiblePairs();
+
+        auto expectedPairs = CalculatePairsBruteForce(rectangles, enabled);
+
+        // Order the colliders inside each pair and the pairs themselves to compare the two lists.
+        std::vector<ColliderPair> quadPossiblePairs;
+
+        for (const auto& pair : quadTree.PossiblePairs())
+        {
+            if (pair.ColliderB.Index < pair.ColliderA.Index)
+            {
+                quadPossiblePairs.push_back(ColliderPair{ pair.ColliderB, pair.ColliderA });
+            }
+            else
+            {
+                quadPossiblePairs.push_back(pair);
+            }
+        }
+
+        std::sort(quadPossiblePairs.begin(), quadPossiblePairs.end());
+        std::sort(expectedPairs.begin(), expectedPairs.end());
+
+        ASSERT_EQ(quadPossiblePairs.size(), expectedPairs.size());
+
+        for (std::size_t i = 0; i < expectedPairs.size(); i++)
+        {
+            EXPECT_EQ(quadPossiblePairs[i].ColliderA, expectedPairs[i].ColliderA);
+            EXPECT_EQ(quadPossiblePairs[i].ColliderB, expectedPairs[i].ColliderB);
+        }
+    }
+}
+
+TEST(QuadTree, UpdateProxyInsideFatRectangle)
+{
+    QuadTree quadTree;
+    quadTree.Init();
+    quadTree.SetFatMargin(0.5f);
+
+    const ColliderRef colRefA{0, 0};
+    const ColliderRef colRefB{1, 0};
+
+    quadTree.UpdateProxy(RectangleF(Vec2F(0.f, 0.f), Vec2F(1.f, 1.f)), colRefA);
+    quadTree.UpdateProxy(RectangleF(Vec2F(5.f, 5.f), Vec2F(6.f, 6.f)), colRefB);
+    quadTree.UpdatePossiblePairs();
+
+    EXPECT_EQ(quadTree.PossiblePairs().size(), 0);
+
+    // The collider B moves but stays inside its fat rectangle, so nothing changes.
+    quadTree.UpdateProxy(RectangleF(Vec2F(4.6f, 4.6f), Vec2F(5.6f, 5.6f)), colRefB);
+    quadTree.UpdatePossiblePairs();
+
+    EXPECT_EQ(quadTree.PossiblePairs().size(), 0);
+
+    // The collider B leaves its fat rectangle and its new fat rectangle touches the one of A.
+    quadTree.UpdateProxy(RectangleF(Vec2F(1.8f, 1.8f), Vec2F(2.8f, 2.8f)), colRefB);
+    quadTree.UpdatePossiblePairs();
+
+    ASSERT_EQ(quadTree.PossiblePairs().size(), 1);
+    EXPECT_EQ(quadTree.PossiblePairs()[0], (ColliderPair{colRefA, colRefB}));
+
+    // The collider A is destroyed and its index is reused by another collider.
+    quadTree.RemoveProxy(colRefA);
+    quadTree.UpdatePossiblePairs();
+
+    EXPECT_EQ(quadTree.PossiblePairs().size(), 0);
+
+    const ColliderRef newColRefA{0, 1};
+
+    quadTree.UpdateProxy(RectangleF(Vec2F(2.f, 2.f), Vec2F(3.f, 3.f)), newColRefA);
+    quadTree.UpdatePossiblePairs();
+
+    ASSERT_EQ(quadTree.PossiblePairs().size(), 1);
+    EXPECT_EQ(quadTree.PossiblePairs()[0], (ColliderPair{newColRefA, colRefB}));
+}
+
+TEST_P(ColliderNumberFixture, ParallelUpdate)
+{
+    JobSystem jobSystem;
+    jobSystem.Init(3);
+
+    QuadTree sequentialQuadTree;
+    sequentialQuadTree.Init();
+
+    QuadTree parallelQuadTree;
+    parallelQuadTree.Init();
+    parallelQuadTree.SetJobSystem(&jobSystem);
+
+    const std::size_t colNbr = GetParam();
+
+    AllocVector<SimplifiedCollider> colliders{ StandardAllocator<SimplifiedCollider>{TestHeapAllocator} };
+
+    for (std::size_t i = 0; i < colNbr; i++)
+    {
+        Math::Vec2F rndPos(Math::Random::Range(1.f, 7.f), Math::Random::Range(-1.f, -5.f));
+        colliders.push_back({ ColliderRef{i, 0}, RectangleF::FromCenter(rndPos, Vec2F(0.15f, 0.15f)) });
+    }
+
+    // Update twice to check that the nodes of the previous build are reused.
+    for (int step = 0; step < 2; step++)
+    {
+        sequentialQuadTree.Update(colliders);
+        parallelQuadTree.Update(colliders);
+
+        // The pairs are merged in a different order, so order them to compare the two lists.
+        const auto normalizePairs = [](const AllocVector<ColliderPair>& possiblePairs)
+        {
+            std::vector<ColliderPair> pairs;
+
+            for (const auto& pair : possiblePairs)
+            {
+                pairs.push_back(pair.ColliderB.Index < pair.ColliderA.Index ?
+                                ColliderPair{ pair.ColliderB, pair.ColliderA } : pair);
+            }
+
+            std::sort(pairs.begin(), pairs.end());
+
+            return pairs;
+        };
+
+        const auto sequentialPairs = normalizePairs(sequentialQuadTree.PossiblePairs());
+        const auto parallelPairs = normalizePairs(parallelQuadTree.PossiblePairs());
+
+        ASSERT_EQ(sequentialPairs.size(), parallelPairs.size());
+
+        for (std::size_t i = 0; i < sequentialPairs.size(); i++)
+        {
+            EXPECT_EQ(sequentialPairs[i].ColliderA, parallelPairs[i].ColliderA);
+            EXPECT_EQ(sequentialPairs[i].ColliderB, parallelPairs[i].ColliderB);
+        }
+
+        EXPECT_EQ(sequentialQuadTree.RootNode().Colliders.size(), parallelQuadTree.RootNode().Colliders.size());
+    }
+
+    jobSystem.Deinit();
+}
+
+void CheckLooseBoundaryRecursive(const QuadNode& node) noexcept
+{
+    if (node.Children[0] == nullptr) return;
+
+    for (const auto& child : node.Children)
+    {
+        for (const auto& simplCol : child->Colliders)
+        {
+            EXPECT_TRUE(child->LooseBoundary.Contains(simplCol.Rectangle));
+        }
+
+        CheckLooseBoundaryRecursive(*child);
+    }
+}
+
+TEST_P(ColliderNumberFixture, LooseUpdate)
+{
+    JobSystem jobSystem;
+    jobSystem.Init(3);
+
+    QuadTree sequentialQuadTree;
+    sequentialQuadTree.Init();
+    sequentialQuadTree.SetLooseness(2.f);
+
+    QuadTree parallelQuadTree;
+    parallelQuadTree.Init();
+    parallelQuadTree.SetLooseness(2.f);
+    parallelQuadTree.SetJobSystem(&jobSystem);
+
+    // Without margin, the persistent quad-tree must give the exact pairs of intersecting rectangles too.
+    QuadTree persistentQuadTree;
+    persistentQuadTree.Init();
+    persistentQuadTree.SetLooseness(2.f);
+    persistentQuadTree.SetPersistent(true);
+    persistentQuadTree.SetFatMargin(0.f);
+
+    const std::size_t colNbr = GetParam();
+
+    AllocVector<SimplifiedCollider> colliders{ StandardAllocator<SimplifiedCollider>{TestHeapAllocator} };
+    std::vector<RectangleF> rectangles;
+    std::vector<bool> enabled(colNbr, true);
+
+    for (std::size_t i = 0; i < colNbr; i++)
+    {
+        Math::Vec2F rndPos(Math::Random::Range(1.f, 7.f), Math::Random::Range(-1.f, -5.f));
+
+        // Some colliders are big enough to straddle the boundaries of the first levels.
+        const float halfSize = i % 10 == 0 ? Math::Random::Range(0.3f, 1.f) : 0.15f;
+
+        rectangles.push_back(RectangleF::FromCenter(rndPos, Vec2F(halfSize, halfSize)));
+        colliders.push_back({ ColliderRef{i, 0}, rectangles.back() });
+    }
+
+    for (int step = 0; step < 2; step++)
+    {
+        // A part of the colliders move, so the persistent quad-tree queries it with them.
+        for (std::size_t i = 0; step > 0 && i < colNbr; i += 3)
+        {
+            rectangles[i] = rectangles[i] + Vec2F(Math::Random::Range(-0.2f, 0.2f), Math::Random::Range(-0.2f, 0.2f));
+            colliders[i].Rectangle = rectangles[i];
+        }
+
+        sequentialQuadTree.Update(colliders);
+        parallelQuadTree.Update(colliders);
+        persistentQuadTree.Update(colliders);
+
+        CheckLooseBoundaryRecursive(sequentialQuadTree.RootNode());
+        CheckLooseBoundaryRecursive(parallelQuadTree.RootNode());
+        CheckLooseBoundaryRecursive(persistentQuadTree.RootNode());
+
+        auto expectedPairs = CalculatePairsBruteForce(rectangles, enabled);
+        std::sort(expectedPairs.begin(), expectedPairs.end());
+
+        for (const auto* quadTree : { &sequentialQuadTree, &parallelQuadTree, &persistentQuadTree })
+        {
+            // Order the colliders inside each pair and the pairs themselves to compare the two lists.
+            std::vector<ColliderPair> quadPossiblePairs;
+
+            for (const auto& pair : quadTree->PossiblePairs())
+            {
+                quadPossiblePairs.push_back(pair.ColliderB.Index < pair.ColliderA.Index ?
+                                            ColliderPair{ pair.ColliderB, pair.ColliderA } : pair);
+            }
+
+            std::sort(quadPossiblePairs.begin(), quadPossiblePairs.end());
+
+            ASSERT_EQ(quadPossiblePairs.size(), expectedPairs.size());
+
+            for (std::size_t i = 0; i < expectedPairs.size(); i++)
+            {
+                EXPECT_EQ(quadPossiblePairs[i].ColliderA, expectedPairs[i].ColliderA);
+                EXPECT_EQ(quadPossiblePairs[i].ColliderB, expectedPairs[i].ColliderB);
+            }
+        }
+
+        EXPECT_EQ(sequentialQuadTree.PairTestCount(), parallelQuadTree.PairTestCount());
+    }
+
+    jobSystem.Deinit();
+}
+
+TEST(QuadTree, LooseStraddlingColliderSinks)
+{
+    for (const auto looseness : { 1.f, 2.f })
+    {
+        QuadTree quadTree;
+        quadTree.Init();
+        quadTree.SetLooseness(looseness);
+        quadTree.SetRootNodeBoundary(RectangleF(Vec2F(0.f, 0.f), Vec2F(8.f, 8.f)));
+
+        // Enough small colliders in the corners to subdivide the root node.
+        for (std::size_t i = 0; i <= QuadNode::MaxColliderNbr; i++)
+        {
+            const auto corner = Vec2F(i % 2 == 0 ? 1.f : 7.f, i % 4 < 2 ? 1.f : 7.f);
+            quadTree.Insert(RectangleF::FromCenter(corner, Vec2F(0.1f, 0.1f)), ColliderRef{i, 0});
+        }
+
+        // A collider across the center of the root node.
+        const ColliderRef straddlingColRef{QuadNode::MaxColliderNbr + 1, 0};
+        quadTree.Insert(RectangleF::FromCenter(Vec2F(4.5f, 4.5f), Vec2F(1.f, 1.f)), straddlingColRef);
+
+        const auto& rootNode = quadTree.RootNode();
+        ASSERT_NE(rootNode.Children[0], nullptr);
+
+        const auto& topRightColliders = rootNode.Children[1]->Colliders;
+        const bool isInRoot = std::any_of(rootNode.Colliders.begin(), rootNode.Colliders.end(),
+                                          [straddlingColRef](const SimplifiedCollider& simplCol)
+                                          {
+                                              return simplCol.ColRef == straddlingColRef;
+                                          });
+        const bool isInTopRight = std::any_of(topRightColliders.begin(), topRightColliders.end(),
+                                              [straddlingColRef](const SimplifiedCollider& simplCol)
+                                              {
+                                                  return simplCol.ColRef == straddlingColRef;
+                                              });
+
+        // The tight quad-tree keeps it in the root node, the loose one puts it in the child of its center.
+        EXPECT_EQ(isInRoot, !quadTree.IsLoose());
+        EXPECT_EQ(isInTopRight, quadTree.IsLoose());
+    }
+}
+
+TEST(QuadTree, LooseReducesPairTests)
+{
+    QuadTree tightQuadTree;
+    tightQuadTree.Init();
+
+    QuadTree looseQuadTree;
+    looseQuadTree.Init();
+    looseQuadTree.SetLooseness(2.f);
+
+    AllocVector<SimplifiedCollider> colliders{ StandardAllocator<SimplifiedCollider>{TestHeapAllocator} };
+
+    // Small colliders spread over the world with larger ones on a regular grid, which straddles the boundaries
+    // of the nodes like walls or platforms do.
+    for (std::size_t i = 0; i < 2000; i++)
+    {
+        Math::Vec2F rndPos(Math::Random::Range(0.f, 64.f), Math::Random::Range(0.f, 64.f));
+        colliders.push_back({ ColliderRef{i, 0}, RectangleF::FromCenter(rndPos, Vec2F(0.1f, 0.1f)) });
+    }
+
+    for (std::size_t i = 0; i < 64; i++)
+    {
+        const Vec2F position(static_cast<float>(i % 8) * 8.f, static_cast<float>(i / 8) * 8.f);
+        colliders.push_back({ ColliderRef{2000 + i, 0}, RectangleF::FromCenter(position, Vec2F(1.f, 0.5f)) });
+    }
+
+    tightQuadTree.Update(colliders);
+    looseQuadTree.Update(colliders);
+
+    EXPECT_EQ(tightQuadTree.PossiblePairs().size(), looseQuadTree.PossiblePairs().size());
+    EXPECT_LT(looseQuadTree.PairTestCount(), tightQuadTree.PairTestCount());
+}
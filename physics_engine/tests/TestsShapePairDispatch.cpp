@@ -0,0 +1,175 @@
+#include "ShapePairDispatch.h"
+
+#include "gtest/gtest.h"
+
+#include <vector>
+
+using namespace Math;
+using namespace PhysicsEngine;
+
+struct ShapePairFixture : public ::testing::TestWithParam<std::pair<ColliderShape, ColliderShape>> {};
+
+INSTANTIATE_TEST_SUITE_P(ShapePairDispatch, ShapePairFixture, testing::Values(
+        std::pair{ColliderShape(CircleF(Vec2F::Zero(), 1.f)), ColliderShape(CircleF(Vec2F(1.f, 0.5f), 1.f))},
+        std::pair{ColliderShape(CircleF(Vec2F::Zero(), 1.f)), ColliderShape(CircleF(Vec2F(5.f, 0.f), 1.f))},
+        std::pair{ColliderShape(CircleF(Vec2F::Zero(), 1.f)),
+                  ColliderShape(RectangleF(Vec2F(0.5f, 0.5f), Vec2F(2.f, 3.f)))},
+        std::pair{ColliderShape(RectangleF(Vec2F::Zero(), Vec2F(1.f, 1.f))),
+                  ColliderShape(RectangleF(Vec2F(0.5f, 0.25f), Vec2F(2.f, 2.f)))},
+        std::pair{ColliderShape(RectangleF(Vec2F::Zero(), Vec2F(1.f, 1.f))),
+                  ColliderShape(CircleF(Vec2F(4.f, 4.f), 1.f))},
+        std::pair{ColliderShape(PolygonF({Vec2F::Zero(), Vec2F(2.f, 0.f), Vec2F(0.f, 2.f)})),
+                  ColliderShape(CircleF(Vec2F(0.5f, 0.5f), 1.f))}
+));
+
+static ShapeInstance InstanceOf(const ColliderShape& shape, Vec2F position, std::vector<Vec2F>& worldVertices)
+{
+    if (const auto* polygon = std::get_if<PolygonF>(&shape))
+    {
+        for (const auto& vertex : polygon->Vertices())
+        {
+            worldVertices.push_back(vertex + position);
+        }
+    }
+
+    return ShapeInstance{&shape, position, PolygonSpanF(worldVertices.data(), static_cast<int>(worldVertices.size()))};
+}
+
+TEST_P(ShapePairFixture, DetectOverlapIsSymmetric)
+{
+    auto [shapeA, shapeB] = GetParam();
+    std::vector<Vec2F> verticesA, verticesB;
+
+    const auto instanceA = InstanceOf(shapeA, Vec2F(0.25f, 0.f), verticesA);
+    const auto instanceB = InstanceOf(shapeB, Vec2F(0.25f, 0.f), verticesB);
+    const auto typeA = static_cast<ShapeType>(shapeA.index());
+    const auto typeB = static_cast<ShapeType>(shapeB.index());
+
+    EXPECT_EQ(DetectOverlap(typeA, instanceA, typeB, instanceB), DetectOverlap(typeB, instanceB, typeA, instanceA));
+    EXPECT_FALSE(DetectOverlap(ShapeType::None, instanceA, typeB, instanceB));
+}
+
+TEST_P(ShapePairFixture, CalculateManifoldIsSymmetric)
+{
+    auto [shapeA, shapeB] = GetParam();
+    std::vector<Vec2F> verticesA, verticesB;
+
+    const auto instanceA = InstanceOf(shapeA, Vec2F::Zero(), verticesA);
+    const auto instanceB = InstanceOf(shapeB, Vec2F::Zero(), verticesB);
+    const auto typeA = static_cast<ShapeType>(shapeA.index());
+    const auto typeB = static_cast<ShapeType>(shapeB.index());
+
+    const auto manifoldAB = CalculateManifold(typeA, instanceA, typeB, instanceB);
+    const auto manifoldBA = CalculateManifold(typeB, instanceB, typeA, instanceA);
+
+    EXPECT_EQ(manifoldAB.Normal, -manifoldBA.Normal);
+    EXPECT_FLOAT_EQ(manifoldAB.Penetration, manifoldBA.Penetration);
+
+    ASSERT_EQ(manifoldAB.PointCount, manifoldBA.PointCount);
+
+    for (int i = 0; i < manifoldAB.PointCount; i++)
+    {
+        EXPECT_NEAR(manifoldAB.Points[i].X, manifoldBA.Points[i].X, 0.0001f);
+        EXPECT_NEAR(manifoldAB.Points[i].Y, manifoldBA.Points[i].Y, 0.0001f);
+    }
+}
+
+TEST(ShapePairDispatch, CircleCircleManifold)
+{
+    const ColliderShape shapeA(CircleF(Vec2F::Zero(), 1.f));
+    const ColliderShape shapeB(CircleF(Vec2F::Zero(), 2.f));
+
+    const ShapeInstance instanceA{&shapeA, Vec2F(2.f, 0.f)};
+    const ShapeInstance instanceB{&shapeB, Vec2F::Zero()};
+
+    const auto manifold = CalculateManifold(ShapeType::Circle, instanceA, ShapeType::Circle, instanceB);
+
+    EXPECT_EQ(manifold.Normal, Vec2F(1.f, 0.f));
+    ASSERT_EQ(manifold.PointCount, 1);
+    EXPECT_EQ(manifold.Points[0], Vec2F(1.5f, 0.f));
+    EXPECT_FLOAT_EQ(manifold.Penetration, 1.f);
+}
+
+TEST(ShapePairDispatch, ConcentricCirclesManifold)
+{
+    const ColliderShape shapeA(CircleF(Vec2F::Zero(), 1.f));
+    const ColliderShape shapeB(CircleF(Vec2F::Zero(), 2.f));
+
+    const ShapeInstance instanceA{&shapeA, Vec2F(2.f, 3.f)};
+    const ShapeInstance instanceB{&shapeB, Vec2F(2.f, 3.f)};
+
+    const auto manifold = CalculateManifold(ShapeType::Circle, instanceA, ShapeType::Circle, instanceB);
+
+    EXPECT_EQ(manifold.Normal, Vec2F(0.f, 1.f));
+    ASSERT_EQ(manifold.PointCount, 1);
+    EXPECT_FLOAT_EQ(manifold.Penetration, 3.f);
+}
+
+TEST(ShapePairDispatch, RectangleRectangleManifold)
+{
+    const ColliderShape shapeA(RectangleF(Vec2F::Zero(), Vec2F(1.f, 1.f)));
+    const ColliderShape shapeB(RectangleF(Vec2F::Zero(), Vec2F(4.f, 1.f)));
+
+    const ShapeInstance instanceA{&shapeA, Vec2F(1.f, 0.9f)};
+    const ShapeInstance instanceB{&shapeB, Vec2F::Zero()};
+
+    const auto manifold = CalculateManifold(ShapeType::Rectangle, instanceA, ShapeType::Rectangle, instanceB);
+
+    // The box A lies on the box B, the points are at the two bottom corners of A.
+    EXPECT_EQ(manifold.Normal, Vec2F(0.f, 1.f));
+    EXPECT_NEAR(manifold.Penetration, 0.1f, 0.0001f);
+    ASSERT_EQ(manifold.PointCount, 2);
+    EXPECT_NEAR(manifold.Points[0].X, 1.f, 0.0001f);
+    EXPECT_NEAR(manifold.Points[1].X, 2.f, 0.0001f);
+    EXPECT_NEAR(manifold.Points[0].Y, 0.95f, 0.0001f);
+    EXPECT_NEAR(manifold.Points[1].Y, 0.95f, 0.0001f);
+}
+
+TEST(ShapePairDispatch, PolygonCircleManifold)
+{
+    const ColliderShape shapeA(PolygonF({Vec2F::Zero(), Vec2F(2.f, 0.f), Vec2F(0.f, 2.f)}));
+    const ColliderShape shapeB(CircleF(Vec2F::Zero(), 1.f));
+    std::vector<Vec2F> verticesA, verticesB;
+
+    const auto instanceA = InstanceOf(shapeA, Vec2F::Zero(), verticesA);
+    const auto instanceB = InstanceOf(shapeB, Vec2F(0.5f, -0.75f), verticesB);
+
+    const auto manifold = CalculateManifold(ShapeType::Polygon, instanceA, ShapeType::Circle, instanceB);
+
+    // The circle goes 0.25 under the bottom edge of the triangle, the normal goes from the circle to the triangle.
+    EXPECT_NEAR(manifold.Normal.X, 0.f, 0.001f);
+    EXPECT_NEAR(manifold.Normal.Y, 1.f, 0.001f);
+    EXPECT_NEAR(manifold.Penetration, 0.25f, 0.001f);
+}
+
+TEST(ShapePairDispatch, PolygonCachedData)
+{
+    const PolygonF polygon({ Vec2F(0.f, 0.f), Vec2F(2.f, 0.f), Vec2F(2.f, 1.f), Vec2F(0.f, 3.f) });
+
+    EXPECT_EQ(polygon.EdgeNormals().size(), 4);
+    EXPECT_EQ(polygon.EdgeNormals()[1], Vec2F(0.f, 2.f));
+    EXPECT_EQ(polygon.Bounds().MinBound(), Vec2F(0.f, 0.f));
+    EXPECT_EQ(polygon.Bounds().MaxBound(), Vec2F(2.f, 3.f));
+    EXPECT_FLOAT_EQ(polygon.BoundingRadius(), Vec2F(1.f, 1.5f).Length());
+
+    const PolygonF other({ Vec2F(-0.5f, -0.5f), Vec2F(0.5f, -0.5f), Vec2F(0.f, 0.5f) });
+
+    // The cached normals and the bounding circles must not change the result of the intersection tests.
+    for (int i = 0; i < 16; i++)
+    {
+        const Vec2F offset(static_cast<float>(i % 4) * 1.1f - 1.f, static_cast<float>(i / 4) * 1.1f - 1.f);
+        const auto movedOther = other + offset;
+
+        const PolygonSpanF cachedSpan(polygon), cachedOtherSpan(movedOther);
+        const PolygonSpanF span(polygon.Vertices().data(), polygon.VerticesCount());
+        const PolygonSpanF otherSpan(movedOther.Vertices().data(), movedOther.VerticesCount());
+
+        EXPECT_EQ(Intersect(cachedSpan, cachedOtherSpan), Intersect(span, otherSpan));
+
+        const CircleF circle(offset, 0.4f);
+        EXPECT_EQ(Intersect(cachedSpan, circle), Intersect(span, circle));
+
+        const auto rectangle = RectangleF::FromCenter(offset, Vec2F(0.3f, 0.2f));
+        EXPECT_EQ(Intersect(cachedSpan, rectangle), Intersect(span, rectangle));
+    }
+}
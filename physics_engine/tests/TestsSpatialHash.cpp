@@ -0,0 +1,128 @@
+#include "SpatialHash.h"
+
+#include "gtest/gtest.h"
+#include "Random.h"
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+using namespace PhysicsEngine;
+using namespace Math;
+
+static HeapAllocator TestHeapAllocator;
+
+struct SpatialHashColliderNumberFixture : public ::testing::TestWithParam<int> {};
+
+INSTANTIATE_TEST_SUITE_P(SpatialHash, SpatialHashColliderNumberFixture, testing::Values(0, 1, 2, 10, 100, 321, 2000));
+
+TEST(SpatialHash, DefaultConstructor)
+{
+    SpatialHash spatialHash;
+
+    EXPECT_EQ(spatialHash.PossiblePairs().size(), 0);
+    EXPECT_EQ(spatialHash.UsedCellCount(), 0);
+    EXPECT_FLOAT_EQ(spatialHash.CellSize(), 1.f);
+}
+
+TEST(SpatialHash, SetCellSizeIgnoresInvalidSizes)
+{
+    SpatialHash spatialHash;
+    spatialHash.SetCellSize(2.f);
+
+    for (const float cellSize : { 0.f, -1.f, std::numeric_limits<float>::quiet_NaN(),
+                                  std::numeric_limits<float>::infinity() })
+    {
+        spatialHash.SetCellSize(cellSize);
+        EXPECT_FLOAT_EQ(spatialHash.CellSize(), 2.f);
+    }
+}
+
+TEST_P(SpatialHashColliderNumberFixture, Update)
+{
+    SpatialHash spatialHash;
+    spatialHash.Init();
+    spatialHash.SetCellSize(0.5f);
+
+    const std::size_t colNbr = GetParam();
+
+    AllocVector<SimplifiedCollider> simplifiedColliders{ StandardAllocator<SimplifiedCollider>{TestHeapAllocator} };
+
+    for (std::size_t i = 0; i < colNbr; i++)
+    {
+        Vec2F rndPos(Random::Range(-20.f, 20.f), Random::Range(-20.f, 20.f));
+
+        // Some colliders are bigger than the cells to be in several cells.
+        const float maxHalfSize = i % 10 == 0 ? 1.5f : 0.25f;
+        Vec2F rndHalfSize(Random::Range(0.05f, maxHalfSize), Random::Range(0.05f, maxHalfSize));
+
+        simplifiedColliders.push_back({ ColliderRef{i, 0}, RectangleF::FromCenter(rndPos, rndHalfSize) });
+    }
+
+    for (int step = 0; step < 3; step++)
+    {
+        for (auto& simplCol : simplifiedColliders)
+        {
+            simplCol.Rectangle = simplCol.Rectangle + Vec2F(Random::Range(-1.f, 1.f), Random::Range(-1.f, 1.f));
+        }
+
+        spatialHash.Update(simplifiedColliders);
+
+        std::vector<ColliderPair> expectedPairs;
+
+        for (std::size_t i = 0; i < simplifiedColliders.size(); i++)
+        {
+            for (std::size_t j = i + 1; j < simplifiedColliders.size(); j++)
+            {
+                if (Intersect(simplifiedColliders[i].Rectangle, simplifiedColliders[j].Rectangle))
+                {
+                    expectedPairs.push_back(ColliderPair{ simplifiedColliders[i].ColRef,
+                                                          simplifiedColliders[j].ColRef });
+                }
+            }
+        }
+
+        // Order the colliders inside each pair and the pairs themselves to compare the lists.
+        std::vector<ColliderPair> possiblePairs;
+
+        for (const auto& pair : spatialHash.PossiblePairs())
+        {
+            if (pair.ColliderB.Index < pair.ColliderA.Index)
+            {
+                possiblePairs.push_back(ColliderPair{ pair.ColliderB, pair.ColliderA });
+            }
+            else
+            {
+                possiblePairs.push_back(pair);
+            }
+        }
+
+        std::sort(possiblePairs.begin(), possiblePairs.end());
+        std::sort(expectedPairs.begin(), expectedPairs.end());
+
+        ASSERT_EQ(possiblePairs.size(), expectedPairs.size());
+
+        for (std::size_t i = 0; i < expectedPairs.size(); i++)
+        {
+            EXPECT_EQ(possiblePairs[i].ColliderA, expectedPairs[i].ColliderA);
+            EXPECT_EQ(possiblePairs[i].ColliderB, expectedPairs[i].ColliderB);
+        }
+    }
+}
+
+TEST(SpatialHash, PairInSeveralCellsAddedOnce)
+{
+    SpatialHash spatialHash;
+    spatialHash.Init();
+    spatialHash.SetCellSize(1.f);
+
+    AllocVector<SimplifiedCollider> simplifiedColliders{ StandardAllocator<SimplifiedCollider>{TestHeapAllocator} };
+    simplifiedColliders.push_back({ ColliderRef{0, 0}, RectangleF(Vec2F(-2.5f, -2.5f), Vec2F(2.5f, 2.5f)) });
+    simplifiedColliders.push_back({ ColliderRef{1, 0}, RectangleF(Vec2F(-1.5f, -1.5f), Vec2F(1.5f, 1.5f)) });
+
+    spatialHash.Update(simplifiedColliders);
+
+    EXPECT_EQ(spatialHash.UsedCellCount(), 36);
+    ASSERT_EQ(spatialHash.PossiblePairs().size(), 1);
+    EXPECT_EQ(spatialHash.PossiblePairs()[0], (ColliderPair{ColliderRef{0, 0}, ColliderRef{1, 0}}));
+}
@@ -0,0 +1,174 @@
+#include "SweepAndPrune.h"
+
+#include "gtest/gtest.h"
+#include "Random.h"
+
+#include <algorithm>
+#include <vector>
+
+using namespace PhysicsEngine;
+using namespace Math;
+
+static HeapAllocator TestHeapAllocator;
+
+struct SweepAndPruneColliderNumberFixture : public ::testing::TestWithParam<int> {};
+
+INSTANTIATE_TEST_SUITE_P(SweepAndPrune, SweepAndPruneColliderNumberFixture,
+                         testing::Values(0, 1, 2, 10, 100, 321, 2000));
+
+TEST(SweepAndPrune, DefaultConstructor)
+{
+    SweepAndPrune sweepAndPrune;
+
+    EXPECT_EQ(sweepAndPrune.PossiblePairs().size(), 0);
+    EXPECT_EQ(sweepAndPrune.EndpointsX().size(), 0);
+    EXPECT_EQ(sweepAndPrune.EndpointsY().size(), 0);
+}
+
+void CheckSorted(const AllocVector<SapEndpoint>& endpoints)
+{
+    for (std::size_t i = 1; i < endpoints.size(); i++)
+    {
+        EXPECT_LE(endpoints[i - 1].Value, endpoints[i].Value);
+    }
+}
+
+TEST_P(SweepAndPruneColliderNumberFixture, Update)
+{
+    SweepAndPrune sweepAndPrune;
+    sweepAndPrune.Init();
+
+    const std::size_t colNbr = GetParam();
+
+    std::vector<RectangleF> rectangles;
+    std::vector<bool> enabled(colNbr, true);
+
+    for (std::size_t i = 0; i < colNbr; i++)
+    {
+        Vec2F rndPos(Random::Range(-20.f, 20.f), Random::Range(-2.f, 2.f));
+        Vec2F rndHalfSize(Random::Range(0.05f, 0.5f), Random::Range(0.05f, 0.5f));
+        rectangles.push_back(RectangleF::FromCenter(rndPos, rndHalfSize));
+    }
+
+    AllocVector<SimplifiedCollider> simplifiedColliders{ StandardAllocator<SimplifiedCollider>{TestHeapAllocator} };
+
+    for (int step = 0; step < 5; step++)
+    {
+        simplifiedColliders.clear();
+
+        for (std::size_t i = 0; i < colNbr; i++)
+        {
+            if (step > 0)
+            {
+                rectangles[i] = rectangles[i] + Vec2F(Random::Range(-0.5f, 0.5f), Random::Range(-0.5f, 0.5f));
+            }
+
+            // Some colliders are removed and added back.
+            if (step > 0 && i % 7 == static_cast<std::size_t>(step))
+            {
+                enabled[i] = !enabled[i];
+            }
+
+            if (enabled[i])
+            {
+                simplifiedColliders.push_back({ ColliderRef{i, 0}, rectangles[i] });
+            }
+        }
+
+        sweepAndPrune.Update(simplifiedColliders);
+
+        EXPECT_EQ(sweepAndPrune.EndpointsX().size(), 2 * simplifiedColliders.size());
+        EXPECT_EQ(sweepAndPrune.EndpointsY().size(), 2 * simplifiedColliders.size());
+        CheckSorted(sweepAndPrune.SweepAxis() == 0 ? sweepAndPrune.EndpointsX() : sweepAndPrune.EndpointsY());
+
+        std::vector<ColliderPair> expectedPairs;
+
+        for (std::size_t i = 0; i < simplifiedColliders.size(); i++)
+        {
+            for (std::size_t j = i + 1; j < simplifiedColliders.size(); j++)
+            {
+                if (Intersect(simplifiedColliders[i].Rectangle, simplifiedColliders[j].Rectangle))
+                {
+                    expectedPairs.push_back(ColliderPair{ simplifiedColliders[i].ColRef,
+                                                          simplifiedColliders[j].ColRef });
+                }
+            }
+        }
+
+        // Order the colliders inside each pair and the pairs themselves to compare the lists.
+        std::vector<ColliderPair> possiblePairs;
+
+        for (const auto& pair : sweepAndPrune.PossiblePairs())
+        {
+            if (pair.ColliderB.Index < pair.ColliderA.Index)
+            {
+                possiblePairs.push_back(ColliderPair{ pair.ColliderB, pair.ColliderA });
+            }
+            else
+            {
+                possiblePairs.push_back(pair);
+            }
+        }
+
+        std::sort(possiblePairs.begin(), possiblePairs.end());
+        std::sort(expectedPairs.begin(), expectedPairs.end());
+
+        ASSERT_EQ(possiblePairs.size(), expectedPairs.size());
+
+        for (std::size_t i = 0; i < expectedPairs.size(); i++)
+        {
+            EXPECT_EQ(possiblePairs[i].ColliderA, expectedPairs[i].ColliderA);
+            EXPECT_EQ(possiblePairs[i].ColliderB, expectedPairs[i].ColliderB);
+        }
+    }
+}
+
+TEST(SweepAndPrune, TouchingCollidersOverlap)
+{
+    SweepAndPrune sweepAndPrune;
+    sweepAndPrune.Init();
+
+    AllocVector<SimplifiedCollider> simplifiedColliders{ StandardAllocator<SimplifiedCollider>{TestHeapAllocator} };
+    simplifiedColliders.push_back({ ColliderRef{0, 0}, RectangleF(Vec2F(0.f, 0.f), Vec2F(1.f, 1.f)) });
+    simplifiedColliders.push_back({ ColliderRef{1, 0}, RectangleF(Vec2F(1.f, 0.f), Vec2F(2.f, 1.f)) });
+
+    sweepAndPrune.Update(simplifiedColliders);
+
+    ASSERT_EQ(sweepAndPrune.PossiblePairs().size(), 1);
+    EXPECT_EQ(sweepAndPrune.PossiblePairs()[0], (ColliderPair{ColliderRef{0, 0}, ColliderRef{1, 0}}));
+}
+
+TEST(SweepAndPrune, SweepAxisFollowsSpread)
+{
+    SweepAndPrune sweepAndPrune;
+    sweepAndPrune.Init();
+
+    AllocVector<SimplifiedCollider> simplifiedColliders{ StandardAllocator<SimplifiedCollider>{TestHeapAllocator} };
+
+    // The colliders are spread on the x-axis, only the first two touch.
+    for (std::size_t i = 0; i < 3; i++)
+    {
+        const auto center = Vec2F(static_cast<float>(i) * (i < 2 ? 1.5f : 3.f), 0.f);
+        simplifiedColliders.push_back({ ColliderRef{i, 0}, RectangleF::FromCenter(center, Vec2F(1.f, 1.f)) });
+    }
+
+    sweepAndPrune.Update(simplifiedColliders);
+
+    EXPECT_EQ(sweepAndPrune.SweepAxis(), 0);
+    CheckSorted(sweepAndPrune.EndpointsX());
+    ASSERT_EQ(sweepAndPrune.PossiblePairs().size(), 1);
+
+    // The same colliders spread on the y-axis, the endpoints of the y-axis are sorted from their first order.
+    for (auto& simplCol : simplifiedColliders)
+    {
+        const auto center = simplCol.Rectangle.Center();
+        simplCol.Rectangle = RectangleF::FromCenter(Vec2F(center.Y, center.X), Vec2F(1.f, 1.f));
+    }
+
+    sweepAndPrune.Update(simplifiedColliders);
+
+    EXPECT_EQ(sweepAndPrune.SweepAxis(), 1);
+    CheckSorted(sweepAndPrune.EndpointsY());
+    ASSERT_EQ(sweepAndPrune.PossiblePairs().size(), 1);
+    EXPECT_EQ(sweepAndPrune.PossiblePairs()[0], (ColliderPair{ColliderRef{0, 0}, ColliderRef{1, 0}}));
+}
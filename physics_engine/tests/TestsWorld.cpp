@@ -4,10 +4,14 @@
 #include "../../common/include/Metrics.h"
 
 #include <array>
+#include <cmath>
+#include <vector>
 
 using namespace PhysicsEngine;
 using namespace Math;
 
+static HeapAllocator TestHeapAllocator;
+
 struct IntFixture : public ::testing::TestWithParam<int>{};
 
 struct ArrayOfBody : public ::testing::TestWithParam<std::array<Body, 3>>{};
@@ -125,6 +129,65 @@ TEST(World, CreateAndDestroyBody)
     EXPECT_THROW(nullBodyRef =  world.GetBody(bodyRef2), std::runtime_error);
 }
 
+TEST(World, CreateBodiesAndColliders)
+{
+    World world;
+    world.Init(Math::Vec2F::Zero(), 4);
+
+    AllocVector<BodyRef> bodyRefs{ StandardAllocator<BodyRef>{TestHeapAllocator} };
+    world.CreateBodies(10, bodyRefs);
+
+    ASSERT_EQ(bodyRefs.size(), 10);
+    EXPECT_GE(world.GetBodyCount(), 10);
+
+    for (std::size_t i = 0; i < bodyRefs.size(); i++)
+    {
+        EXPECT_EQ(bodyRefs[i].Index, i);
+        EXPECT_EQ(bodyRefs[i].GenerationIdx, 0);
+        EXPECT_TRUE(world.GetBody(bodyRefs[i]).IsValid());
+    }
+
+    AllocVector<ColliderRef> colliderRefs{ StandardAllocator<ColliderRef>{TestHeapAllocator} };
+    world.CreateColliders(bodyRefs, colliderRefs);
+
+    ASSERT_EQ(colliderRefs.size(), bodyRefs.size());
+
+    for (std::size_t i = 0; i < colliderRefs.size(); i++)
+    {
+        EXPECT_EQ(colliderRefs[i].Index, i);
+        EXPECT_TRUE(world.GetCollider(colliderRefs[i]).Enabled());
+        EXPECT_EQ(world.GetCollider(colliderRefs[i]).GetBodyRef(), bodyRefs[i]);
+    }
+
+    // The destroyed slots are reused first, and destroying twice does not give the slot twice.
+    world.DestroyBody(bodyRefs[3]);
+    world.DestroyBody(bodyRefs[3]);
+    world.DestroyCollider(colliderRefs[5]);
+    world.DestroyCollider(colliderRefs[5]);
+
+    const auto newBodyRef = world.CreateBody();
+    const auto newColliderRef = world.CreateCollider(newBodyRef);
+
+    EXPECT_EQ(newBodyRef.Index, 3);
+    EXPECT_EQ(newBodyRef.GenerationIdx, 1);
+    EXPECT_EQ(newColliderRef.Index, 5);
+    EXPECT_EQ(newColliderRef.GenerationIdx, 1);
+
+    EXPECT_EQ(world.CreateBody().Index, 10);
+    EXPECT_EQ(world.CreateCollider(newBodyRef).Index, 10);
+}
+
+TEST(World, CreateBodyWithoutPreallocation)
+{
+    World world;
+    world.Init(Math::Vec2F::Zero(), 0);
+
+    const auto bodyRef = world.CreateBody();
+
+    EXPECT_EQ(bodyRef.Index, 0);
+    EXPECT_TRUE(world.GetBody(bodyRef).IsValid());
+}
+
 TEST_P(ArrayOfBody, Update)
 {
     auto bodies = GetParam();
@@ -587,4 +650,1023 @@ TEST(World, UpdateCollisionDetectionPolygonAndRect)
     EXPECT_FALSE(testContactListener.Enter);
     EXPECT_FALSE(testContactListener.Stay);
     EXPECT_TRUE(testContactListener.Exit);
-}
\ No newline at end of file
+}
+TEST(World, UpdateCollisionDetectionPersistentBroadPhase)
+{
+    World world;
+    world.Init(Math::Vec2F::Zero(), 2);
+    world.SetBroadPhasePersistent(true);
+
+    EXPECT_TRUE(world.IsBroadPhasePersistent());
+
+    TestContactListener testContactListener;
+    world.SetContactListener(&testContactListener);
+
+    auto bodyRef = world.CreateBody();
+    world.GetBody(bodyRef) = Body(Vec2F::Zero(), Vec2F::Zero(), 1);
+
+    auto c1ColRef = world.CreateCollider(bodyRef);
+    auto& collider = world.GetCollider(c1ColRef);
+    collider.SetIsTrigger(true);
+    collider.SetShape(CircleF(Vec2F::Zero(), 0.5f));
+
+    auto bodyRef2 = world.CreateBody();
+    world.GetBody(bodyRef2) = Body(Vec2F(0.03f, 0.03f), Vec2F::Zero(), 1);
+
+    auto c2ColRef = world.CreateCollider(bodyRef2);
+    auto& collider2 = world.GetCollider(c2ColRef);
+    collider2.SetIsTrigger(true);
+    collider2.SetShape(CircleF(Vec2F::Zero(), 0.2f));
+
+    // First Update, circle collide :
+    world.Update(0.1f);
+
+    EXPECT_TRUE(testContactListener.Enter);
+    EXPECT_FALSE(testContactListener.Stay);
+    EXPECT_FALSE(testContactListener.Exit);
+
+    // Second Update, circle always collide :
+    world.Update(0.1f);
+
+    EXPECT_FALSE(testContactListener.Enter);
+    EXPECT_TRUE(testContactListener.Stay);
+    EXPECT_FALSE(testContactListener.Exit);
+
+    // Third Update, circle stop collide (the circle leaves the quad-tree root) :
+    world.GetBody(bodyRef).SetPosition(Math::Vec2F(10.f, 10.f));
+
+    world.Update(0.1f);
+
+    EXPECT_FALSE(testContactListener.Enter);
+    EXPECT_FALSE(testContactListener.Stay);
+    EXPECT_TRUE(testContactListener.Exit);
+
+    // Fourth Update, circle collide again :
+    world.GetBody(bodyRef).SetPosition(Math::Vec2F(0.1f, 0.1f));
+
+    world.Update(0.1f);
+
+    EXPECT_TRUE(testContactListener.Enter);
+    EXPECT_FALSE(testContactListener.Stay);
+    EXPECT_FALSE(testContactListener.Exit);
+}
+
+TEST(World, UpdateCollisionDetectionAabbTree)
+{
+    World world;
+    world.Init(Math::Vec2F::Zero(), 2);
+    world.SetBroadPhaseType(BroadPhaseType::AabbTree);
+
+    EXPECT_EQ(world.GetBroadPhaseType(), BroadPhaseType::AabbTree);
+
+    TestContactListener testContactListener;
+    world.SetContactListener(&testContactListener);
+
+    auto bodyRef = world.CreateBody();
+    world.GetBody(bodyRef) = Body(Vec2F::Zero(), Vec2F::Zero(), 1);
+
+    auto rect1ColRef = world.CreateCollider(bodyRef);
+    auto& collider = world.GetCollider(rect1ColRef);
+    collider.SetIsTrigger(true);
+    collider.SetShape(RectangleF(Vec2F(-0.5f, -0.5f), Vec2F(0.5f, 0.5f)));
+
+    auto bodyRef2 = world.CreateBody();
+    world.GetBody(bodyRef2) = Body(Vec2F(0.5f, 0.5f), Vec2F::Zero(), 1);
+
+    auto circleColRef = world.CreateCollider(bodyRef2);
+    auto& collider2 = world.GetCollider(circleColRef);
+    collider2.SetIsTrigger(true);
+    collider2.SetShape(CircleF(Vec2F::Zero(), 0.2f));
+
+    // First Update, shapes collide :
+    world.Update(0.1f);
+
+    EXPECT_TRUE(testContactListener.Enter);
+    EXPECT_FALSE(testContactListener.Stay);
+    EXPECT_FALSE(testContactListener.Exit);
+
+    // Second Update, shapes always collide :
+    world.Update(0.1f);
+
+    EXPECT_FALSE(testContactListener.Enter);
+    EXPECT_TRUE(testContactListener.Stay);
+    EXPECT_FALSE(testContactListener.Exit);
+
+    // Third Update, shapes stop collide :
+    world.GetBody(bodyRef).SetPosition(Math::Vec2F(10.f, 10.f));
+
+    world.Update(0.1f);
+
+    EXPECT_FALSE(testContactListener.Enter);
+    EXPECT_FALSE(testContactListener.Stay);
+    EXPECT_TRUE(testContactListener.Exit);
+
+    // Fourth Update, the collider is disabled so nothing happens :
+    world.GetBody(bodyRef).SetPosition(Math::Vec2F::Zero());
+    world.GetCollider(rect1ColRef).SetEnabled(false);
+    testContactListener.Exit = false;
+
+    world.Update(0.1f);
+
+    EXPECT_FALSE(testContactListener.Enter);
+    EXPECT_FALSE(testContactListener.Stay);
+    EXPECT_FALSE(testContactListener.Exit);
+}
+
+TEST(World, UpdateCollisionDetectionSweepAndPrune)
+{
+    World world;
+    world.Init(Math::Vec2F::Zero(), 2);
+    world.SetBroadPhaseType(BroadPhaseType::SweepAndPrune);
+
+    EXPECT_EQ(world.GetBroadPhaseType(), BroadPhaseType::SweepAndPrune);
+
+    TestContactListener testContactListener;
+    world.SetContactListener(&testContactListener);
+
+    auto bodyRef = world.CreateBody();
+    world.GetBody(bodyRef) = Body(Vec2F::Zero(), Vec2F::Zero(), 1);
+
+    auto c1ColRef = world.CreateCollider(bodyRef);
+    auto& collider = world.GetCollider(c1ColRef);
+    collider.SetIsTrigger(true);
+    collider.SetShape(CircleF(Vec2F::Zero(), 0.5f));
+
+    auto bodyRef2 = world.CreateBody();
+    world.GetBody(bodyRef2) = Body(Vec2F(0.6f, 0.f), Vec2F::Zero(), 1);
+
+    auto c2ColRef = world.CreateCollider(bodyRef2);
+    auto& collider2 = world.GetCollider(c2ColRef);
+    collider2.SetIsTrigger(true);
+    collider2.SetShape(CircleF(Vec2F::Zero(), 0.2f));
+
+    // First Update, circle collide :
+    world.Update(0.1f);
+
+    EXPECT_TRUE(testContactListener.Enter);
+    EXPECT_FALSE(testContactListener.Stay);
+    EXPECT_FALSE(testContactListener.Exit);
+
+    // Second Update, circle always collide :
+    world.Update(0.1f);
+
+    EXPECT_FALSE(testContactListener.Enter);
+    EXPECT_TRUE(testContactListener.Stay);
+    EXPECT_FALSE(testContactListener.Exit);
+
+    // Third Update, the circles swap their order on the x-axis and stop collide :
+    world.GetBody(bodyRef).SetPosition(Math::Vec2F(10.f, 0.f));
+
+    world.Update(0.1f);
+
+    EXPECT_FALSE(testContactListener.Enter);
+    EXPECT_FALSE(testContactListener.Stay);
+    EXPECT_TRUE(testContactListener.Exit);
+}
+
+TEST(World, UpdateCollisionDetectionSpatialHash)
+{
+    World world;
+    world.Init(Math::Vec2F::Zero(), 2);
+    world.SetBroadPhaseType(BroadPhaseType::SpatialHash);
+    world.SetSpatialHashCellSize(0.5f);
+
+    EXPECT_EQ(world.GetBroadPhaseType(), BroadPhaseType::SpatialHash);
+
+    TestContactListener testContactListener;
+    world.SetContactListener(&testContactListener);
+
+    auto bodyRef = world.CreateBody();
+    world.GetBody(bodyRef) = Body(Vec2F::Zero(), Vec2F::Zero(), 1);
+
+    auto rect1ColRef = world.CreateCollider(bodyRef);
+    auto& collider = world.GetCollider(rect1ColRef);
+    collider.SetIsTrigger(true);
+    collider.SetShape(RectangleF(Vec2F(-1.f, -1.f), Vec2F(1.f, 1.f)));
+
+    auto bodyRef2 = world.CreateBody();
+    world.GetBody(bodyRef2) = Body(Vec2F(0.9f, 0.9f), Vec2F::Zero(), 1);
+
+    auto rect2ColRef = world.CreateCollider(bodyRef2);
+    auto& collider2 = world.GetCollider(rect2ColRef);
+    collider2.SetIsTrigger(true);
+    collider2.SetShape(RectangleF(Vec2F(-0.2f, -0.2f), Vec2F(0.2f, 0.2f)));
+
+    // First Update, rectangles collide in several cells :
+    world.Update(0.1f);
+
+    EXPECT_TRUE(testContactListener.Enter);
+    EXPECT_FALSE(testContactListener.Stay);
+    EXPECT_FALSE(testContactListener.Exit);
+
+    // Second Update, rectangles always collide :
+    world.Update(0.1f);
+
+    EXPECT_FALSE(testContactListener.Enter);
+    EXPECT_TRUE(testContactListener.Stay);
+    EXPECT_FALSE(testContactListener.Exit);
+
+    // Third Update, rectangles stop collide :
+    world.GetBody(bodyRef).SetPosition(Math::Vec2F(-10.f, -10.f));
+
+    world.Update(0.1f);
+
+    EXPECT_FALSE(testContactListener.Enter);
+    EXPECT_FALSE(testContactListener.Stay);
+    EXPECT_TRUE(testContactListener.Exit);
+}
+
+TEST(World, UpdateCollisionDetectionLinearQuadTree)
+{
+    World world;
+    world.Init(Math::Vec2F::Zero(), 2);
+    world.SetBroadPhaseType(BroadPhaseType::LinearQuadTree);
+
+    EXPECT_EQ(world.GetBroadPhaseType(), BroadPhaseType::LinearQuadTree);
+
+    TestContactListener testContactListener;
+    world.SetContactListener(&testContactListener);
+
+    auto bodyRef = world.CreateBody();
+    world.GetBody(bodyRef) = Body(Vec2F::Zero(), Vec2F::Zero(), 1);
+
+    auto rect1ColRef = world.CreateCollider(bodyRef);
+    auto& collider = world.GetCollider(rect1ColRef);
+    collider.SetIsTrigger(true);
+    collider.SetShape(RectangleF(Vec2F(-1.f, -1.f), Vec2F(1.f, 1.f)));
+
+    auto bodyRef2 = world.CreateBody();
+    world.GetBody(bodyRef2) = Body(Vec2F(0.9f, 0.9f), Vec2F::Zero(), 1);
+
+    auto rect2ColRef = world.CreateCollider(bodyRef2);
+    auto& collider2 = world.GetCollider(rect2ColRef);
+    collider2.SetIsTrigger(true);
+    collider2.SetShape(RectangleF(Vec2F(-0.2f, -0.2f), Vec2F(0.2f, 0.2f)));
+
+    // First Update, rectangles collide :
+    world.Update(0.1f);
+
+    EXPECT_TRUE(testContactListener.Enter);
+    EXPECT_FALSE(testContactListener.Stay);
+    EXPECT_FALSE(testContactListener.Exit);
+
+    // Second Update, rectangles always collide :
+    world.Update(0.1f);
+
+    EXPECT_FALSE(testContactListener.Enter);
+    EXPECT_TRUE(testContactListener.Stay);
+    EXPECT_FALSE(testContactListener.Exit);
+
+    // Third Update, rectangles stop collide :
+    world.GetBody(bodyRef).SetPosition(Math::Vec2F(-10.f, -10.f));
+
+    world.Update(0.1f);
+
+    EXPECT_FALSE(testContactListener.Enter);
+    EXPECT_FALSE(testContactListener.Stay);
+    EXPECT_TRUE(testContactListener.Exit);
+}
+
+class RecordingContactListener : public ContactListener
+{
+public:
+    std::vector<std::pair<int, ColliderPair>> Events;
+
+    void OnTriggerEnter(ColliderRef colliderRefA, ColliderRef colliderRefB) noexcept override
+    {
+        Events.push_back({ 0, ColliderPair{ colliderRefA, colliderRefB } });
+    }
+
+    void OnTriggerStay(ColliderRef colliderRefA, ColliderRef colliderRefB) noexcept override
+    {
+        Events.push_back({ 1, ColliderPair{ colliderRefA, colliderRefB } });
+    }
+
+    void OnTriggerExit(ColliderRef colliderRefA, ColliderRef colliderRefB) noexcept override
+    {
+        Events.push_back({ 2, ColliderPair{ colliderRefA, colliderRefB } });
+    }
+
+    void OnCollisionEnter(ColliderRef colliderRefA, ColliderRef colliderRefB) noexcept override {}
+    void OnCollisionExit(ColliderRef colliderRefA, ColliderRef colliderRefB) noexcept override {}
+};
+
+/**
+ * @brief FillCircleGrid creates a grid of trigger circles that overlap their neighbours.
+ */
+static void FillCircleGrid(World& world, const int sideCount) noexcept
+{
+    for (int y = 0; y < sideCount; y++)
+    {
+        for (int x = 0; x < sideCount; x++)
+        {
+            auto bodyRef = world.CreateBody();
+            world.GetBody(bodyRef) = Body(Vec2F(static_cast<float>(x), static_cast<float>(y)),
+                                          Vec2F(static_cast<float>(x % 3) - 1.f, static_cast<float>(y % 2)), 1);
+
+            auto colRef = world.CreateCollider(bodyRef);
+            auto& collider = world.GetCollider(colRef);
+            collider.SetIsTrigger(true);
+            collider.SetShape(CircleF(Vec2F::Zero(), 0.75f));
+        }
+    }
+}
+
+TEST(World, UpdateCollisionDetectionJobSystem)
+{
+    constexpr int sideCount = 40;
+
+    World serialWorld;
+    serialWorld.Init(Math::Vec2F::Zero(), sideCount * sideCount);
+    RecordingContactListener serialListener;
+    serialWorld.SetContactListener(&serialListener);
+    FillCircleGrid(serialWorld, sideCount);
+
+    JobSystem jobSystem;
+    jobSystem.Init(3);
+
+    World parallelWorld;
+    parallelWorld.Init(Math::Vec2F::Zero(), sideCount * sideCount);
+    RecordingContactListener parallelListener;
+    parallelWorld.SetContactListener(&parallelListener);
+    parallelWorld.SetJobSystem(&jobSystem);
+    FillCircleGrid(parallelWorld, sideCount);
+
+    EXPECT_EQ(parallelWorld.GetJobSystem(), &jobSystem);
+
+    for (int i = 0; i < 5; i++)
+    {
+        serialWorld.Update(0.1f);
+        parallelWorld.Update(0.1f);
+    }
+
+    EXPECT_GT(serialListener.Events.size(), 0);
+    ASSERT_EQ(serialListener.Events.size(), parallelListener.Events.size());
+
+    for (std::size_t i = 0; i < serialListener.Events.size(); i++)
+    {
+        EXPECT_EQ(serialListener.Events[i].first, parallelListener.Events[i].first);
+        EXPECT_EQ(serialListener.Events[i].second.ColliderA, parallelListener.Events[i].second.ColliderA);
+        EXPECT_EQ(serialListener.Events[i].second.ColliderB, parallelListener.Events[i].second.ColliderB);
+    }
+
+    parallelWorld.Deinit();
+    jobSystem.Deinit();
+}
+
+/**
+ * @brief FillMixedShapeGrid creates a grid of trigger circles, rectangles and polygons that overlap their neighbours.
+ */
+static void FillMixedShapeGrid(World& world, const int sideCount) noexcept
+{
+    for (int y = 0; y < sideCount; y++)
+    {
+        for (int x = 0; x < sideCount; x++)
+        {
+            auto bodyRef = world.CreateBody();
+            world.GetBody(bodyRef) = Body(Vec2F(static_cast<float>(x), static_cast<float>(y)),
+                                          Vec2F(static_cast<float>(x % 3) - 1.f, static_cast<float>(y % 2)), 1);
+
+            auto colRef = world.CreateCollider(bodyRef);
+            auto& collider = world.GetCollider(colRef);
+            collider.SetIsTrigger(true);
+
+            // Mostly circles, as in the trigger scenes.
+            switch ((x * 7 + y * 3) % 5)
+            {
+                case 0:
+                    collider.SetShape(RectangleF(Vec2F(-0.6f, -0.6f), Vec2F(0.6f, 0.6f)));
+                    break;
+                case 1:
+                    collider.SetShape(PolygonF({ Vec2F(-0.7f, -0.5f), Vec2F(0.7f, -0.5f), Vec2F(0.f, 0.8f) }));
+                    break;
+                default:
+                    collider.SetShape(CircleF(Vec2F::Zero(), 0.75f));
+                    break;
+            }
+        }
+    }
+}
+
+TEST(World, UpdateCollisionDetectionBatched)
+{
+    constexpr int sideCount = 30;
+
+    JobSystem jobSystem;
+    jobSystem.Init(3);
+
+    for (auto* usedJobSystem : { static_cast<JobSystem*>(nullptr), &jobSystem })
+    {
+        World perPairWorld;
+        perPairWorld.Init(Math::Vec2F::Zero(), sideCount * sideCount);
+        RecordingContactListener perPairListener;
+        perPairWorld.SetContactListener(&perPairListener);
+        FillMixedShapeGrid(perPairWorld, sideCount);
+
+        World batchedWorld;
+        batchedWorld.Init(Math::Vec2F::Zero(), sideCount * sideCount);
+        RecordingContactListener batchedListener;
+        batchedWorld.SetContactListener(&batchedListener);
+        batchedWorld.SetJobSystem(usedJobSystem);
+        batchedWorld.SetNarrowPhaseMode(NarrowPhaseMode::Batched);
+        FillMixedShapeGrid(batchedWorld, sideCount);
+
+        EXPECT_EQ(batchedWorld.GetNarrowPhaseMode(), NarrowPhaseMode::Batched);
+
+        for (int i = 0; i < 5; i++)
+        {
+            perPairWorld.Update(0.1f);
+            batchedWorld.Update(0.1f);
+        }
+
+        EXPECT_GT(perPairListener.Events.size(), 0);
+        ASSERT_EQ(perPairListener.Events.size(), batchedListener.Events.size());
+
+        for (std::size_t i = 0; i < perPairListener.Events.size(); i++)
+        {
+            EXPECT_EQ(perPairListener.Events[i].first, batchedListener.Events[i].first);
+            EXPECT_EQ(perPairListener.Events[i].second.ColliderA, batchedListener.Events[i].second.ColliderA);
+            EXPECT_EQ(perPairListener.Events[i].second.ColliderB, batchedListener.Events[i].second.ColliderB);
+        }
+
+        batchedWorld.Deinit();
+    }
+
+    jobSystem.Deinit();
+}
+
+TEST(World, ColliderProxies)
+{
+    World world;
+    world.Init(Math::Vec2F::Zero(), 2);
+
+    auto bodyRef = world.CreateBody();
+    world.GetBody(bodyRef) = Body(Vec2F(2.f, 3.f), Vec2F::Zero(), 1);
+
+    auto circleColRef = world.CreateCollider(bodyRef);
+    world.GetCollider(circleColRef).SetShape(CircleF(Vec2F::Zero(), 0.5f));
+
+    auto polygonColRef = world.CreateCollider(bodyRef);
+    world.GetCollider(polygonColRef).SetShape(PolygonF({ Vec2F(-1.f, 0.f), Vec2F(1.f, 0.f), Vec2F(0.f, 2.f) }));
+
+    // The proxies are calculated by the update.
+    EXPECT_THROW(static_cast<void>(world.GetColliderProxy(circleColRef)), std::runtime_error);
+
+    world.Update(0.1f);
+
+    const auto& circleProxy = world.GetColliderProxy(circleColRef);
+
+    EXPECT_EQ(circleProxy.BodyIndex, bodyRef.Index);
+    EXPECT_EQ(circleProxy.BodyPosition, Vec2F(2.f, 3.f));
+    EXPECT_EQ(circleProxy.Type, ShapeType::Circle);
+    EXPECT_EQ(circleProxy.Aabb.MinBound(), Vec2F(1.5f, 2.5f));
+    EXPECT_EQ(circleProxy.Aabb.MaxBound(), Vec2F(2.5f, 3.5f));
+
+    const auto& polygonProxy = world.GetColliderProxy(polygonColRef);
+
+    EXPECT_EQ(polygonProxy.Type, ShapeType::Polygon);
+    EXPECT_EQ(polygonProxy.Vertices.Count, 3);
+    EXPECT_EQ(polygonProxy.Aabb.MinBound(), Vec2F(1.f, 3.f));
+    EXPECT_EQ(polygonProxy.Aabb.MaxBound(), Vec2F(3.f, 5.f));
+
+    world.DestroyCollider(circleColRef);
+
+    EXPECT_THROW(static_cast<void>(world.GetColliderProxy(circleColRef)), std::runtime_error);
+}
+
+TEST(World, StackOfBoxesIsStable)
+{
+    World world;
+    world.Init(Vec2F(0.f, -10.f), 8);
+
+    TestContactListener testContactListener;
+    world.SetContactListener(&testContactListener);
+
+    const RectangleF box(Vec2F(-0.5f, -0.5f), Vec2F(0.5f, 0.5f));
+
+    auto groundRef = world.CreateBody();
+    world.GetBody(groundRef) = Body(Vec2F(0.f, -0.5f), Vec2F::Zero(), 1);
+    world.GetBody(groundRef).SetBodyType(BodyType::Static);
+    world.GetCollider(world.CreateCollider(groundRef)).SetShape(RectangleF(Vec2F(-5.f, -0.5f), Vec2F(5.f, 0.5f)));
+
+    constexpr int boxCount = 5;
+    std::array<BodyRef, boxCount> boxRefs{};
+
+    for (int i = 0; i < boxCount; i++)
+    {
+        boxRefs[i] = world.CreateBody();
+        world.GetBody(boxRefs[i]) = Body(Vec2F(0.f, 0.5f + static_cast<float>(i)), Vec2F::Zero(), 1);
+        world.GetCollider(world.CreateCollider(boxRefs[i])).SetShape(box);
+    }
+
+    world.SetVelocityIterationCount(8);
+    EXPECT_EQ(world.GetVelocityIterationCount(), 8);
+
+    // Two seconds at 30 steps per second.
+    for (int step = 0; step < 60; step++)
+    {
+        world.Update(1.f / 30.f);
+    }
+
+    // The boxes stay on top of each other, only sinking into each other by the slop of the solver.
+    for (int i = 0; i < boxCount; i++)
+    {
+        const auto& body = world.GetBody(boxRefs[i]);
+
+        EXPECT_NEAR(body.Position().X, 0.f, 0.0001f);
+        EXPECT_NEAR(body.Position().Y, 0.5f + static_cast<float>(i), 0.05f);
+        EXPECT_NEAR(body.Velocity().Y, 0.f, 0.01f);
+    }
+
+    world.Deinit();
+}
+
+class CollisionCountListener : public ContactListener
+{
+public:
+    int ExitCount = 0;
+
+    void OnTriggerEnter(ColliderRef colliderRefA, ColliderRef colliderRefB) noexcept override {}
+    void OnTriggerStay(ColliderRef colliderRefA, ColliderRef colliderRefB) noexcept override {}
+    void OnTriggerExit(ColliderRef colliderRefA, ColliderRef colliderRefB) noexcept override {}
+    void OnCollisionEnter(ColliderRef colliderRefA, ColliderRef colliderRefB) noexcept override {}
+    void OnCollisionExit(ColliderRef colliderRefA, ColliderRef colliderRefB) noexcept override { ExitCount++; }
+};
+
+TEST(World, RestingIslandFallsAsleepAndWakesUp)
+{
+    World world;
+    world.Init(Vec2F(0.f, -10.f), 8);
+    world.SetSleepingEnabled(true);
+
+    CollisionCountListener testContactListener;
+    world.SetContactListener(&testContactListener);
+
+    const RectangleF box(Vec2F(-0.5f, -0.5f), Vec2F(0.5f, 0.5f));
+
+    auto groundRef = world.CreateBody();
+    world.GetBody(groundRef) = Body(Vec2F(0.f, -0.5f), Vec2F::Zero(), 1);
+    world.GetBody(groundRef).SetBodyType(BodyType::Static);
+    world.GetCollider(world.CreateCollider(groundRef)).SetShape(RectangleF(Vec2F(-5.f, -0.5f), Vec2F(5.f, 0.5f)));
+
+    std::array<BodyRef, 2> boxRefs{};
+
+    for (int i = 0; i < 2; i++)
+    {
+        boxRefs[i] = world.CreateBody();
+        world.GetBody(boxRefs[i]) = Body(Vec2F(0.f, 0.5f + static_cast<float>(i)), Vec2F::Zero(), 1);
+        world.GetCollider(world.CreateCollider(boxRefs[i])).SetShape(box);
+    }
+
+    // Two seconds at 30 steps per second, much longer than the time to sleep.
+    for (int step = 0; step < 60; step++)
+    {
+        world.Update(1.f / 30.f);
+    }
+
+    // The two boxes are in the same island, the ground is in none.
+    ASSERT_EQ(world.GetIslandGraph().Islands().size(), 1);
+    EXPECT_EQ(world.GetIslandGraph().Islands()[0].BodyCount, 2);
+    EXPECT_EQ(world.GetIslandGraph().IslandOf(groundRef.Index), IslandGraph::NoIsland);
+
+    const auto topPosition = world.GetBody(boxRefs[1]).Position();
+
+    for (const auto& boxRef : boxRefs)
+    {
+        EXPECT_FALSE(world.GetBody(boxRef).IsAwake());
+    }
+
+    // A sleeping island is neither integrated nor solved, but its contacts are kept.
+    testContactListener.ExitCount = 0;
+    world.Update(1.f / 30.f);
+
+    EXPECT_EQ(world.GetBody(boxRefs[1]).Position(), topPosition);
+    EXPECT_EQ(testContactListener.ExitCount, 0);
+
+    // Pushing the bottom box wakes up the box resting on it, whether they still touch or not.
+    world.GetBody(boxRefs[0]).SetVelocity(Vec2F(1.f, 0.f));
+    world.Update(1.f / 30.f);
+
+    for (const auto& boxRef : boxRefs)
+    {
+        EXPECT_TRUE(world.GetBody(boxRef).IsAwake());
+    }
+
+    world.SetSleepingEnabled(false);
+    EXPECT_FALSE(world.IsSleepingEnabled());
+
+    for (int step = 0; step < 60; step++)
+    {
+        world.Update(1.f / 30.f);
+    }
+
+    for (const auto& boxRef : boxRefs)
+    {
+        EXPECT_TRUE(world.GetBody(boxRef).IsAwake());
+    }
+
+    world.Deinit();
+}
+
+TEST(World, SleepingCollidersAreLeftOutOfRebuiltBroadPhase)
+{
+    World world;
+    world.Init(Vec2F(0.f, -10.f), 8);
+    world.SetSleepingEnabled(true);
+
+    CollisionCountListener testContactListener;
+    world.SetContactListener(&testContactListener);
+
+    const RectangleF box(Vec2F(-0.5f, -0.5f), Vec2F(0.5f, 0.5f));
+
+    auto groundRef = world.CreateBody();
+    world.GetBody(groundRef) = Body(Vec2F(0.f, -0.5f), Vec2F::Zero(), 1);
+    world.GetBody(groundRef).SetBodyType(BodyType::Static);
+    world.GetCollider(world.CreateCollider(groundRef)).SetShape(RectangleF(Vec2F(-5.f, -0.5f), Vec2F(5.f, 0.5f)));
+
+    std::array<BodyRef, 2> boxRefs{};
+    std::array<ColliderRef, 2> boxColRefs{};
+
+    for (int i = 0; i < 2; i++)
+    {
+        boxRefs[i] = world.CreateBody();
+        world.GetBody(boxRefs[i]) = Body(Vec2F(0.f, 0.5f + static_cast<float>(i)), Vec2F::Zero(), 1);
+        boxColRefs[i] = world.CreateCollider(boxRefs[i]);
+        world.GetCollider(boxColRefs[i]).SetShape(box);
+    }
+
+    for (int step = 0; step < 60; step++)
+    {
+        world.Update(1.f / 30.f);
+    }
+
+    // The default quad-tree is rebuilt each step, no moving collider touches the sleeping boxes.
+    testContactListener.ExitCount = 0;
+    world.Update(1.f / 30.f);
+
+    for (int i = 0; i < 2; i++)
+    {
+        EXPECT_FALSE(world.GetBody(boxRefs[i]).IsAwake());
+        EXPECT_TRUE(world.GetColliderProxy(boxColRefs[i]).IsOutOfBroadPhase);
+    }
+
+    EXPECT_EQ(testContactListener.ExitCount, 0);
+    EXPECT_EQ(world.GetIslandGraph().Islands().size(), 1);
+
+    // A box falling on the stack gives the sleeping boxes back to the broad phase and wakes them up.
+    auto fallingRef = world.CreateBody();
+    world.GetBody(fallingRef) = Body(Vec2F(0.f, 4.f), Vec2F::Zero(), 1);
+    world.GetCollider(world.CreateCollider(fallingRef)).SetShape(box);
+
+    bool isStackWokenUp = false;
+
+    for (int step = 0; step < 60 && !isStackWokenUp; step++)
+    {
+        world.Update(1.f / 30.f);
+        isStackWokenUp = world.GetBody(boxRefs[1]).IsAwake();
+    }
+
+    EXPECT_TRUE(isStackWokenUp);
+    EXPECT_GT(world.GetBody(fallingRef).Position().Y, world.GetBody(boxRefs[1]).Position().Y);
+    EXPECT_EQ(testContactListener.ExitCount, 0);
+
+    // A persistent quad-tree keeps all the colliders.
+    world.SetBroadPhasePersistent(true);
+
+    for (int step = 0; step < 60; step++)
+    {
+        world.Update(1.f / 30.f);
+    }
+
+    EXPECT_FALSE(world.GetBody(boxRefs[0]).IsAwake());
+    EXPECT_FALSE(world.GetColliderProxy(boxColRefs[0]).IsOutOfBroadPhase);
+
+    world.Deinit();
+}
+
+/**
+ * @brief FillBoxStacks creates a static ground with stacks of boxes of different heights falling on it.
+ */
+static std::vector<BodyRef> FillBoxStacks(World& world, const int stackCount) noexcept
+{
+    std::vector<BodyRef> boxRefs;
+
+    auto groundRef = world.CreateBody();
+    world.GetBody(groundRef) = Body(Vec2F(0.f, -0.5f), Vec2F::Zero(), 1);
+    world.GetBody(groundRef).SetBodyType(BodyType::Static);
+    world.GetCollider(world.CreateCollider(groundRef)).SetShape(
+        RectangleF(Vec2F(-1.f, -0.5f), Vec2F(2.f * static_cast<float>(stackCount) + 1.f, 0.5f)));
+
+    for (int stack = 0; stack < stackCount; stack++)
+    {
+        for (int i = 0; i < stack % 6 + 1; i++)
+        {
+            auto bodyRef = world.CreateBody();
+            world.GetBody(bodyRef) = Body(Vec2F(2.f * static_cast<float>(stack), 0.6f + 1.05f * static_cast<float>(i)),
+                                          Vec2F::Zero(), static_cast<float>(i % 3 + 1));
+
+            auto colRef = world.CreateCollider(bodyRef);
+            world.GetCollider(colRef).SetShape(RectangleF(Vec2F(-0.5f, -0.5f), Vec2F(0.5f, 0.5f)));
+            world.GetCollider(colRef).SetRestitution(0.3f);
+
+            boxRefs.push_back(bodyRef);
+        }
+    }
+
+    return boxRefs;
+}
+
+TEST(World, SleepingIsOptIn)
+{
+    World world;
+    world.Init(Vec2F::Zero(), 1);
+
+    EXPECT_FALSE(world.IsSleepingEnabled());
+
+    auto bodyRef = world.CreateBody();
+    world.GetBody(bodyRef) = Body(Vec2F::Zero(), Vec2F::Zero(), 1);
+    world.GetCollider(world.CreateCollider(bodyRef)).SetShape(CircleF(Vec2F::Zero(), 0.5f));
+
+    // A body at rest stays awake by default.
+    for (int step = 0; step < 60; step++)
+    {
+        world.Update(1.f / 30.f);
+    }
+
+    EXPECT_TRUE(world.GetBody(bodyRef).IsAwake());
+
+    // Without a contact listener the contacts are not solved, so the body still doesn't fall asleep.
+    world.SetSleepingEnabled(true);
+
+    for (int step = 0; step < 60; step++)
+    {
+        world.Update(1.f / 30.f);
+    }
+
+    EXPECT_TRUE(world.GetBody(bodyRef).IsAwake());
+
+    world.Deinit();
+}
+
+TEST(World, ChangingShapeWakesUpBody)
+{
+    World world;
+    world.Init(Vec2F::Zero(), 1);
+    world.SetSleepingEnabled(true);
+
+    CollisionCountListener testContactListener;
+    world.SetContactListener(&testContactListener);
+
+    auto bodyRef = world.CreateBody();
+    world.GetBody(bodyRef) = Body(Vec2F::Zero(), Vec2F::Zero(), 1);
+    auto colRef = world.CreateCollider(bodyRef);
+    world.GetCollider(colRef).SetShape(CircleF(Vec2F::Zero(), 0.5f));
+
+    for (int step = 0; step < 60; step++)
+    {
+        world.Update(1.f / 30.f);
+    }
+
+    EXPECT_FALSE(world.GetBody(bodyRef).IsAwake());
+
+    world.GetCollider(colRef).SetShape(CircleF(Vec2F::Zero(), 2.f));
+    EXPECT_TRUE(world.GetCollider(colRef).IsShapeChanged());
+
+    world.Update(1.f / 30.f);
+
+    EXPECT_TRUE(world.GetBody(bodyRef).IsAwake());
+    EXPECT_FALSE(world.GetCollider(colRef).IsShapeChanged());
+
+    world.Deinit();
+}
+
+TEST(World, SolveIslandsJobSystem)
+{
+    constexpr int stackCount = 60;
+
+    World serialWorld;
+    serialWorld.Init(Vec2F(0.f, -10.f), stackCount * 6);
+    CollisionCountListener serialListener;
+    serialWorld.SetContactListener(&serialListener);
+    const auto serialBoxRefs = FillBoxStacks(serialWorld, stackCount);
+
+    JobSystem jobSystem;
+    jobSystem.Init(3);
+
+    World parallelWorld;
+    parallelWorld.Init(Vec2F(0.f, -10.f), stackCount * 6);
+    CollisionCountListener parallelListener;
+    parallelWorld.SetContactListener(&parallelListener);
+    parallelWorld.SetJobSystem(&jobSystem);
+    const auto parallelBoxRefs = FillBoxStacks(parallelWorld, stackCount);
+
+    for (int step = 0; step < 30; step++)
+    {
+        serialWorld.Update(1.f / 30.f);
+        parallelWorld.Update(1.f / 30.f);
+    }
+
+    EXPECT_EQ(parallelWorld.GetIslandGraph().Islands().size(), stackCount);
+
+    // The islands don't share any dynamic body, so the results don't depend on the thread that solved them.
+    for (std::size_t i = 0; i < serialBoxRefs.size(); i++)
+    {
+        const auto& serialBody = serialWorld.GetBody(serialBoxRefs[i]);
+        const auto& parallelBody = parallelWorld.GetBody(parallelBoxRefs[i]);
+
+        EXPECT_EQ(serialBody.Position(), parallelBody.Position());
+        EXPECT_EQ(serialBody.Velocity(), parallelBody.Velocity());
+    }
+
+    parallelWorld.Deinit();
+    jobSystem.Deinit();
+}
+
+TEST(World, GraphColoredStackOfBoxesIsStable)
+{
+    World world;
+    world.Init(Vec2F(0.f, -10.f), 8);
+
+    CollisionCountListener contactListener;
+    world.SetContactListener(&contactListener);
+    world.SetContactSolverMode(ContactSolverMode::GraphColored);
+    world.SetGraphColoringConstraintCount(1);
+
+    EXPECT_EQ(world.GetContactSolverMode(), ContactSolverMode::GraphColored);
+
+    const auto boxRefs = FillBoxStacks(world, 6);
+
+    for (int step = 0; step < 60; step++)
+    {
+        world.Update(1.f / 30.f);
+    }
+
+    // The boxes of each stack end on top of each other. As with the sequential solve, the tall stacks of boxes
+    // of different masses sink into each other by a few centimeters.
+    for (const auto& boxRef : boxRefs)
+    {
+        const auto& body = world.GetBody(boxRef);
+        const auto level = std::round(body.Position().Y - 0.5f);
+
+        EXPECT_NEAR(body.Position().X, std::round(body.Position().X), 0.0001f);
+        EXPECT_NEAR(body.Position().Y, 0.5f + level, 0.1f);
+        EXPECT_NEAR(body.Velocity().Y, 0.f, 0.01f);
+    }
+
+    world.Deinit();
+}
+
+/**
+ * @brief ShootBullet shoots a small circle at 200 m/s at a thin static wall and gives where it is after a second.
+ */
+static Vec2F ShootBullet(const bool isContinuous) noexcept
+{
+    World world;
+    world.Init(Vec2F::Zero(), 4);
+
+    CollisionCountListener testContactListener;
+    world.SetContactListener(&testContactListener);
+
+    auto wallRef = world.CreateBody();
+    world.GetBody(wallRef) = Body(Vec2F::Zero(), Vec2F::Zero(), 1);
+    world.GetBody(wallRef).SetBodyType(BodyType::Static);
+    world.GetCollider(world.CreateCollider(wallRef)).SetShape(RectangleF(Vec2F(0.f, -2.f), Vec2F(0.2f, 2.f)));
+
+    auto bulletRef = world.CreateBody();
+    world.GetBody(bulletRef) = Body(Vec2F(-1.f, 0.f), Vec2F(200.f, 0.f), 1);
+    world.GetBody(bulletRef).SetContinuous(isContinuous);
+    world.GetCollider(world.CreateCollider(bulletRef)).SetShape(CircleF(Vec2F::Zero(), 0.1f));
+
+    // The bullet moves more than 6 per step, 30 times the width of the wall.
+    for (int step = 0; step < 30; step++)
+    {
+        world.Update(1.f / 30.f);
+    }
+
+    const auto position = world.GetBody(bulletRef).Position();
+
+    world.Deinit();
+
+    return position;
+}
+
+TEST(World, ContinuousBodyDoesNotTunnel)
+{
+    EXPECT_GT(ShootBullet(false).X, 0.2f);
+
+    // The continuous bullet stops against the wall, sinking in it only by the slop of the solver.
+    const auto position = ShootBullet(true);
+
+    EXPECT_LT(position.X, 0.f);
+    EXPECT_GT(position.X, -0.2f);
+    EXPECT_NEAR(position.Y, 0.f, 0.0001f);
+}
+
+TEST(World, StepWithFixedDeltaTime)
+{
+    World world;
+    world.Init(Vec2F(0.f, -10.f), 2);
+
+    EXPECT_EQ(world.FixedDeltaTime(), World::DefaultFixedDeltaTime);
+    EXPECT_EQ(world.MaxSubStepCount(), World::DefaultMaxSubStepCount);
+
+    constexpr float fixedDeltaTime = 0.01f;
+    world.SetFixedDeltaTime(fixedDeltaTime);
+    world.SetFixedDeltaTime(0.f);
+    EXPECT_EQ(world.FixedDeltaTime(), fixedDeltaTime);
+
+    world.SetMaxSubStepCount(4);
+
+    auto bodyRef = world.CreateBody();
+    world.GetBody(bodyRef) = Body(Vec2F::Zero(), Vec2F(1.f, 0.f), 1);
+
+    // The same body simulated with the fixed steps directly.
+    World expectedWorld;
+    expectedWorld.Init(Vec2F(0.f, -10.f), 2);
+
+    auto expectedBodyRef = expectedWorld.CreateBody();
+    expectedWorld.GetBody(expectedBodyRef) = Body(Vec2F::Zero(), Vec2F(1.f, 0.f), 1);
+
+    // Nothing is simulated until a whole fixed step has elapsed.
+    EXPECT_EQ(world.Step(0.004f), 0);
+    EXPECT_EQ(world.InterpolatedPosition(bodyRef), Vec2F::Zero());
+
+    // 0.004 + 0.021 gives two fixed steps, with half of one left.
+    EXPECT_EQ(world.Step(0.021f), 2);
+    expectedWorld.Update(fixedDeltaTime);
+    const auto previousPosition = expectedWorld.GetBody(expectedBodyRef).Position();
+    expectedWorld.Update(fixedDeltaTime);
+
+    const auto position = world.GetBody(bodyRef).Position();
+    EXPECT_EQ(position, expectedWorld.GetBody(expectedBodyRef).Position());
+
+    EXPECT_NEAR(world.InterpolationFactor(), 0.5f, 0.001f);
+
+    const auto interpolatedPosition = world.InterpolatedPosition(bodyRef);
+    const auto expectedInterpolatedPosition = previousPosition + (position - previousPosition) * 0.5f;
+
+    EXPECT_NEAR(interpolatedPosition.X, expectedInterpolatedPosition.X, 0.0001f);
+    EXPECT_NEAR(interpolatedPosition.Y, expectedInterpolatedPosition.Y, 0.0001f);
+
+    // A hitch of a second is capped to the maximum number of fixed steps, the rest of it is dropped.
+    EXPECT_EQ(world.Step(1.f), 4);
+    EXPECT_LT(world.InterpolationFactor(), 1.f);
+    EXPECT_LE(world.Step(0.f), 1);
+
+    world.Deinit();
+    expectedWorld.Deinit();
+}
+
+TEST(World, StepAppliesForcesToEachFixedStep)
+{
+    World world;
+    world.Init(Vec2F::Zero(), 1);
+
+    auto bodyRef = world.CreateBody();
+    world.GetBody(bodyRef) = Body(Vec2F::Zero(), Vec2F::Zero(), 1);
+
+    world.SetFixedDeltaTime(0.01f);
+
+    // The force is applied once for the frame, during its 3 fixed steps.
+    world.GetBody(bodyRef).ApplyForce(Vec2F(10.f, 0.f));
+
+    EXPECT_EQ(world.Step(0.035f), 3);
+    EXPECT_NEAR(world.GetBody(bodyRef).Velocity().X, 0.3f, 0.0001f);
+    EXPECT_EQ(world.GetBody(bodyRef).Forces(), Vec2F::Zero());
+
+    world.Deinit();
+}
+
+TEST(World, StepWithContactListener)
+{
+    World world;
+    world.Init(Vec2F::Zero(), 1);
+
+    TestContactListener testContactListener;
+    world.SetContactListener(&testContactListener);
+
+    auto bodyRef = world.CreateBody();
+    world.GetBody(bodyRef) = Body(Vec2F::Zero(), Vec2F(1.f, 0.f), 1);
+
+    auto colRef = world.CreateCollider(bodyRef);
+    world.GetCollider(colRef).SetShape(CircleF(Vec2F::Zero(), 0.5f));
+
+    world.SetFixedDeltaTime(0.01f);
+
+    // The contact phases run in each fixed step, they must not drop the time left of the frame.
+    EXPECT_EQ(world.Step(0.035f), 3);
+    EXPECT_NEAR(world.InterpolationFactor(), 0.5f, 0.001f);
+
+    int subStepCount = 0;
+
+    for (int frame = 0; frame < 100; frame++)
+    {
+        subStepCount += world.Step(0.01f);
+    }
+
+    EXPECT_GE(subStepCount, 99);
+    EXPECT_LE(subStepCount, 101);
+    EXPECT_NEAR(world.GetBody(bodyRef).Position().X, static_cast<float>(subStepCount + 3) * 0.01f, 0.001f);
+
+    world.Deinit();
+}
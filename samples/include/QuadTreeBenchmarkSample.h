@@ -0,0 +1,77 @@
+#pragma once
+
+/**
+ * @headerfile QuadTreeBenchmarkSample.h
+ * This file defines the QuadTreeBenchmarkSample class that compares the number of pair tests of the tight and
+ * the loose quad-tree on a scene with colliders straddling the boundaries of the nodes.
+ *
+ * @author Olivier Pachoud
+ */
+
+#include "Sample.h"
+#include "ContactListener.h"
+
+class QuadTreeBenchmarkSample final : public Sample, public PhysicsEngine::ContactListener
+{
+public:
+	// Inherited via Sample
+	std::string Name() const noexcept override { return "Quad-tree benchmark"; }
+	std::string Description() const noexcept override;
+	std::string InputText() const noexcept override;
+
+	void onInit() noexcept override;
+	void onHandleInputs(SDL_Event event, bool isMouseOnAnImGuiWindow) noexcept override;
+	void onUpdate() noexcept override;
+	void onRender() noexcept override;
+	void onDeinit() noexcept override;
+
+	// Inherited via ContactListener
+	void OnTriggerEnter(PhysicsEngine::ColliderRef colliderRefA,
+						PhysicsEngine::ColliderRef colliderRefB) noexcept override;
+
+	void OnTriggerStay(PhysicsEngine::ColliderRef colliderRefA,
+					   PhysicsEngine::ColliderRef colliderRefB) noexcept override;
+
+	void OnTriggerExit(PhysicsEngine::ColliderRef colliderRefA,
+					   PhysicsEngine::ColliderRef colliderRefB) noexcept override;
+
+	void OnCollisionEnter(PhysicsEngine::ColliderRef colliderRefA,
+						  PhysicsEngine::ColliderRef colliderRefB) noexcept override;
+
+	void OnCollisionExit(PhysicsEngine::ColliderRef colliderRefA,
+						 PhysicsEngine::ColliderRef colliderRefB) noexcept override;
+
+private:
+	static constexpr int CircleCount = 1000;
+
+	/**
+	 * @brief PlatformColumnCount and PlatformRowCount are the number of static platforms on each axis, placed
+	 * on a regular grid so that they straddle the boundaries of the nodes of the first levels.
+	 */
+	static constexpr int PlatformColumnCount = 8;
+	static constexpr int PlatformRowCount = 6;
+
+	/**
+	 * @brief LooseLooseness is the looseness of the quad-tree in the loose mode.
+	 */
+	static constexpr float LooseLooseness = 2.f;
+
+	static constexpr SDL_Color CircleColor = { 0, 0, 255, 255 };
+	static constexpr SDL_Color PlatformColor = { 255, 0, 0, 255 };
+	static constexpr SDL_Color BoundaryColor = { 255, 255, 255, 255 };
+
+	std::vector<PhysicsEngine::ColliderRef> _circleRefs;
+	std::vector<PhysicsEngine::ColliderRef> _platformRefs;
+
+	/**
+	 * @brief PairTestCount is the number of tests between two simplified shapes of the last broad phase.
+	 */
+	std::size_t _pairTestCount = 0;
+	bool _isLoose = false;
+
+	void addCircle(Math::Vec2F position, Math::Vec2F velocity) noexcept;
+	void addPlatform(Math::Vec2F position, Math::Vec2F size) noexcept;
+
+	void drawQuadNode(const PhysicsEngine::QuadNode& node) const noexcept;
+	void maintainCirclesInWindow() noexcept;
+};
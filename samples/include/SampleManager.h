@@ -10,7 +10,7 @@
 class SampleManager
 {
 public:
-    static constexpr int SampleCount = 4;
+    static constexpr int SampleCount = 5;
 
     void Init() noexcept;
     void HandleCurrentSampleInputs(SDL_Event event, bool isMouseOnAnImGuiWindow) const noexcept;
@@ -93,14 +93,14 @@ void BouncingShapesSample::onRender() noexcept
     for (const auto& colRef : _colliders)
     {
         const auto& collider = _world.GetCollider(colRef);
-        const auto colShape = collider.Shape();
+        const auto& colShape = collider.Shape();
 
         switch (colShape.index())
         {
         case static_cast<int>(Math::ShapeType::Circle):
         {
             GraphicGeometry::Circle(
-                Metrics::MetersToPixels(_world.GetBody(collider.GetBodyRef()).Position()),
+                Metrics::MetersToPixels(_world.InterpolatedPosition(collider.GetBodyRef())),
                 Metrics::MetersToPixels(std::get<Math::CircleF>(colShape).Radius()),
                 GraphicGeometry::CircleSegmentCount,
                 CircleColor);
@@ -113,7 +113,7 @@ void BouncingShapesSample::onRender() noexcept
             const auto color = colRef.Index == 0 ? GroundColor : RectangleColor;
 
             GraphicGeometry::FilledRectangle(
-                Metrics::MetersToPixels(_world.GetBody(collider.GetBodyRef()).Position()),
+                Metrics::MetersToPixels(_world.InterpolatedPosition(collider.GetBodyRef())),
                 Metrics::MetersToPixels(std::get<Math::RectangleF>(colShape).Size()),
                 color);
 
@@ -101,9 +101,9 @@ void CollisionSample::onRender() noexcept
     for (const auto& colRef : _colliderRefs)
     {
         const auto& collider = _world.GetCollider(colRef);
-        const auto position = _world.GetBody(collider.GetBodyRef()).Position();
+        const auto position = _world.InterpolatedPosition(collider.GetBodyRef());
 
-        const auto colShape = collider.Shape();
+        const auto& colShape = collider.Shape();
 
         switch (colShape.index())
         {
@@ -173,7 +173,7 @@ void CollisionSample::maintainObjectsInWindow() noexcept
 
     for (auto& colRef : _colliderRefs)
     {
-        const auto colShape = _world.GetCollider(colRef).Shape();
+        const auto& colShape = _world.GetCollider(colRef).Shape();
 
         switch (static_cast<Math::ShapeType>(colShape.index()))
         {
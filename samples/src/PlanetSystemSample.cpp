@@ -105,7 +105,7 @@ void PlanetSystemSample::onRender() noexcept
 {
     for (const auto& bodyRef : _bodyRefs)
     {
-        const auto pos = _world.GetBody(bodyRef).Position();
+        const auto pos = _world.InterpolatedPosition(bodyRef);
         const auto screenPos = Metrics::MetersToPixels(pos);
 
         const auto& graphicCircle = _graphicCircles[bodyRef.Index];
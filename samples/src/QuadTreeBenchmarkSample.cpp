@@ -0,0 +1,213 @@
+#include "QuadTreeBenchmarkSample.h"
+#include "Metrics.h"
+#include "GraphicGeometry.h"
+#include "Random.h"
+
+std::string QuadTreeBenchmarkSample::Description() const noexcept
+{
+    std::string_view description = R"(This sample compares the tight and the loose quad-tree broad phases.
+Small trigger circles move between static platforms placed on a regular grid, which straddle the boundaries of the nodes (visible in white on the screen).
+In the tight quad-tree, the platforms stay in the parent nodes and are tested against every collider below them.
+In the loose quad-tree, the children are enlarged so that the platforms sink to the deepest node that contains them.)";
+    return static_cast<std::string>(description);
+}
+
+std::string QuadTreeBenchmarkSample::InputText() const noexcept
+{
+    return std::string(R"(Inputs :
+[Space] switches between the tight and the loose quad-tree.
+
+)") + (_isLoose ? "Loose" : "Tight") + " quad-tree : " + std::to_string(_pairTestCount) + " pair tests.";
+}
+
+void QuadTreeBenchmarkSample::onInit() noexcept
+{
+    _world.SetContactListener(this);
+    _world.SetQuadTreeLooseness(_isLoose ? LooseLooseness : 1.f);
+
+    const auto windowSizeInMeters = Metrics::PixelsToMeters(
+            Math::Vec2F(AppWindow::WindowWidth, AppWindow::WindowHeight));
+
+    _circleRefs.reserve(CircleCount);
+    _platformRefs.reserve(PlatformColumnCount * PlatformRowCount);
+
+    const Math::Vec2F cellSize(windowSizeInMeters.X / PlatformColumnCount,
+                               windowSizeInMeters.Y / PlatformRowCount);
+
+    for (int row = 0; row < PlatformRowCount; row++)
+    {
+        for (int column = 0; column < PlatformColumnCount; column++)
+        {
+            const Math::Vec2F position(static_cast<float>(column) * cellSize.X,
+                                       static_cast<float>(row) * cellSize.Y);
+
+            addPlatform(position, Math::Vec2F(1.f, 0.2f));
+        }
+    }
+
+    for (std::size_t i = 0; i < CircleCount; i++)
+    {
+        Math::Vec2F rndScreenPos(Math::Random::Range(0.f, windowSizeInMeters.X),
+                                 Math::Random::Range(windowSizeInMeters.Y, 0.f));
+
+        Math::Vec2F rndVelocity(Math::Random::Range(-2.f, 2.f),
+                                Math::Random::Range(-2.f, 2.f));
+
+        addCircle(rndScreenPos, rndVelocity);
+    }
+}
+
+void QuadTreeBenchmarkSample::onHandleInputs(const SDL_Event event, const bool isMouseOnAnImGuiWindow) noexcept
+{
+    switch (event.type)
+    {
+    case SDL_KEYDOWN:
+        if (event.key.keysym.sym == SDLK_SPACE)
+        {
+            // The quad-tree is cleared when its looseness changes and rebuilt at the next step.
+            _isLoose = !_isLoose;
+            _world.SetQuadTreeLooseness(_isLoose ? LooseLooseness : 1.f);
+        }
+
+        break;
+    }
+}
+
+void QuadTreeBenchmarkSample::onUpdate() noexcept
+{
+    _pairTestCount = _world.QuadTree().PairTestCount();
+
+    maintainCirclesInWindow();
+}
+
+void QuadTreeBenchmarkSample::onRender() noexcept
+{
+    for (const auto& colRef : _platformRefs)
+    {
+        const auto& collider = _world.GetCollider(colRef);
+
+        GraphicGeometry::FilledRectangle(
+                Metrics::MetersToPixels(_world.InterpolatedPosition(collider.GetBodyRef())),
+                Metrics::MetersToPixels(std::get<Math::RectangleF>(collider.Shape()).Size()),
+                PlatformColor);
+    }
+
+    for (const auto& colRef : _circleRefs)
+    {
+        const auto& collider = _world.GetCollider(colRef);
+
+        GraphicGeometry::Circle(
+                Metrics::MetersToPixels(_world.InterpolatedPosition(collider.GetBodyRef())),
+                Metrics::MetersToPixels(std::get<Math::CircleF>(collider.Shape()).Radius()),
+                GraphicGeometry::CircleSegmentCount,
+                CircleColor);
+    }
+
+    drawQuadNode(_world.QuadTree().RootNode());
+}
+
+void QuadTreeBenchmarkSample::onDeinit() noexcept
+{
+    _circleRefs.clear();
+    _platformRefs.clear();
+    _pairTestCount = 0;
+}
+
+void QuadTreeBenchmarkSample::OnTriggerEnter(PhysicsEngine::ColliderRef colliderRefA,
+                                             PhysicsEngine::ColliderRef colliderRefB) noexcept
+{
+}
+
+void QuadTreeBenchmarkSample::OnTriggerStay(PhysicsEngine::ColliderRef colliderRefA,
+                                            PhysicsEngine::ColliderRef colliderRefB) noexcept
+{
+}
+
+void QuadTreeBenchmarkSample::OnTriggerExit(PhysicsEngine::ColliderRef colliderRefA,
+                                            PhysicsEngine::ColliderRef colliderRefB) noexcept
+{
+}
+
+void QuadTreeBenchmarkSample::OnCollisionEnter(PhysicsEngine::ColliderRef colliderRefA,
+                                               PhysicsEngine::ColliderRef colliderRefB) noexcept
+{
+}
+
+void QuadTreeBenchmarkSample::OnCollisionExit(PhysicsEngine::ColliderRef colliderRefA,
+                                              PhysicsEngine::ColliderRef colliderRefB) noexcept
+{
+}
+
+void QuadTreeBenchmarkSample::addCircle(const Math::Vec2F position, const Math::Vec2F velocity) noexcept
+{
+    const auto bodyRef = _world.CreateBody();
+    auto& body = _world.GetBody(bodyRef);
+    body = PhysicsEngine::Body(position, velocity, 1.f);
+
+    const auto colRef = _world.CreateCollider(bodyRef);
+    auto& collider = _world.GetCollider(colRef);
+    collider.SetIsTrigger(true);
+    collider.SetShape(Math::CircleF(Math::Vec2F::Zero(), 0.05f));
+
+    _circleRefs.push_back(colRef);
+}
+
+void QuadTreeBenchmarkSample::addPlatform(const Math::Vec2F position, const Math::Vec2F size) noexcept
+{
+    const auto bodyRef = _world.CreateBody();
+    auto& body = _world.GetBody(bodyRef);
+    body.SetPosition(position);
+    body.SetBodyType(PhysicsEngine::BodyType::Static);
+
+    const auto colRef = _world.CreateCollider(bodyRef);
+    auto& collider = _world.GetCollider(colRef);
+    collider.SetIsTrigger(true);
+
+    const auto halfSize = size * 0.5f;
+    collider.SetShape(Math::RectangleF(Math::Vec2F::Zero() - halfSize, Math::Vec2F::Zero() + halfSize));
+
+    _platformRefs.push_back(colRef);
+}
+
+void QuadTreeBenchmarkSample::drawQuadNode(const PhysicsEngine::QuadNode& node) const noexcept
+{
+    if (node.Children[0] != nullptr)
+    {
+        for (const auto& child : node.Children)
+        {
+            drawQuadNode(*child);
+        }
+    }
+
+    else
+    {
+        const auto center = Metrics::MetersToPixels(node.Boundary.Center());
+        auto size = Metrics::MetersToPixels(node.Boundary.Size());
+        size.Y = -size.Y;
+        GraphicGeometry::EmptyRectangle(center, size, BoundaryColor);
+    }
+}
+
+void QuadTreeBenchmarkSample::maintainCirclesInWindow() noexcept
+{
+    const auto windowSizeInMeters = Metrics::PixelsToMeters(
+            Math::Vec2F(AppWindow::WindowWidth, AppWindow::WindowHeight));
+
+    for (const auto& colRef : _circleRefs)
+    {
+        auto& body = _world.GetBody(_world.GetCollider(colRef).GetBodyRef());
+        const auto pos = body.Position();
+        const auto velocity = body.Velocity();
+
+        // The circles bounce on the borders of the window, whose Y axis goes down in meters.
+        if ((pos.X >= windowSizeInMeters.X && velocity.X > 0.f) || (pos.X <= 0.f && velocity.X < 0.f))
+        {
+            body.SetVelocity(Math::Vec2F(-velocity.X, velocity.Y));
+        }
+
+        if ((pos.Y <= windowSizeInMeters.Y && velocity.Y < 0.f) || (pos.Y >= 0.f && velocity.Y > 0.f))
+        {
+            body.SetVelocity(Math::Vec2F(body.Velocity().X, -velocity.Y));
+        }
+    }
+}
@@ -20,7 +20,8 @@ void Sample::Update() noexcept
 
     onUpdate();
 
-    _world.Update(_timer.DeltaTime());
+    // The world is simulated with fixed steps, the render interpolates the positions between them.
+    _world.Step(_timer.DeltaTime());
 }
 
 void Sample::Render() noexcept
@@ -3,6 +3,7 @@
 #include "TriggerColliderSample.h"
 #include "CollisionSample.h"
 #include "BouncingShapesSample.h"
+#include "QuadTreeBenchmarkSample.h"
 
 #ifdef TRACY_ENABLE
 #include <Tracy.hpp>
@@ -14,6 +15,7 @@ void SampleManager::Init() noexcept
     _samples[1] = MakeUnique<Sample, TriggerColliderSample>(_heapAllocator);
     _samples[2] = MakeUnique<Sample, CollisionSample>(_heapAllocator);
     _samples[3] = MakeUnique<Sample, BouncingShapesSample>(_heapAllocator);
+    _samples[4] = MakeUnique<Sample, QuadTreeBenchmarkSample>(_heapAllocator);
 
     _samples[_currentSampleIdx]->Init();
 }
@@ -83,14 +83,14 @@ void TriggerColliderSample::onRender() noexcept
 {
     for (auto& object : _gameObjects)
     {
-        const auto colShape = _world.GetCollider(object.ColRef).Shape();
+        const auto& colShape = _world.GetCollider(object.ColRef).Shape();
 
         switch (static_cast<Math::ShapeType>(colShape.index()))
         {
             case Math::ShapeType::Circle:
             {
                 GraphicGeometry::Circle(
-                        Metrics::MetersToPixels(_world.GetBody(object.BodyRef).Position()),
+                        Metrics::MetersToPixels(_world.InterpolatedPosition(object.BodyRef)),
                         Metrics::MetersToPixels(std::get<Math::CircleF>(colShape).Radius()),
                         GraphicGeometry::CircleSegmentCount,
                         object.CollisionNbr > 0 ? _collisionColor : _noCollisionColor);
@@ -100,7 +100,7 @@ void TriggerColliderSample::onRender() noexcept
             case Math::ShapeType::Rectangle:
             {
                 GraphicGeometry::FilledRectangle(
-                        Metrics::MetersToPixels(_world.GetBody(object.BodyRef).Position()),
+                        Metrics::MetersToPixels(_world.InterpolatedPosition(object.BodyRef)),
                         Metrics::MetersToPixels(std::get<Math::RectangleF>(colShape).Size()),
                         object.CollisionNbr > 0 ? _collisionColor : _noCollisionColor);
                 break;
@@ -108,8 +108,8 @@ void TriggerColliderSample::onRender() noexcept
 
             case Math::ShapeType::Polygon:
             {
-                const auto poly = std::get<Math::PolygonF>(colShape);
-                const auto verticesInMeters = poly.Vertices();
+                const auto& poly = std::get<Math::PolygonF>(colShape);
+                const auto& verticesInMeters = poly.Vertices();
 
                 // Convert vertices position from meters to pixels.
                 std::vector<Math::Vec2F> _verticesInPixels;
@@ -121,7 +121,7 @@ void TriggerColliderSample::onRender() noexcept
                 }
 
                 GraphicGeometry::Polygon(
-                        Metrics::MetersToPixels(_world.GetBody(object.BodyRef).Position()),
+                        Metrics::MetersToPixels(_world.InterpolatedPosition(object.BodyRef)),
                         _verticesInPixels,
                         object.CollisionNbr > 0 ? _collisionColor : _noCollisionColor);
 
@@ -256,7 +256,7 @@ void TriggerColliderSample::maintainObjectsInWindow() noexcept
 
     for (auto &object: _gameObjects)
     {
-        const auto colShape = _world.GetCollider(object.ColRef).Shape();
+        const auto& colShape = _world.GetCollider(object.ColRef).Shape();
 
         switch (static_cast<Math::ShapeType>(colShape.index()))
         {